@@ -0,0 +1,25 @@
+# Writes a C++ source defining a file's bytes as a constant array.
+# Script mode: cmake -DINPUT=<file> -DOUTPUT=<cpp> -DSYMBOL=<name> -P EmbedResource.cmake
+# defines resources::<SYMBOL>_DATA and resources::<SYMBOL>_SIZE (Resources.hpp).
+
+file(READ ${INPUT} hex HEX)
+string(LENGTH "${hex}" hexLength)
+math(EXPR size "${hexLength} / 2")
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+set(row "")                                     # 16 bytes; CMake regexes have no {n}
+foreach(i RANGE 15)
+    string(APPEND row "0x..,")
+endforeach()
+string(REGEX REPLACE "(${row})" "\\1\n    " bytes "${bytes}")
+
+file(WRITE ${OUTPUT}
+"// Generated from ${INPUT} by cmake/EmbedResource.cmake; do not edit.
+#include \"Resources.hpp\"
+
+namespace resources {
+extern const unsigned char ${SYMBOL}_DATA[] = {
+    ${bytes}
+};
+extern const std::size_t ${SYMBOL}_SIZE = ${size};
+}  // namespace resources
+")
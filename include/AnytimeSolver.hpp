@@ -0,0 +1,72 @@
+#pragma once
+
+#include "BoardView.hpp"
+#include "GuessSearch.hpp"
+#include "MineProbability.hpp"
+#include "Solver.hpp"
+#include "Strategy.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Best move found by AnytimeSolver, and how far it got.
+struct AnytimeMove {
+    enum class Tier : std::uint8_t { None, TwoRule, Pattern, Probability, Lookahead, LocalEstimate };
+
+    SolverMove  move;
+    Tier        tier        = Tier::None;
+    bool        proven      = false;    // follows from the visible board; false = best guess
+    float       mineChance  = 0.f;      // estimated, of a guessed reveal
+};
+
+// Solver with a deadline. Tiers run cheapest first and the first one that
+// proves a move answers:
+//      1)  the two rules (findSolverMove)              always runs
+//      2)  pattern tables (PatternStrategy)            one pass over the board
+//      3)  exact probabilities (MineProbability)       stops at the deadline
+// With nothing proven the answer is a guess: the best tile GuessSearch
+// finds in the time left (Tier::Lookahead when it is not simply the
+// safest), else the tile least likely to be a mine, from tier 3 or, if that
+// did not finish, from a one-pass local estimate.
+// Past the deadline at most one more O(tiles) pass runs, so the worst case
+// per move is the budget plus a pass, not an unbounded search.
+//
+// Keeps caches between calls; use one instance per thread.
+class AnytimeSolver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AnytimeSolver() = default;
+    explicit AnytimeSolver(const GuessSearch::Config& guess) : guess_(guess) {}
+
+    // Answers Tier::None only when no tile is left to reveal or flag.
+    AnytimeMove solve(const BoardView& view, int mines, Clock::time_point deadline);
+
+private:
+    PatternStrategy             pattern_;
+    MineProbability             probability_;
+    GuessSearch                 guess_;
+    std::vector<StrategyMove>   moves_;
+    std::vector<float>          probabilities_;
+
+    AnytimeMove localEstimate(const BoardView& view, int mines) const;
+};
+
+// AnytimeSolver as a tournament strategy with a fixed budget per call.
+// Unlike the deduction-only strategies it guesses when stuck.
+class AnytimeStrategy : public Strategy {
+public:
+    explicit AnytimeStrategy(AnytimeSolver::Clock::duration budget = std::chrono::milliseconds(2),
+                             const GuessSearch::Config& guess = GuessSearch::Config())
+    : solver_(guess), budget_(budget) {}
+
+    const char* name() const override { return "anytime"; }
+    void newGame(int rows, int cols, int mines) override;
+    void nextMoves(const BoardView& view, std::vector<StrategyMove>& out) override;
+
+private:
+    AnytimeSolver                   solver_;
+    AnytimeSolver::Clock::duration  budget_;
+    int                             mines_  = 0;
+};
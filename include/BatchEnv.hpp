@@ -0,0 +1,113 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Vectorized Minesweeper environments for agent training.
+//
+// Owns numEnvs boards of identical size in one contiguous cell array and
+// steps them all with one call, optionally split across a persistent pool
+// of worker threads. Finished boards reset themselves immediately with the
+// next seed in their sequence: episode k of env e uses seed
+// (config.seed + e + k * numEnvs), and a given seed produces exactly the
+// game Board(rows, cols, tileSize, mines, seed) would.
+//
+// Actions are flat integers, kind * cellsPerEnv() + (y * cols + x), with
+// kind REVEAL, FLAG or CHORD. Observations are OBS_PLANES byte planes of
+// rows*cols per env, written back to back:
+//      plane 0     1 if revealed
+//      plane 1     1 if flagged
+//      plane 2     adjacent-mine count of revealed tiles, 0 elsewhere
+// Rewards are the fraction of the board's safe tiles opened by the step
+// (so a full clear sums to 1), or -1 for revealing a mine. dones[e] is 1 if
+// env e's episode ended on this step; its observation already shows the
+// fresh board that replaced it. No call allocates after construction.
+class BatchEnv {
+public:
+    struct Config {
+        int             rows        = 9;
+        int             cols        = 9;
+        int             mines       = 10;
+        int             numEnvs     = 1;
+        std::uint32_t   seed        = 0;
+        int             threads     = 1;        // including the calling thread
+    };
+
+    enum ActionKind : std::int32_t { REVEAL = 0, FLAG = 1, CHORD = 2 };
+    static constexpr int NUM_ACTION_KINDS = 3;
+    static constexpr int OBS_PLANES       = 3;
+
+    // Throws std::invalid_argument unless rows, cols and numEnvs are
+    // positive and 0 <= mines <= rows*cols - 9 (room for a safe first click).
+    explicit BatchEnv(const Config& config);
+    ~BatchEnv();
+
+    BatchEnv(const BatchEnv&)            = delete;
+    BatchEnv& operator=(const BatchEnv&) = delete;
+
+    // Starts a new episode in every env and writes the observations. Must be
+    // called once before the first step().
+    void reset(std::uint8_t* observations);
+
+    // Applies actions[e] to env e. observations needs observationSize()
+    // bytes; rewards and dones need numEnvs() entries each.
+    void step(const std::int32_t* actions, std::uint8_t* observations,
+              float* rewards, std::uint8_t* dones);
+
+    // Sizes
+    int         numEnvs()         const;
+    int         cellsPerEnv()     const;
+    int         actionCount()     const;
+    std::size_t observationSize() const;
+    std::int32_t encodeAction(ActionKind kind, int x, int y) const;
+
+    // Inspection
+    std::uint32_t       episodeSeed(int env) const;
+    const std::uint8_t* cells(int env)       const;   // packed bytes, see Cell.hpp
+
+private:
+    struct EnvState {
+        std::mt19937    rng;
+        std::uint32_t   seed        = 0;
+        std::uint32_t   episode     = 0;
+        int             safeHidden  = 0;
+        bool            firstClick  = true;
+    };
+    struct EnvGrid;
+
+    Config                          config_;
+    int                             cellsPerEnv_;
+    std::vector<std::uint8_t>       cells_;
+    std::vector<EnvState>           envs_;
+    std::vector<std::vector<int>>   scratch_;       // one per thread
+
+    // Worker pool. Thread t handles envs [t*N/T, (t+1)*N/T); the caller runs
+    // slice 0 itself. jobGeneration_ announces a job, pending_ counts the
+    // slices still running.
+    std::vector<std::thread>        workers_;
+    std::mutex                      poolMutex_;
+    std::condition_variable         jobReady_;
+    std::condition_variable         jobDone_;
+    std::uint64_t                   jobGeneration_  = 0;
+    int                             pending_        = 0;
+    bool                            stopping_       = false;
+
+    // Arguments of the job in flight
+    const std::int32_t*             jobActions_     = nullptr;
+    std::uint8_t*                   jobObs_         = nullptr;
+    float*                          jobRewards_     = nullptr;
+    std::uint8_t*                   jobDones_       = nullptr;
+
+    void runJob();
+    void runSlice(int slice);
+    void workerLoop(int slice);
+    void resetEnv(int env, std::vector<int>& scratch);
+    void stepEnv(int env, std::int32_t action, std::vector<int>& scratch,
+                 float& reward, std::uint8_t& done);
+    void writeObservation(int env, std::uint8_t* observations) const;
+};
@@ -1,22 +1,23 @@
 #pragma once
 
+#include "BoardView.hpp"
+#include "Cell.hpp"
+#include "Solver.hpp"
+
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <random>
 #include <algorithm>
 #include <numeric>
 #include <array>
+#include <chrono>
 #include <unordered_set>
 #include <optional>
 #include <cstdint>
+#include <istream>
+#include <ostream>
 
-struct Tile {
-    bool                revealed        = false;
-    bool                flagged         = false;
-    bool                mine            = false;
-    int                 adjacentMines   = 0;
-    sf::RectangleShape  shape;
-};
+class BoardFork;
 
 class Board {
 public:
@@ -26,12 +27,18 @@ public:
     void draw(sf::RenderWindow& window);
 
     // Game logic
+    // reveal, chord and flag (and the solver and undo/redo calls below)
+    // take an optional change list: every tile byte the call rewrites is
+    // appended to it in write order, so callers can follow the board in
+    // time proportional to the move. The list is never cleared here;
+    // reuse one buffer and clear it between moves. A first click can
+    // rewrite the same tile twice (relocation, then the reveal).
     void reset(int rows, int cols, int numMines,
                std::optional<std::uint32_t> seed = std::nullopt);
-    bool reveal(int x, int y);
-    void flag(int x, int y);
-    bool isCleared() const;
-    bool chord (int x, int y);
+    bool reveal(int x, int y, std::vector<CellChange>* changes = nullptr);
+    void flag(int x, int y, std::vector<CellChange>* changes = nullptr);
+    bool isCleared() const;     // O(1): counts are kept as tiles change
+    bool chord (int x, int y, std::vector<CellChange>* changes = nullptr);
     bool isRevealed(int x, int y) const;
     int  getAdjacentMines(int x, int y) const;
     int  flagCount() const;
@@ -46,10 +53,54 @@ public:
     bool hasMineAt   (int x, int y) const;
     bool isFlaggedAt (int x, int y) const;
 
+    // Snapshots
+    // Saves the full board state (layout, revealed/flagged bits, first-click
+    // status and RNG state) in a compact binary format; load() restores it,
+    // resizing the board if needed. load() throws std::runtime_error on
+    // malformed input and leaves the board unchanged in that case.
+    void save(std::ostream& out) const;
+    void load(std::istream& in);
+
+    // Forks
+    // Returns a copy-on-write, SFML-free copy of the cell state for search
+    // code (see BoardFork.hpp). Packing costs one pass over the board;
+    // forking the returned fork again is O(1).
+    BoardFork fork() const;
+
+    // Player-visible view for strategies (see Strategy.hpp). Valid until
+    // the next reset or load.
+    BoardView view() const;
+
+    // Undo / redo
+    // reveal, chord, flag and each AISolver step are journaled as the list
+    // of tile bytes they changed, so undo()/redo() cost time proportional to
+    // the move, not the board. reset, placeMinesAt and load clear the
+    // history. The RNG is not rewound: undoing the first click and clicking
+    // elsewhere relocates mines differently than a fresh board would.
+    bool undo(std::vector<CellChange>* changes = nullptr);
+    bool redo(std::vector<CellChange>* changes = nullptr);
+    bool canUndo() const;
+    bool canRedo() const;
+    void setJournaling(bool enabled);   // on by default; off skips recording
+    void clearHistory();
+
     // Utilities
     int  index(int x, int y) const;
     bool inBounds(int x, int y) const;
-    bool AISolver();
+    int  rows() const;
+    int  cols() const;
+    std::uint8_t cellAt(int x, int y) const;
+    // One step of the two rules: applies the move findSolverMove(*this)
+    // finds. The scan resumes where the last call stopped and rechecks only
+    // tiles next to cells written since, so solving a whole board costs
+    // O(tiles + writes) instead of O(tiles) per step.
+    bool AISolver(std::vector<CellChange>* changes = nullptr);
+    // Repeats AISolver() until it stalls, the board is cleared or deadline
+    // passes, taking at least one step. Returns the steps made; each one is
+    // journaled (and replays) like a separate AISolver() call.
+    int  runAISolver(std::chrono::steady_clock::time_point deadline,
+                     std::vector<CellChange>* changes = nullptr);
+    bool applySolverMove(const SolverMove& move, std::vector<CellChange>* changes = nullptr);
     int  getHighlightX() const;
     int  getHighlightY() const;
 
@@ -57,28 +108,54 @@ private:
     // Configuration
     int                 rows_, cols_;
     float               tileSize_;
-    std::vector<Tile>   tiles;
-    sf::Font            font_;
+    std::vector<std::uint8_t> cells_;
     bool                firstClick_ = true;
     std::mt19937        rng_;
 
+    // Kept in step with cells_ by every write, for isCleared/flagCount
+    int                 hiddenSafe_ = 0;    // tiles neither revealed nor mined
+    int                 flags_      = 0;
+
     // Highlight state
     int highlightX_ = -1;
     int highlightY_ = -1;
 
+    // Resumable two-rule scan behind AISolver(). Tiles below solverCursor_
+    // did not fire when last checked; those that may since are queued in
+    // solverDirty_, a min-heap. Writes made while the scan is live wait in
+    // solverTouched_ until the next step turns them into dirty tiles.
+    bool                        solverLive_     = false;
+    int                         solverCursor_   = 0;
+    std::vector<int>            solverDirty_;
+    std::vector<std::uint8_t>   solverQueued_;      // per tile: in solverDirty_
+    std::vector<int>            solverTouched_;
+
+    // Undo/redo journal. Move m owns deltas_[moves_[m].begin, moves_[m+1].begin);
+    // the first appliedMoves_ moves are applied, the rest can be redone.
+    struct JournalMove {
+        std::size_t     begin;
+        bool            firstClickBefore;
+        bool            firstClickAfter;
+    };
+    std::vector<CellChange>     deltas_;
+    std::vector<JournalMove>    moves_;
+    std::size_t                 appliedMoves_       = 0;
+    bool                        journaling_         = true;
+    bool                        moveOpen_           = false;
+    bool                        moveHasDeltas_      = false;
+    bool                        firstClickBefore_   = false;
+    std::vector<CellChange>*    changes_            = nullptr;  // of the open move
+
+    // Scratch space for flood fills and mine placement
+    std::vector<int>    scratch_;
+
     // Internal helpers
+    struct CellAccess;
     void computeAdjacentMines();
-
-    // Invokes fn(nx, ny, Tile&) for each in-bounds 8-neighbor of (x, y).
-    template<typename F>
-    void forEachNeighbor(int x, int y, F&& fn) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-                if (dx == 0 && dy == 0) continue;
-                int nx = x + dx;
-                int ny = y + dy;
-                if (inBounds(nx, ny)) fn(nx, ny, tiles[index(nx, ny)]);
-            }
-        }
-    }
+    void setCell(int i, std::uint8_t value);
+    void writeCell(int i, std::uint8_t value);
+    void recount();
+    SolverMove nextSolverMove();
+    void beginMove(std::vector<CellChange>* changes);
+    void endMove();
 };
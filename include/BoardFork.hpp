@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Cell.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Lightweight copy-on-write copy of a board's cell state for search code.
+//
+// Cells are stored in fixed-size pages behind a shared page table. fork()
+// copies one pointer, so it costs the same on any board size; the first
+// write to a shared table or page copies just that table or page. A fork
+// owns no SFML resources and never touches the RNG, so mine relocation does
+// not happen here: a fork taken before the first click sees the mines
+// exactly as placed.
+//
+// Distinct forks may be used from different threads concurrently, including
+// forks that still share pages. A single fork is not itself thread-safe.
+class BoardFork {
+public:
+    static constexpr int PAGE_SHIFT = 10;
+    static constexpr int PAGE_CELLS = 1 << PAGE_SHIFT;
+
+    // Packs rows*cols cells (in Board's layout) into pages.
+    BoardFork(int rows, int cols, const std::uint8_t* cells);
+    BoardFork();                                // empty 0x0 board
+
+    BoardFork fork() const;
+
+    // Game logic, mirroring Board without first-click relocation
+    bool reveal(int x, int y);
+    void flag  (int x, int y);
+    bool chord (int x, int y);
+    bool isCleared() const;
+
+    // Queries
+    int          rows() const;
+    int          cols() const;
+    bool         inBounds(int x, int y) const;
+    int          index(int x, int y) const;
+    std::uint8_t cellAt(int x, int y) const;
+    bool         isRevealed      (int x, int y) const;
+    bool         isFlaggedAt     (int x, int y) const;
+    bool         hasMineAt       (int x, int y) const;
+    int          getAdjacentMines(int x, int y) const;
+
+    // Storage diagnostics
+    int pageCount() const;
+    int sharedPageCount(const BoardFork& other) const;
+
+private:
+    using Page      = std::array<std::uint8_t, PAGE_CELLS>;
+    using PageTable = std::vector<std::shared_ptr<Page>>;
+
+    int                         rows_;
+    int                         cols_;
+    int                         safeHidden_;    // non-mine tiles not yet revealed
+    std::shared_ptr<PageTable>  pages_;
+    std::vector<int>            stack_;         // flood-fill scratch
+
+    struct CellAccess;
+
+    std::uint8_t get(int i) const {
+        return (*(*pages_)[i >> PAGE_SHIFT])[i & (PAGE_CELLS - 1)];
+    }
+    void set(int i, std::uint8_t value);
+};
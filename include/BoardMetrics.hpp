@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Difficulty metrics of one dealt layout, all computed in O(tiles).
+struct BoardMetrics {
+    int bbbv            = 0;    // 3BV: fewest clicks that clear the board knowing the layout
+    int openings        = 0;    // connected regions of 0 tiles (8-neighbor)
+    int largestOpening  = 0;    // tiles one click in the biggest opening reveals
+    int isolated        = 0;    // numbered tiles next to no 0 tile; each costs a 3BV click
+    int guesses         = 0;    // times the two rules stall before the board is clear
+};
+
+// Deals and measures layouts on reusable buffers, so scanning many seeds
+// allocates nothing per seed. One instance per thread.
+class LayoutMeter {
+public:
+    // The layout Board deals for seed once the first click lands on
+    // (startX, startY), first-click relocation included: rows*cols packed
+    // bytes (Cell.hpp) with mine bits and adjacency, nothing revealed.
+    // Valid until the next deal().
+    const std::vector<std::uint8_t>& deal(int rows, int cols, int mines, std::uint32_t seed,
+                                          int startX, int startY);
+
+    // Metrics of a layout (only mine bits and adjacency are read) opened
+    // at (startX, startY): measureOpenings() then countGuesses().
+    BoardMetrics measure(const std::vector<std::uint8_t>& cells, int rows, int cols,
+                         int startX, int startY);
+
+    // Everything but guesses, from one flood per opening
+    BoardMetrics measureOpenings(const std::vector<std::uint8_t>& cells, int rows, int cols);
+
+    // Plays the two rules (Solver.hpp) from the first click, driven by a
+    // worklist of numbers whose neighborhood changed rather than by board
+    // scans. Whenever they stall, a safe tile is revealed (a frontier tile
+    // if there is one) and counted: it is how often a player with the two
+    // rules alone must guess, guessing right every time. The costlier half
+    // of measure(), so searches filter on the other metrics first.
+    int countGuesses(const std::vector<std::uint8_t>& cells, int rows, int cols,
+                     int startX, int startY);
+
+private:
+    std::vector<std::uint8_t>   cells_;
+    std::vector<std::uint8_t>   state_;     // per tile: hidden, revealed or flagged
+    std::vector<int>            stamp_;     // per tile: last opening that counted it
+    std::vector<int>            stack_;
+    std::vector<int>            work_;      // numbers to re-check
+    std::vector<int>            frontier_;  // hidden tiles seen next to a number
+    std::vector<int>            scratch_;   // mine placement
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Cell.hpp"
+
+#include <cstdint>
+
+// Read-only view of what a player can see: revealed and flagged bits, plus
+// adjacent-mine counts of revealed tiles. Mine bits and the counts of
+// hidden tiles are masked out, so strategies cannot peek. Wraps rows*cols
+// packed cell bytes (Cell.hpp) without copying them.
+class BoardView {
+public:
+    BoardView(int rows, int cols, const std::uint8_t* cells)
+    : rows_(rows)
+    , cols_(cols)
+    , cells_(cells) {}
+
+    int  rows() const                   { return rows_; }
+    int  cols() const                   { return cols_; }
+    bool inBounds(int x, int y) const   { return x >= 0 && x < cols_ && y >= 0 && y < rows_; }
+
+    // Visible cell byte, 0 out of bounds
+    std::uint8_t cellAt(int x, int y) const {
+        if (!inBounds(x, y)) return 0;
+        const std::uint8_t c = cells_[y * cols_ + x];
+        return (c & cell::REVEALED)
+            ? static_cast<std::uint8_t>(c & ~cell::MINE)
+            : static_cast<std::uint8_t>(c & cell::FLAGGED);
+    }
+
+    bool isRevealed(int x, int y) const     { return cellAt(x, y) & cell::REVEALED; }
+    bool isFlagged (int x, int y) const     { return cellAt(x, y) & cell::FLAGGED; }
+    int  adjacentMines(int x, int y) const  { return cell::adjacent(cellAt(x, y)); }
+
+private:
+    int                 rows_;
+    int                 cols_;
+    const std::uint8_t* cells_;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Packed per-tile state, one byte per tile. The low three bits are the
+// tile's own state; the high nibble caches its adjacent-mine count.
+namespace cell {
+constexpr std::uint8_t  MINE        = 1 << 0;
+constexpr std::uint8_t  REVEALED    = 1 << 1;
+constexpr std::uint8_t  FLAGGED     = 1 << 2;
+constexpr std::uint8_t  STATE_MASK  = MINE | REVEALED | FLAGGED;
+constexpr int           ADJ_SHIFT   = 4;
+
+inline int adjacent(std::uint8_t c) { return c >> ADJ_SHIFT; }
+}  // namespace cell
+
+// One tile byte rewritten by a move: the tile's index (y * cols + x) and
+// its packed byte before and after.
+struct CellChange {
+    int             index;
+    std::uint8_t    before;
+    std::uint8_t    after;
+};
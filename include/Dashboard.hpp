@@ -0,0 +1,60 @@
+#pragma once
+
+#include "FrameProfiler.hpp"
+#include "GameFeed.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Watches many headless games (GameFeed.hpp) in one window, tiled in a
+// grid. Each board is one quad per tile in its own vertex array, so a
+// board is a single draw call; the render thread drains the feed once per
+// frame and recolors only the tiles named in the updates. Tiles are
+// colored rather than lettered (numbers use the board's number colors),
+// since a grid of expert boards leaves a few pixels per tile.
+class Dashboard {
+public:
+    static constexpr int FRAME_RATE = 60;
+
+    explicit Dashboard(const GameFeed::Config& config);
+    void run();
+
+    // Same per-phase frame times as Game; F3 shows them.
+    const FrameProfiler& profiler() const;
+
+private:
+    static constexpr float  GAP         = 6.f;      // between boards
+    static constexpr float  STATUS_H    = 24.f;     // status line above the grid
+
+    GameFeed                            feed_;
+    int                                 rows_;
+    int                                 cols_;
+    float                               tileSize_   = 1.f;
+    int                                 gridCols_   = 1;
+
+    sf::RenderWindow                    window_;
+    std::vector<sf::VertexArray>        boards_;
+    std::vector<sf::RectangleShape>     frames_;        // outlined by the last outcome
+    std::vector<GameFeed::Update>       updates_;       // reused every frame
+
+    // Totals for the status line
+    std::uint64_t   won_        = 0;
+    std::uint64_t   lost_       = 0;
+    std::uint64_t   stuck_      = 0;
+    std::uint64_t   tileWrites_ = 0;
+
+    const sf::Font&     font_;
+    sf::Text            statusText_;
+    sf::Clock           statusClock_;       // status and profiler text refresh
+    std::uint64_t       statusWrites_   = 0;
+
+    FrameProfiler       profiler_;
+    bool                profilerVisible_ = false;
+    sf::RectangleShape  profilerBackground_;
+    sf::Text            profilerText_;
+
+    void processEvents();
+    void update();
+    void render();
+    void setTile(int board, int index, std::uint8_t cell);
+};
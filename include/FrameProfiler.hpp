@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Splits each frame of Game::run into phases and tracks click-to-display
+// latency, keeping the last WINDOW samples of each series for rolling
+// percentiles.
+//
+// Usage per frame: beginFrame(), endPhase() after each phase in order,
+// inputReceived() when a click is polled, endFrame() right after display().
+// Every click seen since the previous endFrame() gets one latency sample
+// ending at that frame's display. SFML events carry no timestamps, so a
+// click's latency starts when pollEvent hands it over.
+class FrameProfiler {
+public:
+    enum class Series : int { Events, Update, BoardDraw, UiDraw, Display, Frame, InputLatency, Count };
+    static constexpr int NUM_SERIES   = static_cast<int>(Series::Count);
+    static constexpr int WINDOW       = 512;
+    static constexpr int MAX_PENDING  = 16;     // clicks awaiting a display
+
+    struct Summary {
+        int     samples = 0;
+        float   p50Ms   = 0.f;
+        float   p99Ms   = 0.f;
+        float   maxMs   = 0.f;
+    };
+
+    static const char* name(Series s);
+
+    // Timing hooks
+    void beginFrame();
+    void endPhase(Series phase);
+    void inputReceived();
+    void endFrame();
+
+    // Raw sample input, also used by the hooks
+    void addSample(Series s, float ms);
+
+    // Rolling statistics over the last WINDOW samples
+    Summary summary(Series s) const;
+
+    // "series,samples,p50_ms,p99_ms,max_ms" rows for every series
+    void writeReport(std::ostream& os) const;
+
+    // Multi-line text for the on-screen overlay
+    std::string overlayText() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Ring {
+        std::array<float, WINDOW>   samples{};
+        int                         next  = 0;
+        int                         count = 0;
+    };
+
+    std::array<Ring, NUM_SERIES>                ring_;
+    Clock::time_point                           frameStart_;
+    Clock::time_point                           phaseStart_;
+    std::array<Clock::time_point, MAX_PENDING>  pending_;
+    int                                         numPending_ = 0;
+    mutable std::array<float, WINDOW>           sortScratch_;
+
+    static float msBetween(Clock::time_point a, Clock::time_point b);
+};
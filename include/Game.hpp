@@ -1,4 +1,10 @@
 #include "Board.hpp"
+#include "FrameProfiler.hpp"
+#include "HeatmapWorker.hpp"
+#include "MoveLog.hpp"
+#include "SolverWorker.hpp"
+
+#include <optional>
 
 class Game {
 public:
@@ -7,9 +13,16 @@ public:
     static constexpr int    FRAME_RATE = 60;
 
     // Construction & main loop
-    Game(int rows, int cols, int numMines);
+    // If moveLog is non-null, every game played in this window is appended
+    // to it so it can be replayed headlessly later. turboSlice is how much
+    // of each frame the turbo AI speed may spend on solver steps.
+    Game(int rows, int cols, int numMines, MoveLogWriter* moveLog = nullptr,
+         sf::Time turboSlice = sf::milliseconds(8));
     void run();
 
+    // Per-phase frame times and click-to-display latency; F3 shows them.
+    const FrameProfiler& profiler() const;
+
 private:
     // Configuration (set at construction; see main.cpp for difficulty presets)
     int                     rows_;
@@ -23,13 +36,23 @@ private:
     Board               board;
     sf::View            gameView_;
     sf::Clock           AISolveClock_;
+    MoveLogWriter*      moveLog_;
+    SolverWorker        solver_;
 
     // Logical state
-    GameState   state_              = GameState::PLAYING;
-    bool        AISolveEnabled_     = false;
+    GameState       state_              = GameState::PLAYING;
+    bool            AISolveEnabled_     = false;
+    std::uint32_t   seed_               = 0;        // seed of the game in progress
+
+    // Background solver bookkeeping. boardGeneration_ bumps on every board
+    // change; worker answers tagged with an older generation are dropped.
+    std::uint64_t                           boardGeneration_        = 1;
+    std::uint64_t                           requestedGeneration_    = 0;
+    std::optional<SolverWorker::Result>     solverResult_;
+    bool                                    stepRequested_          = false;   // Space pressed
 
     // UI elements
-    sf::Font            font_;
+    const sf::Font&     font_;              // process-wide (Resources.hpp)
     sf::RectangleShape  restartButton_;
     sf::CircleShape     smileFace_;
     sf::CircleShape     eyeLeft_, eyeRight_;
@@ -39,8 +62,50 @@ private:
     sf::RectangleShape  AIButton_;
     sf::Text            AIButtonText_;
 
+    // AI speed. AI_SPEEDS divide the step delay; 0 is turbo, which runs
+    // the two rules inline for up to turboSlice_ per frame and shows a
+    // progress line instead of each step's highlight.
+    static constexpr int    AI_SPEEDS[]     = {1, 4, 16, 0};
+    int                     speedIndex_     = 0;
+    sf::Time                turboSlice_;
+    sf::RectangleShape      speedButton_;
+    sf::Text                speedButtonText_;
+    int                     turboMoves_     = 0;    // since the AI was last switched on
+    sf::Clock               turboClock_;
+    sf::Clock               turboRefreshClock_;
+    sf::RectangleShape      turboBackground_;
+    sf::Text                turboText_;
+
+    // Mine-probability heatmap. Maps are computed by heatmap_ off the render
+    // thread; applying one recolors only the tiles whose shade changed in
+    // heatmapTiles_, which is drawn with a single call.
+    HeatmapWorker               heatmap_;
+    bool                        heatmapEnabled_         = false;
+    std::uint64_t               heatmapRequested_       = 0;    // generation last submitted
+    std::uint64_t               heatmapShown_           = 0;    // generation on screen
+    std::vector<std::uint8_t>   heatmapShades_;                 // per tile, 0 = no overlay
+    sf::VertexArray             heatmapTiles_;
+    sf::RectangleShape          heatmapButton_;
+    sf::Text                    heatmapButtonText_;
+
+    // Profiler overlay, refreshed a few times a second rather than per frame
+    FrameProfiler       profiler_;
+    bool                profilerVisible_    = false;
+    sf::Clock           profilerRefreshClock_;
+    sf::RectangleShape  profilerBackground_;
+    sf::Text            profilerText_;
+
     // Helpers
+    void newGame();
+    void boardChanged();
+    void setAISolveEnabled(bool enabled);
+    void setSpeed(int index);
+    bool turbo() const;
     void processEvents();
     void update();
+    void updateHeatmap();
+    void clearHeatmap();
     void render();
+    void drawProfiler();
+    void drawTurboProgress();
 };
\ No newline at end of file
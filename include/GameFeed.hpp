@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Board.hpp"
+#include "SpscQueue.hpp"
+#include "Strategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Plays many headless games on worker threads and streams every tile byte
+// they change to one consumer, so a viewer can mirror all the boards
+// without ever touching (or locking) them.
+//
+// Board b is owned by worker b % threads and plays games with its own
+// instance of a registered strategy (Strategy.hpp): game k uses seed
+// (seed + b + k * boards), opens with a reveal at the board center, and
+// ends won, lost or stuck. A finished board stays up for holdTime, then
+// the next game starts.
+//
+// Each worker publishes through its own SPSC queue, filled from the
+// boards' change lists (Board.hpp). Applying the updates in drain() order
+// to an all-zero copy of each board reproduces it exactly. A worker whose
+// queue is full stops playing until the consumer catches up, so nothing
+// is dropped.
+class GameFeed {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        int                         rows        = 16;
+        int                         cols        = 30;
+        int                         mines       = 99;
+        int                         boards      = 64;
+        int                         threads     = 1;
+        std::uint32_t               seed        = 0;
+        std::string                 strategy    = "anytime";    // strategyRegistry() name
+        Clock::duration             moveDelay   = std::chrono::milliseconds(20);    // per board
+        Clock::duration             holdTime    = std::chrono::seconds(1);
+    };
+
+    struct Update {
+        enum class Kind : std::uint8_t {
+            Tile,       // tile index of board is now cell
+            NewGame,    // board is all zeros again; index holds the game's seed
+            Won,
+            Lost,
+            Stuck,      // the strategy found no move
+        };
+
+        Kind            kind    = Kind::Tile;
+        std::uint8_t    cell    = 0;
+        std::uint16_t   board   = 0;
+        std::uint32_t   index   = 0;
+    };
+
+    // Throws std::runtime_error for an unknown strategy or a bad size
+    explicit GameFeed(const Config& config);
+    ~GameFeed();
+
+    GameFeed(const GameFeed&)            = delete;
+    GameFeed& operator=(const GameFeed&) = delete;
+
+    // Appends up to max pending updates to out and returns how many. Call
+    // from a single consumer thread.
+    std::size_t drain(std::vector<Update>& out, std::size_t max = SIZE_MAX);
+
+    const Config& config() const;
+
+private:
+    struct Seat {
+        Board                       board;
+        std::unique_ptr<Strategy>   strategy;
+        std::vector<StrategyMove>   queued;         // moves left from the last call
+        std::size_t                 next        = 0;
+        std::uint32_t               game        = 0;
+        int                         moves       = 0;
+        bool                        over        = false;
+        Clock::time_point           due;            // of the next move or game
+
+        Seat(const Config& config, std::unique_ptr<Strategy> s);
+    };
+
+    struct Worker {
+        SpscQueue<Update>           queue;
+        std::vector<Update>         backlog;        // made but not yet queued
+        std::size_t                 sent        = 0;
+        std::vector<int>            seats;
+        std::vector<CellChange>     changes;
+        std::thread                 thread;
+
+        explicit Worker(std::size_t capacity) : queue(capacity) {}
+    };
+
+    Config                                  config_;
+    std::vector<std::unique_ptr<Seat>>      seats_;
+    std::vector<std::unique_ptr<Worker>>    workers_;
+    std::atomic<bool>                       stop_{false};
+    std::mutex                              wakeMutex_;
+    std::condition_variable                 wake_;
+
+    void run(Worker& worker);
+    void startGame(int b, Worker& worker);
+    void playMove(int b, Worker& worker);
+    bool flush(Worker& worker);
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "SessionPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Headless multi-session game server on a Unix domain socket.
+//
+// One event-loop thread (the one calling run()) owns every connection and
+// every session, multiplexing clients with poll(). Each read is parsed for
+// as many complete frames as it holds and all responses are flushed with
+// as few writes as possible, so pipelined and batched requests cost one
+// syscall each way. Hint requests copy the visible board and go to a pool
+// of solver threads; finished hints come back through a queue and a
+// self-pipe that wakes the loop. Unanswered hints are capped per connection
+// (proto::MAX_PENDING_HINTS) and by the bytes copied server-wide, so
+// pipelined hints cannot grow the queue without bound. Sessions are not tied to a connection: any
+// client holding a session id may play it. See ServerProtocol.hpp for the
+// wire format.
+class GameServer {
+public:
+    struct Config {
+        std::string     socketPath;
+        int             hintThreads = 2;
+    };
+
+    // Binds and listens; throws std::runtime_error on failure.
+    explicit GameServer(const Config& config);
+    ~GameServer();
+
+    GameServer(const GameServer&)            = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Serves until stop() is called.
+    void run();
+
+    // Safe to call from any thread, including signal-driven shutdown code.
+    void stop();
+
+    int liveSessions() const;
+
+private:
+    struct Connection {
+        int                         fd;
+        std::vector<std::uint8_t>   in;
+        std::vector<std::uint8_t>   out;
+        std::size_t                 outSent = 0;
+        int                         hints   = 0;    // queued, not yet answered
+    };
+
+    struct HintJob {
+        std::uint64_t               connection;
+        std::uint32_t               tag;
+        int                         rows;
+        int                         cols;
+        std::vector<std::uint8_t>   cells;      // visible copy
+    };
+
+    struct HintDone {
+        std::uint64_t               connection;
+        std::size_t                 bytes;      // of the job's copy
+        std::vector<std::uint8_t>   frame;
+    };
+
+    Config                                      config_;
+    int                                         listenFd_   = -1;
+    int                                         wakeRead_   = -1;
+    int                                         wakeWrite_  = -1;
+    std::atomic<bool>                           stopping_{false};
+
+    // Event-loop state
+    SessionPool                                 sessions_;
+    std::atomic<int>                            liveSessions_{0};
+    std::unordered_map<std::uint64_t, Connection> connections_;
+    std::uint64_t                               nextConnection_ = 1;
+    std::vector<int>                            scratch_;
+    std::mt19937                                seedSource_{std::random_device{}()};
+
+    // Hint pool
+    std::vector<std::thread>                    hintWorkers_;
+    std::mutex                                  hintMutex_;
+    std::condition_variable                     hintReady_;
+    std::deque<HintJob>                         hintJobs_;
+    std::mutex                                  doneMutex_;
+    std::vector<HintDone>                       hintsDone_;
+    bool                                        hintsStopping_ = false;
+    std::size_t                                 hintBytes_     = 0;     // event loop only
+
+    void acceptClients();
+    bool readFrom(std::uint64_t id, Connection& c);
+    bool flush(Connection& c);
+    void processFrames(std::uint64_t id, Connection& c);
+    void handleFrame(std::uint64_t id, const std::uint8_t* body, std::uint32_t size,
+                     std::vector<std::uint8_t>& out);
+    void collectHints();
+    void hintLoop();
+    void wake();
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "BoardView.hpp"
+#include "MineProbability.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Lookahead over guesses, for positions where nothing can be proven.
+//
+// The safest tile is not always the best guess: a slightly riskier tile
+// whose number is likely to settle its neighbors can beat one that only
+// leads to another coin flip. Each candidate tile is scored as
+//      P(safe) * sum over numbers n of P(n | safe) * value(board showing n)
+// where a position is worth 1 if it has a proven safe tile, else the score
+// of its best guess, searched the same way until the depth runs out; at the
+// horizon it is the survival chance of its safest tile. P(n | safe) comes
+// from MineProbability's layout count for each hypothetical number.
+//
+// Positions are keyed by a Zobrist hash of the visible tiles, updated with
+// one XOR per hypothetical reveal, and scored once in a transposition table
+// that outlives the call: the next stall usually sits a reveal or two from
+// a position already searched. Root candidates are split between worker
+// threads, each with its own MineProbability cache; candidates unfinished
+// at the deadline are left out of the choice.
+//
+// One instance per owner thread; choose() starts and joins its own workers.
+class GuessSearch {
+public:
+    using Clock = MineProbability::Clock;
+
+    static constexpr std::size_t MAX_TABLE_SIZE = 1 << 16;     // cleared when full
+
+    struct Config {
+        int depth       = 0;    // guesses searched after the one being chosen
+        int candidates  = 6;    // lowest-risk tiles tried per position
+        int threads     = 1;    // workers for the root candidates
+    };
+
+    struct Choice {
+        int     tile        = -1;   // row-major index; -1 if nothing is hidden
+        float   mineChance  = 0.f;
+        float   value       = 0.f;  // estimated chance of surviving the searched line
+        int     searched    = 0;    // root candidates finished by the deadline
+    };
+
+    GuessSearch();
+    explicit GuessSearch(const Config& config);
+    ~GuessSearch();
+
+    GuessSearch(const GuessSearch&)            = delete;
+    GuessSearch& operator=(const GuessSearch&) = delete;
+
+    // probabilities: MineProbability's answer for view and mines. Without
+    // time to finish any candidate the answer is the safest tile.
+    Choice choose(const BoardView& view, int mines, const std::vector<float>& probabilities,
+                  Clock::time_point deadline);
+
+    std::size_t     tableSize() const;
+    std::uint64_t   tableHits() const;
+
+private:
+    struct Entry {
+        double  logLayouts  = 0.0;
+        float   value       = 0.f;
+        int     depth       = 0;
+    };
+    struct Searcher;
+
+    Config                                      config_;
+    int                                         rows_   = 0;
+    int                                         cols_   = 0;
+    int                                         mines_  = -1;
+    std::vector<std::uint64_t>                  keys_;      // [tile * 10 + state], state 0 = flagged, 1 + n = shows n
+    mutable std::mutex                          tableMutex_;
+    std::unordered_map<std::uint64_t, Entry>    table_;
+    std::uint64_t                               hits_   = 0;
+    std::vector<std::unique_ptr<Searcher>>      searchers_;
+
+    std::uint64_t key(int tile, int state) const { return keys_[static_cast<std::size_t>(tile) * 10 + state]; }
+    bool lookup(std::uint64_t hash, int depth, Entry& out);
+    void store(std::uint64_t hash, const Entry& entry);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "BoardFork.hpp"
+#include "MineProbability.hpp"
+#include "SpscQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Computes mine-probability maps on its own thread, with the same
+// generation-tagged submit()/poll() protocol as SolverWorker. When several
+// requests are waiting only the newest is computed, so a burst of moves
+// costs one map. The worker keeps one MineProbability, so components a move
+// did not touch come from its cache.
+//
+// submit() and poll() must be called from a single owner thread.
+class HeatmapWorker {
+public:
+    struct Request {
+        BoardFork       board;
+        int             mines       = 0;
+        std::uint64_t   generation  = 0;
+    };
+    struct Result {
+        std::vector<float>      probabilities;      // see MineProbability::compute
+        MineProbability::Stats  stats;
+        std::uint64_t           generation  = 0;
+    };
+
+    HeatmapWorker();
+    ~HeatmapWorker();
+
+    HeatmapWorker(const HeatmapWorker&)            = delete;
+    HeatmapWorker& operator=(const HeatmapWorker&) = delete;
+
+    // Returns false if the request queue is full.
+    bool submit(BoardFork board, int mines, std::uint64_t generation);
+    bool poll(Result& out);
+
+private:
+    SpscQueue<Request>      requests_;
+    SpscQueue<Result>       results_;
+    std::atomic<bool>       stop_{false};
+    std::mutex              wakeMutex_;
+    std::condition_variable wake_;
+    std::thread             thread_;
+
+    void run();
+};
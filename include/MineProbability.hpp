@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BoardView.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Exact mine probabilities for the hidden tiles of a board.
+//
+// Hidden tiles next to a revealed number form constraint components: tiles
+// linked through the numbers they share. Each component's solutions are
+// enumerated once and summarized as solution counts per mine total; the
+// components are then weighted against each other and against the
+// unconstrained tiles using the board's mine count. Summaries are cached by
+// the component's exact constraints, so after a move only the components it
+// touched are enumerated again and the rest is a cheap re-weighting.
+//
+// Flags are trusted as mines. An instance is meant for one thread.
+class MineProbability {
+public:
+    static constexpr float NOT_HIDDEN       = -1.f;     // revealed or flagged
+    static constexpr float UNKNOWN          = -2.f;     // over budget, or no layout fits
+    static constexpr int   MAX_SEARCH_NODES = 1 << 20;  // per component
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        int     components  = 0;
+        int     enumerated  = 0;    // components that missed the cache
+        // ln of the number of mine layouts the board allows, counting
+        // over-budget components as unconstrained; -inf when none fits
+        double  logLayouts  = -std::numeric_limits<double>::infinity();
+    };
+
+    // Fills out with one value per tile, row-major: a probability in [0, 1]
+    // or one of the sentinels above. mines is the board's total mine count.
+    void compute(const BoardView& view, int mines, std::vector<float>& out);
+
+    // As above, but gives up at deadline: returns false with every hidden
+    // tile UNKNOWN. Components finished before the deadline stay cached.
+    bool compute(const BoardView& view, int mines, std::vector<float>& out,
+                 Clock::time_point deadline);
+
+    const Stats& lastStats() const { return stats_; }
+
+private:
+    // Solutions of one component, by number of mines k
+    struct Summary {
+        std::vector<double> counts;         // [k]
+        std::vector<double> tileCounts;     // [var * (vars + 1) + k]: solutions with var a mine
+        bool                overflow = false;
+        bool                timedOut = false;   // never cached
+    };
+
+    struct Component {
+        std::vector<int>    vars;           // tile indices, in search order
+        std::vector<int>    constraints;    // indices into constraintTiles_
+        const Summary*      summary = nullptr;
+    };
+
+    std::unordered_map<std::string, Summary>    cache_;
+    Stats                                       stats_;
+
+    // Scratch, reused between calls
+    std::vector<int>            parent_;
+    std::vector<int>            componentOf_;       // by union-find root
+    std::vector<int>            localIndex_;        // tile -> position in its component
+    std::vector<std::uint8_t>   placed_;
+    std::vector<int>            constraintTiles_;
+    std::vector<int>            remaining_;
+    std::vector<int>            constraintVars_;    // hidden neighbors, 8 per constraint (-1 padded)
+    std::vector<Component>      components_;
+
+    Summary enumerate(const Component& c, Clock::time_point deadline);
+};
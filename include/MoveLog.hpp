@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Board.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Compact binary move log.
+//
+// File layout: the 4-byte magic "MSLG" and a version byte, followed by any
+// number of games. Every record is a single LEB128 varint
+//
+//      (payload << 3) | action
+//
+// where the payload of a cell action is the zigzag-encoded difference from
+// the previous cell index of the same game. A BeginGame record carries no
+// payload and is followed by four more varints: seed, rows, cols, mines.
+// Replays are deterministic because Board derives both the initial layout
+// and the first-click relocation from the seed.
+enum class MoveAction : std::uint8_t {
+    BeginGame   = 0,
+    Reveal      = 1,
+    Flag        = 2,
+    Chord       = 3,
+    AIStep      = 4,
+};
+
+struct GameHeader {
+    std::uint32_t   seed    = 0;
+    int             rows    = 0;
+    int             cols    = 0;
+    int             mines   = 0;
+};
+
+struct Move {
+    MoveAction  action  = MoveAction::AIStep;
+    int         cell    = 0;                    // y * cols + x; unused for AIStep
+};
+
+class MoveLogWriter {
+public:
+    // Writes the file header immediately. Records are buffered and only hit
+    // the stream when the buffer fills, on flush(), or on destruction.
+    explicit MoveLogWriter(std::ostream& out, std::size_t bufferSize = 1 << 16);
+    ~MoveLogWriter();
+
+    MoveLogWriter(const MoveLogWriter&)            = delete;
+    MoveLogWriter& operator=(const MoveLogWriter&) = delete;
+
+    void beginGame(const GameHeader& header);
+    void reveal(int x, int y);
+    void flag  (int x, int y);
+    void chord (int x, int y);
+    void aiStep();
+    void flush();
+
+private:
+    std::ostream&               out_;
+    std::vector<std::uint8_t>   buffer_;
+    std::size_t                 used_       = 0;
+    int                         cols_       = 0;
+    int                         prevCell_   = 0;
+
+    void record(MoveAction action, int cell);
+    void putVarint(std::uint64_t value);
+};
+
+class MoveLogReader {
+public:
+    // Throws std::runtime_error if the stream does not start with a valid
+    // move-log header.
+    explicit MoveLogReader(std::istream& in, std::size_t bufferSize = 1 << 16);
+
+    // Advances to the next game, skipping any unread moves of the current
+    // one. Returns false at end of stream. Throws std::runtime_error on a
+    // header no game could have: an empty or oversized board, or more than
+    // rows*cols - 9 mines.
+    bool nextGame(GameHeader& out);
+
+    // Reads the next move of the current game. Returns false once the game
+    // has no more moves.
+    bool nextMove(Move& out);
+
+private:
+    std::istream&               in_;
+    std::vector<std::uint8_t>   buffer_;
+    std::size_t                 pos_        = 0;
+    std::size_t                 end_        = 0;
+    int                         prevCell_   = 0;
+    bool                        inGame_     = false;
+    bool                        pendingBegin_ = false;
+
+    bool fill();
+    bool getVarint(std::uint64_t& out);
+    void readHeaderFields(GameHeader& out);
+};
+
+struct ReplayResult {
+    bool        lost    = false;
+    bool        cleared = false;
+    std::size_t moves   = 0;
+};
+
+// Replays the reader's current game on the given board, which is reset to
+// the game's seed and dimensions first. Call after nextGame() returns true.
+ReplayResult replayGame(MoveLogReader& reader, const GameHeader& header, Board& board);
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Precomputed local deductions for PatternStrategy (Strategy.hpp).
+//
+// Every table entry answers "which unknown tiles of this small window are
+// forced?" for one encoding of the window: a bit per unknown tile plus the
+// mines still missing around the revealed tile(s) at its center (number
+// minus flagged neighbors). Entries hold the safe tiles in the low 16 bits
+// and the forced mines in the high 16 bits.
+//
+// Single: the 3x3 window around one revealed tile, its 8 neighbors in
+//      row-major order.        index = remaining * 256 + unknownMask
+// Pair: two orthogonally adjacent revealed tiles A and B. Laid out
+//      horizontally (B right of A) the window is 4x3:
+//          0 1 2 3
+//          4 A B 5
+//          6 7 8 9
+//      A vertical pair uses the same table with dx and dy swapped.
+//                              index = (remainingA * 8 + remainingB) * 1024 + unknownMask
+// Solving the pair's two constraints together gives the subset rules
+// (1-2, 1-1 against a wall, ...) the single-tile rules cannot see.
+namespace patterns {
+
+constexpr int SINGLE_CELLS          = 8;
+constexpr int PAIR_CELLS            = 10;
+constexpr int MAX_SINGLE_REMAINING  = 8;
+constexpr int MAX_PAIR_REMAINING    = 7;    // the other tile of the pair is revealed
+
+using SingleTable = std::array<std::uint32_t, (MAX_SINGLE_REMAINING + 1) << SINGLE_CELLS>;
+using PairTable   = std::array<std::uint32_t,
+                               (MAX_PAIR_REMAINING + 1) * (MAX_PAIR_REMAINING + 1) << PAIR_CELLS>;
+
+constexpr int SINGLE_DX[SINGLE_CELLS] = {-1,  0,  1, -1, 1, -1, 0, 1};
+constexpr int SINGLE_DY[SINGLE_CELLS] = {-1, -1, -1,  0, 0,  1, 1, 1};
+
+// Offsets from A for a horizontal pair
+constexpr int PAIR_DX[PAIR_CELLS] = {-1,  0,  1,  2, -1, 2, -1, 0, 1, 2};
+constexpr int PAIR_DY[PAIR_CELLS] = {-1, -1, -1, -1,  0, 0,  1, 1, 1, 1};
+
+// Window cells next to A (dx <= 1) and next to B (dx >= 0)
+constexpr unsigned PAIR_A_MASK = 0b0111010111;
+constexpr unsigned PAIR_B_MASK = 0b1110101110;
+
+constexpr std::uint32_t safeMask(std::uint32_t entry) { return entry & 0xFFFFu; }
+constexpr std::uint32_t mineMask(std::uint32_t entry) { return entry >> 16; }
+
+constexpr int popcount(unsigned v) {
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+}
+
+// Forced tiles for two constraints: unknownsA hold ma mines, unknownsB
+// hold mb. The k mines in the shared tiles satisfy
+//      max(0, ma - |A only|, mb - |B only|) <= k <= min(|shared|, ma, mb)
+// and a group is forced when every k in that range agrees on it. A single
+// constraint is the case unknownsB = 0, mb = 0. Inconsistent inputs
+// deduce nothing.
+constexpr std::uint32_t deduce(unsigned unknownsA, unsigned unknownsB, int ma, int mb) {
+    const unsigned shared = unknownsA & unknownsB;
+    const unsigned onlyA  = unknownsA & ~unknownsB;
+    const unsigned onlyB  = unknownsB & ~unknownsA;
+    const int s = popcount(shared);
+    const int a = popcount(onlyA);
+    const int b = popcount(onlyB);
+
+    int lo = 0;
+    if (ma - a > lo) lo = ma - a;
+    if (mb - b > lo) lo = mb - b;
+    int hi = s;
+    if (ma < hi) hi = ma;
+    if (mb < hi) hi = mb;
+    if (lo > hi) return 0;
+
+    unsigned safe  = 0;
+    unsigned mines = 0;
+    if (hi == 0)        safe  |= shared;
+    if (lo == s)        mines |= shared;
+    if (ma - lo == 0)   safe  |= onlyA;
+    if (ma - hi == a)   mines |= onlyA;
+    if (mb - lo == 0)   safe  |= onlyB;
+    if (mb - hi == b)   mines |= onlyB;
+    return safe | mines << 16;
+}
+
+constexpr SingleTable buildSingleTable() {
+    SingleTable t{};
+    for (int r = 0; r <= MAX_SINGLE_REMAINING; ++r) {
+        for (unsigned m = 0; m < (1u << SINGLE_CELLS); ++m) {
+            t[(r << SINGLE_CELLS) | m] = deduce(m, 0, r, 0);
+        }
+    }
+    return t;
+}
+
+constexpr PairTable buildPairTable() {
+    PairTable t{};
+    for (int ra = 0; ra <= MAX_PAIR_REMAINING; ++ra) {
+        for (int rb = 0; rb <= MAX_PAIR_REMAINING; ++rb) {
+            const unsigned base = static_cast<unsigned>(ra * (MAX_PAIR_REMAINING + 1) + rb) << PAIR_CELLS;
+            for (unsigned m = 0; m < (1u << PAIR_CELLS); ++m) {
+                t[base | m] = deduce(m & PAIR_A_MASK, m & PAIR_B_MASK, ra, rb);
+            }
+        }
+    }
+    return t;
+}
+
+// The tables themselves, built once; constant-initialized where the
+// compiler's constexpr budget allows.
+const SingleTable& singleTable();
+const PairTable&   pairTable();
+
+inline std::uint32_t lookupSingle(unsigned unknowns, int remaining) {
+    if (remaining < 0 || remaining > MAX_SINGLE_REMAINING) return 0;
+    return singleTable()[static_cast<unsigned>(remaining) << SINGLE_CELLS | unknowns];
+}
+
+inline std::uint32_t lookupPair(unsigned unknowns, int remainingA, int remainingB) {
+    if (remainingA < 0 || remainingA > MAX_PAIR_REMAINING
+        || remainingB < 0 || remainingB > MAX_PAIR_REMAINING) {
+        return 0;
+    }
+    const unsigned base = static_cast<unsigned>(remainingA * (MAX_PAIR_REMAINING + 1) + remainingB);
+    return pairTable()[base << PAIR_CELLS | unknowns];
+}
+
+}  // namespace patterns
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Board.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Worst-case inputs for the hot paths, with recorded time budgets.
+//
+// A case is one manifest line (see tests/perf/worst_cases.txt):
+//      name  kind  rows  cols  mines  seed  budget_ms
+// and the board is rebuilt from it deterministically, so the checked-in
+// corpus is a few lines of text however big the boards are. Kinds:
+//      opening     mines on the first tiles in row-major order; the timed
+//                  reveal at the bottom-right floods the rest of the board
+//      dense       reset to a random layout (seed) and the first reveal at
+//                  the center; meant for mines near rows*cols - 9, where
+//                  placement and first-click relocation are tightest
+//      relocate    every tile mined except the last rows*cols - mines in
+//                  row-major order, so the first click at the center must
+//                  move all nine mines of its 3x3 into the far corner
+//      chain       the first seed from seed on whose layout the two rules
+//                  clear from the center without a guess; timed is the
+//                  first reveal plus AISolver() steps until it stalls,
+//                  hundreds of steps that each resume the solver's scan
+// budget_ms is the slowest best-of-5 time seen over a few recordings on
+// the machine that recorded it.
+
+struct PerfCase {
+    enum class Kind : std::uint8_t { Opening, Dense, Relocate, Chain };
+
+    std::string     name;
+    Kind            kind        = Kind::Opening;
+    int             rows        = 0;
+    int             cols        = 0;
+    int             mines       = 0;
+    std::uint32_t   seed        = 0;
+    double          budgetMs    = 0.0;
+};
+
+const char* perfKindName(PerfCase::Kind kind);
+
+// '#' starts a comment. Throws std::runtime_error on malformed lines or
+// sizes a case cannot be built with.
+std::vector<PerfCase> readPerfManifest(std::istream& in);
+void writePerfManifest(std::ostream& out, const std::vector<PerfCase>& cases);
+
+// The board a case starts from, before the timed operation
+Board buildPerfBoard(const PerfCase& c);
+
+// The timed operation on a board from buildPerfBoard
+void runPerfCase(const PerfCase& c, Board& board);
+
+// Best wall time of repeat runs in milliseconds, board setup excluded
+double timePerfCase(const PerfCase& c, int repeat);
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Strategy.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Mine-layout corpora for bulk solver evaluation.
+//
+// File layout, little-endian:
+//      "MSPC"  u16 version  u16 rows  u16 cols  u16 reserved  u32 count
+//      count records of ceil(rows*cols / 8) bytes: the mine bitset, tile
+//      i = y*cols + x at bit (i % 8) of byte i / 8
+// Records have a fixed size, so puzzle k is found by arithmetic alone.
+
+// Read-only corpus backed by a memory map. Records are handed out as
+// pointers into the mapping; nothing is copied or allocated per puzzle.
+class PuzzleCorpus {
+public:
+    static constexpr std::uint16_t VERSION      = 1;
+    static constexpr std::size_t   HEADER_SIZE  = 16;
+    static constexpr int           MAX_TILES    = 1 << 26;     // rows*cols, so tile indices fit an int
+
+    // Maps path; throws std::runtime_error on I/O or format errors.
+    explicit PuzzleCorpus(const std::string& path);
+    ~PuzzleCorpus();
+
+    PuzzleCorpus(const PuzzleCorpus&)            = delete;
+    PuzzleCorpus& operator=(const PuzzleCorpus&) = delete;
+
+    int                 rows()       const { return rows_; }
+    int                 cols()       const { return cols_; }
+    std::size_t         size()       const { return count_; }
+    std::size_t         recordSize() const { return recordSize_; }
+    const std::uint8_t* mineBits(std::size_t i) const;
+
+private:
+    const std::uint8_t* data_       = nullptr;
+    std::size_t         length_     = 0;
+    int                 rows_       = 0;
+    int                 cols_       = 0;
+    std::size_t         count_      = 0;
+    std::size_t         recordSize_ = 0;
+};
+
+// Appends layouts to a corpus stream. The count in the header is patched
+// by finish() (or the destructor), so the stream must be seekable.
+class PuzzleCorpusWriter {
+public:
+    // Throws std::runtime_error if a side is outside 1..65535 or the board
+    // has more than PuzzleCorpus::MAX_TILES tiles.
+    PuzzleCorpusWriter(std::ostream& out, int rows, int cols);
+    ~PuzzleCorpusWriter();
+
+    // rows*cols packed cells (Cell.hpp); only the mine bits are stored.
+    void add(const std::uint8_t* cells);
+    void finish();
+
+private:
+    std::ostream&               out_;
+    int                         rows_;
+    int                         cols_;
+    std::uint32_t               count_      = 0;
+    bool                        finished_   = false;
+    std::streampos              start_;         // header position
+    std::vector<std::uint8_t>   record_;
+};
+
+// Writes count layouts generated from seeds firstSeed, firstSeed+1, ...,
+// identical to Board's layouts for those seeds before the first click.
+void generateCorpus(std::ostream& out, int rows, int cols, int mines,
+                    std::uint32_t firstSeed, std::uint32_t count);
+
+struct PuzzleResult {
+    enum class Outcome : std::uint8_t { Solved, Stuck, Lost };
+
+    Outcome         outcome     = Outcome::Stuck;
+    int             revealed    = 0;        // safe tiles open at the end
+    int             safeTiles   = 0;
+    int             moves       = 0;
+    float           micros      = 0.f;      // load + solve time
+};
+
+// Plays corpus layouts with a strategy on one reusable cell buffer. The
+// layout is played as stored: there is no first-click relocation, so a
+// start cell on a mine is an immediate loss.
+class CorpusSolver {
+public:
+    CorpusSolver(int rows, int cols);
+
+    PuzzleResult solve(const std::uint8_t* mineBits, int startX, int startY, Strategy& strategy);
+
+    // Cells of the last puzzle, for inspection
+    const std::uint8_t* cells() const { return cells_.data(); }
+
+private:
+    int                         rows_;
+    int                         cols_;
+    std::vector<std::uint8_t>   cells_;
+    std::vector<int>            scratch_;
+    std::vector<StrategyMove>   moves_;
+
+    int load(const std::uint8_t* mineBits);
+};
+
+// Solves every puzzle in order, streaming one CSV row per puzzle to out
+// ("index,outcome,revealed,safe,moves,us", with a header).
+void solveCorpus(const PuzzleCorpus& corpus, int startX, int startY,
+                 Strategy& strategy, std::ostream& out);
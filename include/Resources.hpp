@@ -0,0 +1,21 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+
+// Assets compiled into the binary by cmake/EmbedResource.cmake, so nothing
+// depends on the working directory at startup.
+namespace resources {
+
+extern const unsigned char  FONT_DATA[];
+extern const std::size_t    FONT_SIZE;
+
+// The UI font, parsed from FONT_DATA on first use and shared by every Board
+// and Game for the life of the process. SFML rasterizes each glyph the
+// first time a character size needs it and caches it in the font, so the
+// work is done once per process rather than once per board. Like any
+// sf::Font, use it from the render thread only.
+const sf::Font& font();
+
+}  // namespace resources
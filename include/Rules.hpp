@@ -0,0 +1,238 @@
+#pragma once
+
+#include "Cell.hpp"
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+// Game rules shared by every board representation (Board, BoardFork,
+// BatchEnv). Each function is templated on a Grid exposing
+//
+//      int          rows() const;
+//      int          cols() const;
+//      std::uint8_t get(int i) const;          // packed cell byte, see Cell.hpp
+//      void         set(int i, std::uint8_t v);
+//
+// so storage, copy-on-write and journaling stay the caller's business.
+// Scratch vectors are passed in so hot loops never allocate.
+namespace rules {
+
+struct RevealResult {
+    int     opened  = 0;        // safe tiles newly revealed
+    bool    hit     = false;    // a mine was revealed
+};
+
+// Invokes fn(nx, ny) for each in-bounds 8-neighbor of (x, y).
+template<typename Grid, typename F>
+void forEachNeighbor(const Grid& g, int x, int y, F&& fn) {
+    const int rows = g.rows();
+    const int cols = g.cols();
+    int visits = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if (nx >= 0 && nx < cols && ny >= 0 && ny < rows) {
+                fn(nx, ny);
+                ++visits;
+            }
+        }
+    }
+    stats::add(stats::Counter::NeighborVisits, visits);
+}
+
+// Recomputes the cached adjacent-mine count of (x, y); mines keep 0.
+template<typename Grid>
+void refreshAdjacency(Grid& g, int x, int y) {
+    const int cols = g.cols();
+    const int i = y * cols + x;
+    const std::uint8_t c = g.get(i);
+
+    int adjacentMines = 0;
+    if (!(c & cell::MINE)) {
+        forEachNeighbor(g, x, y, [&](int nx, int ny) {
+            if (g.get(ny * cols + nx) & cell::MINE) ++adjacentMines;
+        });
+    }
+    g.set(i, static_cast<std::uint8_t>((c & cell::STATE_MASK) | (adjacentMines << cell::ADJ_SHIFT)));
+}
+
+template<typename Grid>
+void computeAdjacency(Grid& g) {
+    stats::ScopedTimer timer(stats::Counter::AdjacencyNanos);
+    stats::add(stats::Counter::AdjacencyCalls);
+    for (int y = 0; y < g.rows(); ++y) {
+        for (int x = 0; x < g.cols(); ++x) refreshAdjacency(g, x, y);
+    }
+}
+
+// Clears the grid and places numMines mines with the same shuffle Board has
+// always used, so a given seed yields the same layout everywhere.
+template<typename Grid, typename Rng>
+void placeMines(Grid& g, int numMines, Rng& rng, std::vector<int>& scratch) {
+    const int N = g.rows() * g.cols();
+    for (int i = 0; i < N; ++i) g.set(i, 0);
+
+    scratch.resize(N);
+    std::iota(scratch.begin(), scratch.end(), 0);
+    std::shuffle(scratch.begin(), scratch.end(), rng);
+    for (int i = 0; i < numMines && i < N; ++i) {
+        g.set(scratch[i], cell::MINE);
+    }
+    computeAdjacency(g);
+}
+
+// First-click safety: moves any mine in the 3x3 area around (x, y) to a
+// random tile outside it and refreshes adjacency around every tile whose
+// mine bit changed. The candidate pool is shuffled even when nothing moves,
+// which keeps the RNG stream identical to Board's original implementation.
+// Returns the number of mines removed from the board because too few free
+// tiles were left outside the area (0 whenever mines <= rows*cols - 9);
+// callers that keep a safe-tile count must add it back.
+template<typename Grid, typename Rng>
+int relocateFromSafeArea(Grid& g, int x, int y, Rng& rng, std::vector<int>& scratch) {
+    const int cols = g.cols();
+    const int N = g.rows() * cols;
+    auto inSafeArea = [&](int i) {
+        return std::abs(i % cols - x) <= 1 && std::abs(i / cols - y) <= 1;
+    };
+
+    // At most 9 mines leave the safe area and 9 arrive elsewhere.
+    std::array<int, 18> changed;
+    int numChanged = 0;
+
+    // Gather the mines in the safe area
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if (nx < 0 || nx >= cols || ny < 0 || ny >= g.rows()) continue;
+
+            const int i = ny * cols + nx;
+            if (g.get(i) & cell::MINE) {
+                changed[numChanged++] = i;
+                g.set(i, g.get(i) & ~cell::MINE);
+            }
+        }
+    }
+
+    // Find new tiles for mines in the safe area
+    scratch.clear();
+    for (int i = 0; i < N; ++i) {
+        if (!(g.get(i) & cell::MINE) && !inSafeArea(i)) scratch.push_back(i);
+    }
+    std::shuffle(scratch.begin(), scratch.end(), rng);
+
+    const int moved  = numChanged;
+    const int placed = std::min(moved, static_cast<int>(scratch.size()));
+    for (int k = 0; k < placed; ++k) {
+        g.set(scratch[k], g.get(scratch[k]) | cell::MINE);
+        changed[numChanged++] = scratch[k];
+    }
+    if (moved > 0) {
+        stats::add(stats::Counter::FirstClickRelocations);
+        stats::add(stats::Counter::MinesRelocated, placed);
+    }
+
+    // Recompute adjacent mines around the tiles whose mine bit changed
+    for (int k = 0; k < numChanged; ++k) {
+        const int c = changed[k];
+        refreshAdjacency(g, c % cols, c / cols);
+        forEachNeighbor(g, c % cols, c / cols, [&](int nx, int ny) {
+            refreshAdjacency(g, nx, ny);
+        });
+    }
+    return moved - placed;
+}
+
+// Reveals (x, y), flood-filling through 0-tiles with an explicit stack so
+// deep openings on huge boards cannot overflow the call stack. Flagged and
+// already-revealed tiles are left alone.
+template<typename Grid>
+RevealResult reveal(Grid& g, int x, int y, std::vector<int>& stack) {
+    const int cols = g.cols();
+    const int i = y * cols + x;
+    const std::uint8_t t = g.get(i);
+
+    RevealResult result;
+    stats::add(stats::Counter::RevealCalls);
+    if (t & (cell::REVEALED | cell::FLAGGED)) return result;
+
+    g.set(i, t | cell::REVEALED);
+    if (t & cell::MINE) {
+        result.hit = true;
+        return result;
+    }
+    ++result.opened;
+    if (cell::adjacent(t) != 0) {
+        stats::add(stats::Counter::TilesOpened);
+        return result;
+    }
+
+    stack.clear();
+    stack.push_back(i);
+    std::size_t depth = 1;
+    while (!stack.empty()) {
+        depth = std::max(depth, stack.size());
+        const int c = stack.back();
+        stack.pop_back();
+
+        forEachNeighbor(g, c % cols, c / cols, [&](int nx, int ny) {
+            const int n = ny * cols + nx;
+            const std::uint8_t nc = g.get(n);
+            if (nc & (cell::REVEALED | cell::FLAGGED)) return;
+
+            // 0-tiles never border a mine, so every neighbor here is safe.
+            g.set(n, nc | cell::REVEALED);
+            ++result.opened;
+            if (cell::adjacent(nc) == 0) stack.push_back(n);
+        });
+    }
+    stats::add(stats::Counter::TilesOpened, result.opened);
+    stats::max(stats::Counter::MaxFloodDepth, depth);
+    return result;
+}
+
+// Chord: on a revealed tile whose flagged-neighbor count equals its number,
+// reveals every unflagged neighbor. A no-op otherwise.
+template<typename Grid>
+RevealResult chord(Grid& g, int x, int y, std::vector<int>& stack) {
+    const int cols = g.cols();
+    const std::uint8_t t = g.get(y * cols + x);
+
+    RevealResult result;
+    if (!(t & cell::REVEALED) || (t & cell::FLAGGED)) return result;
+
+    int flags = 0;
+    forEachNeighbor(g, x, y, [&](int nx, int ny) {
+        if (g.get(ny * cols + nx) & cell::FLAGGED) ++flags;
+    });
+    if (flags != cell::adjacent(t)) return result;
+
+    forEachNeighbor(g, x, y, [&](int nx, int ny) {
+        const RevealResult r = reveal(g, nx, ny, stack);
+        result.opened += r.opened;
+        result.hit    |= r.hit;
+    });
+    return result;
+}
+
+// Toggles the flag on an unrevealed tile. Returns true if anything changed.
+template<typename Grid>
+bool toggleFlag(Grid& g, int x, int y) {
+    const int i = y * g.cols() + x;
+    const std::uint8_t t = g.get(i);
+    if (t & cell::REVEALED) return false;
+
+    g.set(i, t ^ cell::FLAGGED);
+    return true;
+}
+
+}  // namespace rules
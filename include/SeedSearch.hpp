@@ -0,0 +1,52 @@
+#pragma once
+
+#include "BoardMetrics.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Finds seeds whose layouts fall inside target difficulty ranges, without
+// playing them: each seed is dealt and measured by a LayoutMeter
+// (BoardMetrics.hpp) in O(tiles).
+
+// Inclusive bounds on one metric; the default accepts anything
+struct MetricRange {
+    int min = 0;
+    int max = INT_MAX;
+
+    bool contains(int v) const { return v >= min && v <= max; }
+};
+
+struct SeedSearchConfig {
+    int             rows        = 16;
+    int             cols        = 30;
+    int             mines       = 99;
+    int             startX      = 15;       // first click the layouts are dealt for
+    int             startY      = 8;
+    std::uint32_t   firstSeed   = 0;
+    std::uint64_t   count       = 1u << 20; // seeds firstSeed, firstSeed + 1, ... (mod 2^32)
+    std::size_t     limit       = 0;        // stop after this many matches; 0 = scan everything
+    int             threads     = 1;
+    MetricRange     bbbv;
+    MetricRange     openings;
+    MetricRange     largestOpening;
+    MetricRange     isolated;
+    MetricRange     guesses;
+};
+
+struct SeedMatch {
+    std::uint32_t   seed    = 0;
+    BoardMetrics    metrics;
+};
+
+// Matches in scan order. Workers claim fixed-size chunks of the range in
+// order and stop claiming once limit matches are in, so the answer is the
+// first limit matches whatever the thread count. scanned, if given,
+// receives the number of seeds measured.
+std::vector<SeedMatch> searchSeeds(const SeedSearchConfig& config, std::uint64_t* scanned = nullptr);
+
+// "seed,3bv,openings,largest_opening,isolated,guesses" plus one row per match
+void writeSeedCsv(std::ostream& os, const std::vector<SeedMatch>& matches);
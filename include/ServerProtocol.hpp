@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary protocol of the headless game server (GameServer.hpp).
+//
+// Every message in both directions is a frame, all integers little-endian:
+//      u32 bodySize    bytes after this field
+//      u32 tag         chosen by the client, echoed in the response
+//      u8  code        Op in requests, Status in responses
+//      ...             arguments / payload
+//
+// Clients may pipeline: write any number of frames back to back without
+// waiting. The server answers each frame exactly once. Responses come back
+// in request order, except Hint, which is answered whenever the solver
+// pool finishes; match responses by tag.
+//
+// Requests and their Ok payloads:
+//      NewGame     u16 rows, u16 cols, u32 mines, u8 flags, u32 seed
+//                  flags bit 0: use seed, otherwise one is picked
+//                  mines <= rows*cols - 9, so the first click's 3x3 fits
+//                  -> u32 session, u32 seed
+//      Reveal      u32 session, u16 x, u16 y
+//      Flag        "
+//      Chord       "
+//                  -> u8 GameStatus, u32 tiles opened, u32 safe tiles left
+//      Hint        u32 session
+//                  -> u8 SolverMove::Action, u16 x, u16 y
+//                  ServerFull past MAX_PENDING_HINTS unanswered hints on
+//                  the connection, or when the server's hint queue is full
+//      State       u32 session
+//                  -> u8 GameStatus, u16 rows, u16 cols, rows*cols bytes
+//                     of visible cell state (BoardView::cellAt)
+//      Close       u32 session
+//                  -> nothing
+// Responses with any other status carry no payload.
+namespace proto {
+
+constexpr std::uint32_t HEADER_SIZE       = 9;          // size + tag + code
+constexpr std::uint32_t MAX_BODY_SIZE     = 1u << 24;
+constexpr int           MAX_DIMENSION     = 1024;
+constexpr int           MAX_PENDING_HINTS = 64;         // per connection
+
+enum class Op : std::uint8_t {
+    NewGame = 1,
+    Reveal,
+    Flag,
+    Chord,
+    Hint,
+    State,
+    Close,
+};
+
+enum class Status : std::uint8_t {
+    Ok = 0,
+    UnknownSession,
+    UnknownOp,
+    BadArguments,
+    ServerFull,
+};
+
+enum class GameStatus : std::uint8_t { Playing = 0, Won, Lost };
+
+constexpr std::uint8_t NEW_GAME_USE_SEED = 1 << 0;
+
+inline void putU8(std::vector<std::uint8_t>& out, std::uint8_t v) {
+    out.push_back(v);
+}
+
+inline void putU16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+    out.push_back(static_cast<std::uint8_t>(v));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+inline std::uint32_t loadU32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8
+         | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+// Appends a frame header with a placeholder size; endFrame patches it.
+inline std::size_t beginFrame(std::vector<std::uint8_t>& out, std::uint32_t tag, std::uint8_t code) {
+    const std::size_t start = out.size();
+    putU32(out, 0);
+    putU32(out, tag);
+    putU8(out, code);
+    return start;
+}
+
+inline void endFrame(std::vector<std::uint8_t>& out, std::size_t start) {
+    const std::uint32_t body = static_cast<std::uint32_t>(out.size() - start - 4);
+    for (int i = 0; i < 4; ++i) out[start + i] = static_cast<std::uint8_t>(body >> (8 * i));
+}
+
+// Bounds-checked little-endian cursor; any overrun clears ok.
+struct Reader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+    bool                ok = true;
+
+    bool has(std::size_t n) {
+        if (static_cast<std::size_t>(end - p) < n) ok = false;
+        return ok;
+    }
+    std::uint8_t u8() {
+        return has(1) ? *p++ : 0;
+    }
+    std::uint16_t u16() {
+        if (!has(2)) return 0;
+        const std::uint16_t v = static_cast<std::uint16_t>(p[0] | p[1] << 8);
+        p += 2;
+        return v;
+    }
+    std::uint32_t u32() {
+        if (!has(4)) return 0;
+        const std::uint32_t v = loadU32(p);
+        p += 4;
+        return v;
+    }
+};
+
+}  // namespace proto
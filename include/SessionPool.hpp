@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Rules.hpp"
+#include "ServerProtocol.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// One headless game hosted by the server. Plays by the shared rules with
+// the same mine placement and first-click relocation as Board, so a seed
+// reproduces the same game in the GUI.
+struct Session {
+    std::vector<std::uint8_t>   cells;
+    std::mt19937                rng;
+    std::uint32_t               seed        = 0;
+    int                         rows        = 0;
+    int                         cols        = 0;
+    int                         mines       = 0;
+    int                         safeHidden  = 0;
+    bool                        firstClick  = true;
+    proto::GameStatus           status      = proto::GameStatus::Playing;
+
+    void start(int numRows, int numCols, int numMines, std::uint32_t gameSeed,
+               std::vector<int>& scratch);
+
+    // Moves on a finished game, or off the board, change nothing.
+    rules::RevealResult reveal(int x, int y, std::vector<int>& scratch);
+    rules::RevealResult chord (int x, int y, std::vector<int>& scratch);
+    void                flag  (int x, int y);
+
+private:
+    struct Grid;
+    bool playable(int x, int y) const;
+    void finishMove(const rules::RevealResult& r);
+
+    // Pool bookkeeping
+    friend class SessionPool;
+    std::uint32_t               generation_ = 1;    // never 0, see INVALID_ID
+    bool                        live_       = false;
+};
+
+// Slab allocator for sessions. Sessions live in fixed-size slabs that are
+// never moved or freed, so pointers stay valid and a closed session's cell
+// buffer is reused by the next game in its slot. Ids pack the slot with a
+// generation counter, so an id that outlives its session is rejected
+// rather than aliasing a newer game. Generations run 1..4095 and wrap back
+// to 1, so no live session's id is 0. Not thread-safe.
+class SessionPool {
+public:
+    static constexpr int            SLAB_SHIFT      = 8;
+    static constexpr int            SLAB_SIZE       = 1 << SLAB_SHIFT;
+    static constexpr int            SLOT_BITS       = 20;
+    static constexpr int            MAX_SESSIONS    = 1 << SLOT_BITS;
+    static constexpr std::uint32_t  INVALID_ID      = 0;
+
+    // Returns INVALID_ID when MAX_SESSIONS are live
+    std::uint32_t create();
+    Session*      find(std::uint32_t id);
+    bool          destroy(std::uint32_t id);
+
+    int liveCount() const;
+    int capacity()  const;
+
+private:
+    std::vector<std::unique_ptr<Session[]>> slabs_;
+    std::vector<std::uint32_t>              free_;      // slots, reused LIFO
+    int                                     live_ = 0;
+
+    Session& slot(std::uint32_t s) { return slabs_[s >> SLAB_SHIFT][s & (SLAB_SIZE - 1)]; }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ResultsWriter;
+
+// Splits a seed range into shards and farms them out to worker processes
+// over a Unix domain socket, for runs too long for one MinesweeperTournament.
+//
+// Shard i holds seeds firstSeed + i * shardSize onwards, and a worker plays
+// every strategy on each of them exactly as runTournament would
+// (playTournamentGame). Untimed strategies' games depend only on the seeds,
+// so which worker plays a shard, and when, does not change them. A timed
+// strategy (StrategyInfo::timed) thinks against the clock: it is left out
+// of the default set, and if named explicitly a requeued or resumed shard
+// may record different outcomes than its first attempt would have.
+//
+// The coordinator appends each returned shard to a results store
+// (ResultsStore.hpp) as one block, syncs it, and only then appends
+// "done <shard> <results bytes>" to a text checkpoint. A restart with the
+// same configuration cuts the results file back to the last checkpointed
+// size, dropping anything half written by the crash, and hands out only
+// the shards not yet done. A worker that disconnects mid-shard loses it to
+// the next idle worker.
+//
+// Frames are ServerProtocol.hpp frames (size, tag, code) with their own
+// codes, see shard_coordinator.cpp.
+class ShardCoordinator {
+public:
+    struct Config {
+        std::string                 socketPath;
+        std::string                 resultsPath;
+        std::string                 checkpointPath;
+        int                         rows        = 16;
+        int                         cols        = 30;
+        int                         mines       = 99;
+        std::uint32_t               firstSeed   = 1;
+        std::uint32_t               seedCount   = 100000;
+        std::uint32_t               shardSize   = 1000;
+        std::vector<std::string>    strategies;             // strategyRegistry() names; empty = all untimed
+    };
+
+    // Binds the socket and opens or resumes the checkpoint. Throws
+    // std::runtime_error on a bad config, I/O errors, or a checkpoint
+    // written for a different run.
+    explicit ShardCoordinator(const Config& config);
+    ~ShardCoordinator();
+
+    ShardCoordinator(const ShardCoordinator&)            = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+
+    // Serves workers until every shard is done (true) or stop() (false).
+    // Idle workers are told there is nothing left before it returns.
+    bool run();
+
+    // Safe to call from any thread and from signal handlers.
+    void stop();
+
+    int shardCount() const      { return static_cast<int>(done_.size()); }
+    int completedShards() const { return completed_.load(); }      // including resumed ones
+    int resumedShards() const   { return resumed_; }
+
+private:
+    struct Connection {
+        int                         fd;
+        std::vector<std::uint8_t>   in;
+        int                         shard   = -1;   // assigned, not yet returned
+        bool                        idle    = false;
+    };
+
+    Config                                          config_;
+    std::string                                     runLine_;
+    int                                             listenFd_       = -1;
+    int                                             wakeRead_       = -1;
+    int                                             wakeWrite_      = -1;
+    int                                             checkpointFd_   = -1;
+    std::unique_ptr<ResultsWriter>                  results_;
+    std::atomic<bool>                               stopping_{false};
+
+    std::vector<std::uint8_t>                       done_;
+    std::vector<int>                                pending_;       // popped from the back
+    std::atomic<int>                                completed_{0};
+    int                                             resumed_        = 0;
+
+    std::unordered_map<std::uint64_t, Connection>   connections_;
+    std::uint64_t                                   nextConnection_ = 1;
+
+    void openCheckpoint();
+    void acceptWorkers();
+    bool readFrom(Connection& c);
+    bool handleFrame(Connection& c, const std::uint8_t* body, std::uint32_t size);
+    void commitShard(int shard, const std::uint8_t* records, std::uint32_t count);
+    bool assign(Connection& c, int shard);
+    void drop(std::uint64_t id);
+};
+
+// Connects to a coordinator and plays shards until it says there are none
+// left, goes away, or maxShards have been played (0 = no limit). Returns
+// the number of shards played. Throws std::runtime_error if it cannot
+// connect or gets a malformed frame.
+int runShardWorker(const std::string& socketPath, int maxShards = 0);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Cell.hpp"
+#include "Stats.hpp"
+
+#include <cstdint>
+
+// One solver step. The two rules act on every unrevealed, unflagged
+// neighbor of the constraint tile (x, y); the heavier tiers of
+// AnytimeSolver act on the single tile (x, y).
+struct SolverMove {
+    enum class Action : std::uint8_t { None, RevealNeighbors, FlagNeighbors, RevealTile, FlagTile };
+
+    Action  action  = Action::None;
+    int     x       = -1;
+    int     y       = -1;
+};
+
+// The move the two rules make at the tile (x, y), or Action::None if it is
+// not a revealed number where one of them fires:
+//      1)  flaggedNeighbours == adjacentMines and some neighbour is unknown
+//          -> reveal all unknown neighbours.
+//      2)  unknownNeighbours == adjacentMines - flaggedNeighbours > 0
+//          -> flag all unknown neighbours.
+// Grid is any board-like type with rows(), cols() and cellAt(x, y) returning
+// the packed cell byte (Board, BoardFork, BoardView).
+template<typename Grid>
+SolverMove solverMoveAt(const Grid& g, int x, int y) {
+    const int rows = g.rows();
+    const int cols = g.cols();
+    const std::uint8_t t = g.cellAt(x, y);
+    if ((t & (cell::REVEALED | cell::MINE)) != cell::REVEALED) return {};
+
+    // Counts flagged and unrevealed neighbors.
+    int flagCount = 0;
+    int unrevealedCount = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || nx >= cols || ny < 0 || ny >= rows) continue;
+
+            const std::uint8_t n = g.cellAt(nx, ny);
+            if (n & cell::FLAGGED) {
+                ++flagCount;
+            } else if (!(n & cell::REVEALED)) {
+                ++unrevealedCount;
+            }
+        }
+    }
+
+    // Rule 1
+    if (flagCount == cell::adjacent(t) && unrevealedCount > 0) return {SolverMove::Action::RevealNeighbors, x, y};
+
+    // Rule 2
+    const int minesLeft = cell::adjacent(t) - flagCount;
+    if (minesLeft > 0 && unrevealedCount == minesLeft) return {SolverMove::Action::FlagNeighbors, x, y};
+    return {};
+}
+
+// Finds the move Board::AISolver() would make, without changing anything:
+// scans row-major and stops at the first tile where solverMoveAt fires.
+// Board::AISolver() gets the same answer without rescanning from the top.
+template<typename Grid>
+SolverMove findSolverMove(const Grid& g) {
+    const int rows = g.rows();
+    const int cols = g.cols();
+    stats::add(stats::Counter::SolverCalls);
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const SolverMove move = solverMoveAt(g, x, y);
+            if (move.action == SolverMove::Action::None) continue;
+
+            stats::add(stats::Counter::SolverCellsScanned, y * cols + x + 1);
+            stats::add(move.action == SolverMove::Action::RevealNeighbors ? stats::Counter::Rule1Fires
+                                                                          : stats::Counter::Rule2Fires);
+            return move;
+        }
+    }
+    stats::add(stats::Counter::SolverCellsScanned, rows * cols);
+    return {};
+}
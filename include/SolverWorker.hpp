@@ -0,0 +1,67 @@
+#pragma once
+
+#include "AnytimeSolver.hpp"
+#include "BoardFork.hpp"
+#include "Solver.hpp"
+#include "SpscQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// Runs the solver on its own thread. The owner submits board snapshots
+// tagged with a generation number and later polls for results carrying the
+// same tag; any result whose generation no longer matches the live board is
+// stale and should be dropped. Both directions use lock-free SPSC queues, so
+// submit() and poll() never block; the mutex only parks the idle worker.
+//
+// Without a deadline a request runs the two rules only. With one it runs
+// AnytimeSolver, which answers by the deadline and may answer with a guess.
+//
+// submit() and poll() must be called from a single owner thread.
+class SolverWorker {
+public:
+    using Clock = AnytimeSolver::Clock;
+
+    struct Request {
+        BoardFork                           board;
+        std::uint64_t                       generation  = 0;
+        int                                 mines       = 0;
+        std::optional<Clock::time_point>    deadline;
+    };
+    struct Result {
+        SolverMove          move;
+        std::uint64_t       generation  = 0;
+        bool                proven      = true;     // false: a best guess
+        float               mineChance  = 0.f;      // of a guessed reveal
+        AnytimeMove::Tier   tier        = AnytimeMove::Tier::None;
+    };
+
+    SolverWorker();
+    ~SolverWorker();
+
+    SolverWorker(const SolverWorker&)            = delete;
+    SolverWorker& operator=(const SolverWorker&) = delete;
+
+    // Returns false if the request queue is full.
+    bool submit(BoardFork board, std::uint64_t generation);
+    bool submit(BoardFork board, std::uint64_t generation, int mines, Clock::time_point deadline);
+    bool poll(Result& out);
+
+private:
+    SpscQueue<Request>          requests_;
+    SpscQueue<Result>           results_;
+    std::atomic<bool>           stop_{false};
+    std::mutex                  wakeMutex_;
+    std::condition_variable     wake_;
+    AnytimeSolver               anytime_;       // worker thread only
+    std::vector<std::uint8_t>   cells_;         // worker thread only
+    std::thread                 thread_;        // last: starts in the constructor
+
+    bool push(Request request);
+    void run();
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+// Hot-path counters and timers for the rules, Board and the solver.
+//
+// Compiled in unless NDEBUG is defined (force either way with
+// -DMINESWEEPER_STATS=0/1) and off at runtime until setEnabled(true). Each
+// thread records into its own block of relaxed atomics, so recording never
+// locks or contends; snapshot() sums the live blocks and whatever exited
+// threads left behind. With stats compiled out every call is an empty
+// inline function.
+#ifndef MINESWEEPER_STATS
+#ifdef NDEBUG
+#define MINESWEEPER_STATS 0
+#else
+#define MINESWEEPER_STATS 1
+#endif
+#endif
+
+namespace stats {
+
+enum class Counter : int {
+    RevealCalls,
+    TilesOpened,
+    MaxFloodDepth,          // peak pending flood-fill stack; aggregated as a max
+    NeighborVisits,
+    SolverCalls,
+    SolverCellsScanned,
+    Rule1Fires,
+    Rule2Fires,
+    FirstClickRelocations,  // first clicks that had to move at least one mine
+    MinesRelocated,
+    AdjacencyCalls,
+    AdjacencyNanos,
+    Count
+};
+constexpr int NUM_COUNTERS = static_cast<int>(Counter::Count);
+
+const char* name(Counter c);        // snake_case, used as the export key
+bool        isMax(Counter c);       // aggregated with max instead of sum
+
+struct Snapshot {
+    std::array<std::uint64_t, NUM_COUNTERS> values{};
+
+    std::uint64_t operator[](Counter c) const { return values[static_cast<int>(c)]; }
+};
+
+// Totals across all threads. reset() zeroes them; counts recorded while it
+// runs may survive, so call it between workloads.
+Snapshot snapshot();
+void     reset();
+
+void writeJson(std::ostream& os, const Snapshot& s);
+void writeCsv (std::ostream& os, const Snapshot& s);
+
+#if MINESWEEPER_STATS
+
+namespace detail {
+extern std::atomic<bool> enabled;
+
+struct Block {
+    std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> v{};
+
+    Block();
+    ~Block();
+};
+Block& local();
+}  // namespace detail
+
+inline bool enabled()            { return detail::enabled.load(std::memory_order_relaxed); }
+inline void setEnabled(bool on)  { detail::enabled.store(on, std::memory_order_relaxed); }
+
+// Only the owning thread writes its block, so load + store is enough.
+inline void add(Counter c, std::uint64_t n = 1) {
+    if (!enabled()) return;
+    auto& slot = detail::local().v[static_cast<int>(c)];
+    slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void max(Counter c, std::uint64_t n) {
+    if (!enabled()) return;
+    auto& slot = detail::local().v[static_cast<int>(c)];
+    if (n > slot.load(std::memory_order_relaxed)) slot.store(n, std::memory_order_relaxed);
+}
+
+// Adds the nanoseconds between construction and destruction to a counter.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Counter c)
+    : counter_(c)
+    , on_(enabled()) {
+        if (on_) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (!on_) return;
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        add(counter_, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Counter                                 counter_;
+    bool                                    on_;
+    std::chrono::steady_clock::time_point   start_;
+};
+
+#else
+
+inline bool enabled()                          { return false; }
+inline void setEnabled(bool)                   {}
+inline void add(Counter, std::uint64_t = 1)    {}
+inline void max(Counter, std::uint64_t)        {}
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Counter) {}
+};
+
+#endif
+
+}  // namespace stats
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "BoardView.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A single player action chosen by a strategy.
+struct StrategyMove {
+    enum class Action : std::uint8_t { Reveal, Flag, Chord };
+
+    Action  action  = Action::Reveal;
+    int     x       = 0;
+    int     y       = 0;
+    bool    guess   = false;    // not proven safe by the visible board
+};
+
+// Pluggable solver interface. Given the visible board, a strategy appends
+// one or more moves to play in order; appending nothing means it is stuck.
+// Instances are used by one thread at a time, so they may keep state
+// between calls (caches, transposition tables, ...).
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    virtual const char* name() const = 0;
+
+    // Called before the first move of every game.
+    virtual void newGame(int /*rows*/, int /*cols*/, int /*mines*/) {}
+
+    virtual void nextMoves(const BoardView& view, std::vector<StrategyMove>& out) = 0;
+};
+
+// The original two-rule solver (Solver.hpp): plays every unknown neighbor
+// of the first constraint tile it finds as one batch.
+class TwoRuleStrategy : public Strategy {
+public:
+    const char* name() const override { return "two-rule"; }
+    void nextMoves(const BoardView& view, std::vector<StrategyMove>& out) override;
+};
+
+// Table-driven local deductions (PatternTable.hpp). One pass over the
+// board looks up every frontier tile's 3x3 window and its pairs with the
+// revealed tiles right of and below it, then plays everything forced at
+// once. The single-tile lookups cover the two-rule solver; the pair
+// lookups add the subset rules at the same per-tile cost.
+class PatternStrategy : public Strategy {
+public:
+    const char* name() const override { return "pattern-table"; }
+    void newGame(int rows, int cols, int mines) override;
+    void nextMoves(const BoardView& view, std::vector<StrategyMove>& out) override;
+
+private:
+    std::vector<std::uint8_t>   queued_;    // tiles already in out, per call
+
+    void emit(const BoardView& view, int x, int y, std::uint32_t entry,
+              const int* dx, const int* dy, int cells, bool transpose,
+              std::vector<StrategyMove>& out);
+};
+
+// Strategies known to the tournament runner. Factories rather than
+// instances, since every worker thread needs its own. A timed strategy
+// stops thinking at a wall-clock budget, so its games can differ between
+// runs on a loaded or different machine.
+struct StrategyInfo {
+    std::string                                 name;
+    std::function<std::unique_ptr<Strategy>()>  create;
+    bool                                        timed   = false;
+};
+
+// Built-in strategies first, then anything added with registerStrategy.
+std::vector<StrategyInfo>& strategyRegistry();
+void registerStrategy(StrategyInfo info);
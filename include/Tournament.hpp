@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Strategy.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class ResultsWriter;
+struct GameRecord;
+
+// Plays every strategy on the same seeded boards and compares them.
+//
+// Each (strategy, seed) game runs headlessly on the shared rules, with the
+// same layouts Board would produce for those seeds. The runner opens every
+// game with a reveal at the board center (first-click safe), then asks the
+// strategy for moves until the game is won, lost, or the strategy returns
+// no moves ("stuck"). Games are spread over worker threads; for untimed
+// strategies outcomes do not depend on the thread count, only the timings
+// do. A timed strategy (StrategyInfo::timed) gets less done per move when
+// threads contend, so its outcomes can shift with the thread count and the
+// machine's load. With a results writer, every game is also recorded there
+// (ResultsStore.hpp), in no fixed order.
+struct TournamentConfig {
+    int                         rows    = 16;
+    int                         cols    = 30;
+    int                         mines   = 99;
+    std::vector<std::uint32_t>  seeds;
+    int                         threads = 1;
+    ResultsWriter*              results = nullptr;
+};
+
+struct StrategyResult {
+    std::string     name;
+    int             games       = 0;
+    int             wins        = 0;
+    int             losses      = 0;
+    int             stuck       = 0;
+    std::uint64_t   calls       = 0;        // nextMoves invocations
+    std::uint64_t   moves       = 0;        // moves applied
+    double          usPerMove   = 0.0;      // total decision time / moves
+    double          p50CallUs   = 0.0;      // per-call decision latency
+    double          p99CallUs   = 0.0;
+    double          maxCallUs   = 0.0;
+
+    double winRate() const { return games ? static_cast<double>(wins) / games : 0.0; }
+};
+
+std::vector<StrategyResult> runTournament(const TournamentConfig& config,
+                                          const std::vector<StrategyInfo>& strategies);
+
+// Plays the one game runTournament plays for (strategy, seed); config.seeds,
+// threads and results are ignored. name is what the record's strategy says.
+GameRecord playTournamentGame(Strategy& strategy, const std::string& name,
+                              const TournamentConfig& config, std::uint32_t seed);
+
+// One CSV row per strategy, with a header
+void writeTournamentCsv(std::ostream& os, const std::vector<StrategyResult>& results);
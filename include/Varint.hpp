@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LEB128 varint and zigzag helpers shared by the binary file formats.
+
+constexpr std::size_t MAX_VARINT_BYTES = 10;
+
+// Encodes value at out, which must have room for MAX_VARINT_BYTES. Returns
+// the number of bytes written.
+inline std::size_t encodeVarint(std::uint8_t* out, std::uint64_t value) {
+    std::size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<std::uint8_t>(value);
+    return n;
+}
+
+// Decodes one varint from [p, end), advancing p. Returns false if the input
+// ends mid-varint or the varint is longer than 64 bits.
+inline bool decodeVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 64 && p != end; shift += 7) {
+        const std::uint8_t byte = *p++;
+        out |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+inline std::uint64_t zigzag(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
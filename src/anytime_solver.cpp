@@ -0,0 +1,155 @@
+#include "AnytimeSolver.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+
+AnytimeMove AnytimeSolver::solve(const BoardView& view, int mines, Clock::time_point deadline) {
+    AnytimeMove best;
+
+    // Tier 1
+    best.move = findSolverMove(view);
+    if (best.move.action != SolverMove::Action::None) {
+        best.tier   = AnytimeMove::Tier::TwoRule;
+        best.proven = true;
+        return best;
+    }
+    if (Clock::now() >= deadline) return localEstimate(view, mines);
+
+    // Tier 2: safe tiles first, then mines
+    moves_.clear();
+    pattern_.nextMoves(view, moves_);
+    if (!moves_.empty()) {
+        auto it = std::find_if(moves_.begin(), moves_.end(), [](const StrategyMove& m) {
+            return m.action == StrategyMove::Action::Reveal;
+        });
+        if (it == moves_.end()) it = moves_.begin();
+
+        best.move   = {it->action == StrategyMove::Action::Reveal ? SolverMove::Action::RevealTile
+                                                                  : SolverMove::Action::FlagTile,
+                       it->x, it->y};
+        best.tier   = AnytimeMove::Tier::Pattern;
+        best.proven = true;
+        return best;
+    }
+    if (Clock::now() >= deadline) return localEstimate(view, mines);
+
+    // Tier 3: certainties the global mine count adds, else the safest guess
+    if (!probability_.compute(view, mines, probabilities_, deadline)) return localEstimate(view, mines);
+
+    const int cols = view.cols();
+    int   safest = -1;
+    int   mine   = -1;
+    for (int i = 0; i < static_cast<int>(probabilities_.size()); ++i) {
+        const float p = probabilities_[i];
+        if (p < 0.f) continue;
+        if (p == 1.f) {
+            if (mine < 0) mine = i;
+        } else if (safest < 0 || p < probabilities_[safest]) {
+            safest = i;
+        }
+    }
+    if (safest < 0 && mine < 0) return localEstimate(view, mines);
+
+    best.tier = AnytimeMove::Tier::Probability;
+    if (safest >= 0 && (probabilities_[safest] == 0.f || mine < 0)) {
+        best.move       = {SolverMove::Action::RevealTile, safest % cols, safest / cols};
+        best.proven     = probabilities_[safest] == 0.f;
+        best.mineChance = probabilities_[safest];
+
+        // A guess: look ahead for one that leaves less to chance later
+        if (!best.proven && Clock::now() < deadline) {
+            const GuessSearch::Choice choice = guess_.choose(view, mines, probabilities_, deadline);
+            if (choice.tile >= 0 && choice.tile != safest) {
+                best.move       = {SolverMove::Action::RevealTile, choice.tile % cols, choice.tile / cols};
+                best.tier       = AnytimeMove::Tier::Lookahead;
+                best.mineChance = choice.mineChance;
+            }
+        }
+    } else {
+        best.move       = {SolverMove::Action::FlagTile, mine % cols, mine / cols};
+        best.proven     = true;
+        best.mineChance = 1.f;
+    }
+    return best;
+}
+
+// Guess from local information only: a tile's estimate is the worst
+// remaining/hidden ratio among its revealed neighbors, or the global
+// density for tiles with none. Never proven.
+AnytimeMove AnytimeSolver::localEstimate(const BoardView& view, int mines) const {
+    const int rows = view.rows();
+    const int cols = view.cols();
+
+    int hidden = 0;
+    int flags  = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const std::uint8_t t = view.cellAt(x, y);
+            if (t & cell::FLAGGED) ++flags;
+            else if (!(t & cell::REVEALED)) ++hidden;
+        }
+    }
+
+    AnytimeMove best;
+    if (hidden == 0) return best;
+
+    const float density = std::clamp(static_cast<float>(mines - flags) / hidden, 0.f, 1.f);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            if (view.cellAt(x, y) & (cell::REVEALED | cell::FLAGGED)) continue;
+
+            float estimate = -1.f;
+            rules::forEachNeighbor(view, x, y, [&](int nx, int ny) {
+                const std::uint8_t n = view.cellAt(nx, ny);
+                if (!(n & cell::REVEALED)) return;
+
+                int unknown = 0;
+                int flagged = 0;
+                rules::forEachNeighbor(view, nx, ny, [&](int ux, int uy) {
+                    const std::uint8_t u = view.cellAt(ux, uy);
+                    if (u & cell::FLAGGED) ++flagged;
+                    else if (!(u & cell::REVEALED)) ++unknown;
+                });
+                const float ratio = static_cast<float>(cell::adjacent(n) - flagged) / unknown;
+                estimate = std::max(estimate, std::clamp(ratio, 0.f, 1.f));
+            });
+            if (estimate < 0.f) estimate = density;
+
+            if (best.tier == AnytimeMove::Tier::None || estimate < best.mineChance) {
+                best.move       = {SolverMove::Action::RevealTile, x, y};
+                best.tier       = AnytimeMove::Tier::LocalEstimate;
+                best.mineChance = estimate;
+            }
+        }
+    }
+    return best;
+}
+
+void AnytimeStrategy::newGame(int /*rows*/, int /*cols*/, int mines) {
+    mines_ = mines;
+}
+
+void AnytimeStrategy::nextMoves(const BoardView& view, std::vector<StrategyMove>& out) {
+    const AnytimeMove best = solver_.solve(view, mines_, AnytimeSolver::Clock::now() + budget_);
+    const SolverMove& m    = best.move;
+    switch (m.action) {
+        case SolverMove::Action::None:
+            break;
+        case SolverMove::Action::RevealTile:
+            out.push_back({StrategyMove::Action::Reveal, m.x, m.y, !best.proven});
+            break;
+        case SolverMove::Action::FlagTile:
+            out.push_back({StrategyMove::Action::Flag, m.x, m.y});
+            break;
+        case SolverMove::Action::RevealNeighbors:
+        case SolverMove::Action::FlagNeighbors: {
+            const StrategyMove::Action action = m.action == SolverMove::Action::RevealNeighbors
+                ? StrategyMove::Action::Reveal
+                : StrategyMove::Action::Flag;
+            rules::forEachNeighbor(view, m.x, m.y, [&](int nx, int ny) {
+                if (!(view.cellAt(nx, ny) & (cell::REVEALED | cell::FLAGGED))) out.push_back({action, nx, ny});
+            });
+            break;
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#include "BatchEnv.hpp"
+#include "Cell.hpp"
+#include "Rules.hpp"
+
+#include <stdexcept>
+
+// Grid adapter handing the shared rules (Rules.hpp) one env's cells.
+struct BatchEnv::EnvGrid {
+    std::uint8_t*   c;
+    int             r;
+    int             w;
+
+    int          rows() const                  { return r; }
+    int          cols() const                  { return w; }
+    std::uint8_t get(int i) const              { return c[i]; }
+    void         set(int i, std::uint8_t v)    { c[i] = v; }
+};
+
+BatchEnv::BatchEnv(const Config& config)
+: config_(config)
+, cellsPerEnv_(config.rows * config.cols) {
+    if (config_.rows < 1 || config_.cols < 1 || config_.numEnvs < 1
+        || config_.mines < 0 || config_.mines > cellsPerEnv_ - 9) {
+        throw std::invalid_argument("BatchEnv config error");
+    }
+    if (config_.threads < 1)                 config_.threads = 1;
+    if (config_.threads > config_.numEnvs)   config_.threads = config_.numEnvs;
+
+    cells_.resize(static_cast<std::size_t>(config_.numEnvs) * cellsPerEnv_);
+    envs_.resize(config_.numEnvs);
+    scratch_.resize(config_.threads);
+    for (auto& s : scratch_) s.reserve(cellsPerEnv_);
+
+    for (int t = 1; t < config_.threads; ++t) {
+        workers_.emplace_back(&BatchEnv::workerLoop, this, t);
+    }
+}
+
+BatchEnv::~BatchEnv() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        stopping_ = true;
+    }
+    jobReady_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+void BatchEnv::reset(std::uint8_t* observations) {
+    jobActions_ = nullptr;
+    jobObs_     = observations;
+    jobRewards_ = nullptr;
+    jobDones_   = nullptr;
+    runJob();
+}
+
+void BatchEnv::step(const std::int32_t* actions, std::uint8_t* observations,
+                    float* rewards, std::uint8_t* dones) {
+    jobActions_ = actions;
+    jobObs_     = observations;
+    jobRewards_ = rewards;
+    jobDones_   = dones;
+    runJob();
+}
+
+// Runs the current job over every slice and returns once all are done
+void BatchEnv::runJob() {
+    if (workers_.empty()) {
+        runSlice(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        pending_ = static_cast<int>(workers_.size());
+        ++jobGeneration_;
+    }
+    jobReady_.notify_all();
+
+    runSlice(0);
+
+    std::unique_lock<std::mutex> lock(poolMutex_);
+    jobDone_.wait(lock, [&] { return pending_ == 0; });
+}
+
+void BatchEnv::workerLoop(int slice) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex_);
+            jobReady_.wait(lock, [&] { return stopping_ || jobGeneration_ != seen; });
+            if (stopping_) return;
+            seen = jobGeneration_;
+        }
+
+        runSlice(slice);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex_);
+            last = --pending_ == 0;
+        }
+        if (last) jobDone_.notify_one();
+    }
+}
+
+void BatchEnv::runSlice(int slice) {
+    const int N     = config_.numEnvs;
+    const int T     = config_.threads;
+    const int begin = static_cast<int>(static_cast<long long>(N) * slice / T);
+    const int end   = static_cast<int>(static_cast<long long>(N) * (slice + 1) / T);
+    std::vector<int>& scratch = scratch_[slice];
+
+    for (int e = begin; e < end; ++e) {
+        if (jobActions_) {
+            stepEnv(e, jobActions_[e], scratch, jobRewards_[e], jobDones_[e]);
+        } else {
+            resetEnv(e, scratch);
+        }
+        writeObservation(e, jobObs_);
+    }
+}
+
+// Starts env's next episode with the next seed in its sequence
+void BatchEnv::resetEnv(int env, std::vector<int>& scratch) {
+    EnvState& s = envs_[env];
+    s.seed = config_.seed + static_cast<std::uint32_t>(env)
+           + s.episode * static_cast<std::uint32_t>(config_.numEnvs);
+    ++s.episode;
+    s.rng.seed(s.seed);
+    s.firstClick = true;
+    s.safeHidden = cellsPerEnv_ - config_.mines;
+
+    EnvGrid grid{cells_.data() + static_cast<std::size_t>(env) * cellsPerEnv_,
+                 config_.rows, config_.cols};
+    rules::placeMines(grid, config_.mines, s.rng, scratch);
+}
+
+void BatchEnv::stepEnv(int env, std::int32_t action, std::vector<int>& scratch,
+                       float& reward, std::uint8_t& done) {
+    reward = 0.f;
+    done   = 0;
+    if (action < 0 || action >= actionCount()) return;
+
+    EnvState& s = envs_[env];
+    EnvGrid grid{cells_.data() + static_cast<std::size_t>(env) * cellsPerEnv_,
+                 config_.rows, config_.cols};
+    const int kind = action / cellsPerEnv_;
+    const int x    = (action % cellsPerEnv_) % config_.cols;
+    const int y    = (action % cellsPerEnv_) / config_.cols;
+
+    rules::RevealResult r;
+    switch (kind) {
+        case REVEAL:
+            if (s.firstClick) {
+                s.firstClick = false;
+                s.safeHidden += rules::relocateFromSafeArea(grid, x, y, s.rng, scratch);
+            }
+            r = rules::reveal(grid, x, y, scratch);
+            break;
+        case FLAG:
+            rules::toggleFlag(grid, x, y);
+            break;
+        case CHORD:
+            r = rules::chord(grid, x, y, scratch);
+            break;
+        default:
+            break;
+    }
+
+    s.safeHidden -= r.opened;
+    const int safeTotal = cellsPerEnv_ - config_.mines;
+    reward = r.hit ? -1.f : safeTotal > 0 ? static_cast<float>(r.opened) / safeTotal : 0.f;
+
+    if (r.hit || s.safeHidden == 0) {
+        done = 1;
+        resetEnv(env, scratch);
+    }
+}
+
+void BatchEnv::writeObservation(int env, std::uint8_t* observations) const {
+    const std::uint8_t* c   = cells_.data() + static_cast<std::size_t>(env) * cellsPerEnv_;
+    std::uint8_t* revealed  = observations + static_cast<std::size_t>(env) * OBS_PLANES * cellsPerEnv_;
+    std::uint8_t* flagged   = revealed + cellsPerEnv_;
+    std::uint8_t* numbers   = flagged  + cellsPerEnv_;
+
+    for (int i = 0; i < cellsPerEnv_; ++i) {
+        const bool open = c[i] & cell::REVEALED;
+        revealed[i] = open;
+        flagged[i]  = (c[i] & cell::FLAGGED) != 0;
+        numbers[i]  = open ? static_cast<std::uint8_t>(cell::adjacent(c[i])) : 0;
+    }
+}
+
+int BatchEnv::numEnvs() const {
+    return config_.numEnvs;
+}
+
+int BatchEnv::cellsPerEnv() const {
+    return cellsPerEnv_;
+}
+
+int BatchEnv::actionCount() const {
+    return NUM_ACTION_KINDS * cellsPerEnv_;
+}
+
+std::size_t BatchEnv::observationSize() const {
+    return static_cast<std::size_t>(config_.numEnvs) * OBS_PLANES * cellsPerEnv_;
+}
+
+std::int32_t BatchEnv::encodeAction(ActionKind kind, int x, int y) const {
+    return kind * cellsPerEnv_ + y * config_.cols + x;
+}
+
+std::uint32_t BatchEnv::episodeSeed(int env) const {
+    return envs_[env].seed;
+}
+
+const std::uint8_t* BatchEnv::cells(int env) const {
+    return cells_.data() + static_cast<std::size_t>(env) * cellsPerEnv_;
+}
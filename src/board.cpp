@@ -1,27 +1,26 @@
 #include "Board.hpp"
+#include "BoardFork.hpp"
+#include "Resources.hpp"
+#include "Rules.hpp"
+
+#include <functional>
+
+// Grid adapter handing the shared rules (Rules.hpp) access to the cells.
+// Every write goes through setCell so moves are journaled.
+struct Board::CellAccess {
+    Board& b;
+
+    int          rows() const                  { return b.rows_; }
+    int          cols() const                  { return b.cols_; }
+    std::uint8_t get(int i) const              { return b.cells_[i]; }
+    void         set(int i, std::uint8_t v)    { b.setCell(i, v); }
+};
 
 Board::Board(int rows, int cols, float tileSize, int numMines,
              std::optional<std::uint32_t> seed)
 : rows_(rows), cols_(cols), tileSize_(tileSize),
   rng_(seed.value_or(std::random_device{}())) {
 
-    // Load font for numbers, flags, mine, etc.
-    if (!font_.loadFromFile("assets/mine-sweeper.ttf")) {
-        throw std::runtime_error("Font error");
-    }
-
-    tiles.resize(rows_*cols_);
-
-    // Initialize tile shapes and positions
-    for (int y = 0; y < rows_; ++y) {
-        for (int x = 0; x < cols_; ++x) {
-            Tile& t = tiles[index(x,y)];
-
-            t.shape.setSize({tileSize-1, tileSize-1});
-            t.shape.setPosition(x * tileSize, y * tileSize);
-        }
-    }
-
     // Populate the board with mines and adjacent mine counts
     reset(rows_, cols_, numMines);
 }
@@ -34,30 +33,18 @@ void Board::reset(int rows, int cols, int numMines,
     firstClick_ = true;
     rows_ = rows;
     cols_ = cols;
-    tiles.resize(rows_ * cols_);
-
-    // Clear all tiles
-    for (auto& t : tiles) {
-        t.revealed = false;
-        t.flagged = false;
-        t.mine = false;
-        t.adjacentMines = 0;
-    }
+    cells_.assign(rows_ * cols_, 0);
 
-    // Randomly place mines
-    std::vector<int> minePositions(rows_ * cols_);
-    std::iota(minePositions.begin(), minePositions.end(), 0);
-    std::shuffle(minePositions.begin(), minePositions.end(), rng_);
-    for (int i = 0; i < numMines; ++i) {
-        tiles[minePositions[i]].mine = true;
-    }
-
-    // Compute number of adjacent mines for each tile
-    computeAdjacentMines();
+    // Randomly place mines and compute adjacent mine counts
+    CellAccess access{*this};
+    rules::placeMines(access, numMines, rng_, scratch_);
 
     // Reset highlight state
     highlightX_ = -1;
     highlightY_ = -1;
+
+    recount();
+    clearHistory();
 }
 
 void Board::draw(sf::RenderWindow& window) {
@@ -75,205 +62,129 @@ void Board::draw(sf::RenderWindow& window) {
     };
 
     sf::Text text;
-    text.setFont(font_);
+    text.setFont(resources::font());
     text.setCharacterSize(tileSize_ / 2);
 
-    for (auto& t : tiles) {
-        if (!t.revealed) {      // Unrevealed tile
-            t.shape.setFillColor(sf::Color(76,84,92));
-        } else if (t.mine) {    // Revealed mine
-            t.shape.setFillColor(sf::Color(238,102,102));
-        } else {                // Revealed non-mine tile
-            t.shape.setFillColor(sf::Color(51,58,65));
-        }
-        window.draw(t.shape);
-
-        sf::Vector2f tilePos = t.shape.getPosition();
-        float cx = tilePos.x + tileSize_ / 2;
-        float cy = tilePos.y + tileSize_ / 2;
-
-        // Flagged tile
-        if (!t.revealed && t.flagged) {
-                text.setString("`");
-                auto bounds = text.getLocalBounds();
-                text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
-                text.setPosition(cx, cy);
-                text.setFillColor(sf::Color(238,102,102));
-                window.draw(text);
-        }
+    sf::RectangleShape shape({tileSize_ - 1, tileSize_ - 1});
 
-        if (t.revealed) {
-            // Mine tile
-            if (t.mine) {
-                text.setString("*");
-                auto bounds = text.getLocalBounds();
-                text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
-                text.setPosition(cx, cy);
-                text.setFillColor(sf::Color::Black);
-                window.draw(text);
-            // Number tile
-            } else if (t.adjacentMines > 0) {
-                text.setString(std::to_string(t.adjacentMines));
-                auto bounds = text.getLocalBounds();
-                text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
-                text.setPosition(cx, cy);
-                text.setFillColor(numberColors[t.adjacentMines]);
-                window.draw(text);
+    for (int y = 0; y < rows_; ++y) {
+        for (int x = 0; x < cols_; ++x) {
+            const std::uint8_t c = cells_[index(x, y)];
+            const bool revealed  = c & cell::REVEALED;
+            const bool mine      = c & cell::MINE;
+
+            if (!revealed) {        // Unrevealed tile
+                shape.setFillColor(sf::Color(76,84,92));
+            } else if (mine) {      // Revealed mine
+                shape.setFillColor(sf::Color(238,102,102));
+            } else {                // Revealed non-mine tile
+                shape.setFillColor(sf::Color(51,58,65));
+            }
+            shape.setPosition(x * tileSize_, y * tileSize_);
+            window.draw(shape);
+
+            float cx = x * tileSize_ + tileSize_ / 2;
+            float cy = y * tileSize_ + tileSize_ / 2;
+
+            // Flagged tile
+            if (!revealed && (c & cell::FLAGGED)) {
+                    text.setString("`");
+                    auto bounds = text.getLocalBounds();
+                    text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
+                    text.setPosition(cx, cy);
+                    text.setFillColor(sf::Color(238,102,102));
+                    window.draw(text);
+            }
+
+            if (revealed) {
+                // Mine tile
+                if (mine) {
+                    text.setString("*");
+                    auto bounds = text.getLocalBounds();
+                    text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
+                    text.setPosition(cx, cy);
+                    text.setFillColor(sf::Color::Black);
+                    window.draw(text);
+                // Number tile
+                } else if (cell::adjacent(c) > 0) {
+                    text.setString(std::to_string(cell::adjacent(c)));
+                    auto bounds = text.getLocalBounds();
+                    text.setOrigin(bounds.width / 2 + bounds.left, bounds.height / 2 + bounds.top);
+                    text.setPosition(cx, cy);
+                    text.setFillColor(numberColors[cell::adjacent(c)]);
+                    window.draw(text);
+                }
             }
         }
     }
 }
 
-
-bool Board::reveal(int x, int y) {
+bool Board::reveal(int x, int y, std::vector<CellChange>* changes) {
     if (!inBounds(x,y)) return false;
 
+    CellAccess access{*this};
+    beginMove(changes);
+
     // "First click safe" rule: guarantee atleast 3x3 area around the first click is safe
     if (firstClick_) {
         firstClick_ = false;
-
-        // Build a set of safe tiles around the first click (3x3 including center)
-        std::unordered_set<int> safeTiles;
-        safeTiles.insert(index(x, y));
-        forEachNeighbor(x, y, [&](int nx, int ny, const Tile&) {
-            safeTiles.insert(index(nx, ny));
-        });
-
-        // Gather the mines in the safe area
-        std::vector<int> toMove;
-        for (int safeTile : safeTiles) {
-            if (tiles[safeTile].mine) {
-                toMove.push_back(safeTile);
-                tiles[safeTile].mine = false;
-            }
-        }
-
-        // Find new tiles for mines in the safe area
-        std::vector<int> pool;
-        pool.reserve(rows_ * cols_);
-        for (int i = 0, N = rows_*cols_; i < N; ++i) {
-            if (!tiles[i].mine && safeTiles.count(i) == 0) {
-                pool.push_back(i);
-            }
-        }
-        std::shuffle(pool.begin(), pool.end(), rng_);
-
-        for (int i = 0; i < (int)toMove.size(); ++i) {
-            tiles[pool[i]].mine = true;
-        }
-
-        // Recompute adjacent mines after moving mines that were in the safe area
-        computeAdjacentMines();
+        rules::relocateFromSafeArea(access, x, y, rng_, scratch_);
     }
 
-    Tile& t = tiles[index(x,y)];
-    
-    if (t.revealed || t.flagged) return false;
-
-    t.revealed = true;
-    if (t.mine) {
-        return true;
-    }
-    
-    // Flood fill/reveal adjacent tiles if this tile has no adjacent mines.
-    if (!t.mine && t.adjacentMines == 0) {
-        forEachNeighbor(x, y, [&](int nx, int ny, Tile&) {
-            reveal(nx, ny);
-        });
-    }
-
-    return false;
+    const bool hit = rules::reveal(access, x, y, scratch_).hit;
+    endMove();
+    return hit;
 }
 
 // Toggles flag on a tile
-void Board::flag(int x, int y) {
+void Board::flag(int x, int y, std::vector<CellChange>* changes) {
     if (!inBounds(x,y)) return;
 
-    Tile& t = tiles[index(x,y)];
-
     // Toggle flag only if the tile is not revealed.
-    if (!t.revealed)
-        t.flagged = !t.flagged;
+    CellAccess access{*this};
+    beginMove(changes);
+    rules::toggleFlag(access, x, y);
+    endMove();
 }
 
 // Win condition: all non-mine tiles are revealed.
 bool Board::isCleared() const {
-    for (const auto& t : tiles) {
-        if (!t.revealed && !t.mine) {
-            return false;
-        }
-    }
-    return true;
+    return hiddenSafe_ == 0;
 }
 
 // Chord: clicking on a revealed tile reveals all adjacent unrevealed tiles
 //        that are not flagged. Only allowed if
 //        number of adjacent flagged tiles == number of adjacent mines
-bool Board::chord(int x, int y) {
+bool Board::chord(int x, int y, std::vector<CellChange>* changes) {
     if (!inBounds(x, y)) return false;
 
-    const Tile& t = tiles[index(x, y)];
-    if (!t.revealed || t.flagged) return false;
-
-    // Count number of flagged neighbors
-    int flags = 0;
-    forEachNeighbor(x, y, [&](int, int, const Tile& n) {
-        if (n.flagged) ++flags;
-    });
-
-    if (flags != t.adjacentMines) return false;
-
-    // Number of adjacent flagged tiles == number of adjacent mines, proceed.
-    bool hit = false;
-    forEachNeighbor(x, y, [&](int nx, int ny, Tile& n) {
-        if (n.flagged) return;
-
-        if (n.mine) {
-            n.revealed = true;
-            hit = true;
-        } else {
-            reveal(nx, ny);
-        }
-    });
+    CellAccess access{*this};
+    beginMove(changes);
+    const bool hit = rules::chord(access, x, y, scratch_).hit;
+    endMove();
 
     return hit;
 }
 
 // Returns true if the tile at (x,y) is revealed
 bool Board::isRevealed(int x, int y) const {
-    return inBounds(x,y) && tiles[index(x,y)].revealed;
+    return inBounds(x,y) && (cells_[index(x,y)] & cell::REVEALED);
 }
 
 // Returns the number of adjacent mines for the tile at (x,y)
 int Board::getAdjacentMines(int x, int y) const {
-    return inBounds(x,y) ? tiles[index(x,y)].adjacentMines : 0;
+    return inBounds(x,y) ? cell::adjacent(cells_[index(x,y)]) : 0;
 }
 
 // Returns the number of flagged tiles
 int Board::flagCount() const {
-    int count = 0;
-    for (const auto& t : tiles) {
-        if (t.flagged) {
-            ++count;
-        }
-    }
-    return count;
+    return flags_;
 }
 
 // Computes the number of adjacent mines for each tile
 void Board::computeAdjacentMines() {
-    for (int y = 0; y < rows_; ++y) {
-        for (int x = 0; x < cols_; ++x) {
-            Tile& t = tiles[index(x, y)];
-            t.adjacentMines = 0;
-
-            if (t.mine) continue;
-
-            forEachNeighbor(x, y, [&](int, int, const Tile& n) {
-                if (n.mine) ++t.adjacentMines;
-            });
-        }
-    }
+    CellAccess access{*this};
+    rules::computeAdjacency(access);
 }
 
 // Attempts to solve the board using 2 simple rules:
@@ -283,49 +194,113 @@ void Board::computeAdjacentMines() {
 //      2)  For any revealed tile where
 //          unrevealedNeighbours == adjacentMines - flaggedNeighbours,
 //          flag all adjacent unrevealed tiles.
-bool Board::AISolver() {
-    for (int y = 0; y < rows_; ++y) {
-        for (int x = 0; x < cols_; ++x) {
-            const Tile& t = tiles[index(x, y)];
-            if (!t.revealed || t.mine) continue;
-
-            highlightX_ = x;
-            highlightY_ = y;
-
-            // Counts flagged and unrevealed neighbors.
-            int flagCount = 0;
-            int unrevealedCount = 0;
-            forEachNeighbor(x, y, [&](int, int, const Tile& n) {
-                if (n.flagged) {
-                    ++flagCount;
-                } else if (!n.revealed) {
-                    ++unrevealedCount;
-                }
-            });
-
-            // Rule 1
-            if (flagCount == t.adjacentMines && unrevealedCount > 0) {
-                forEachNeighbor(x, y, [&](int nx, int ny, Tile& n) {
-                    if (!n.revealed && !n.flagged) reveal(nx, ny);
-                });
-                return true;
-            }
+bool Board::AISolver(std::vector<CellChange>* changes) {
+    return applySolverMove(nextSolverMove(), changes);
+}
+
+// Returns the move findSolverMove(*this) would. A tile can only start to
+// fire when it or a neighbor changes, so every firing tile is dirty or at
+// or past the cursor; taking dirty tiles (all below the cursor) lowest
+// first and then sweeping on finds the lowest one, as a full scan would.
+SolverMove Board::nextSolverMove() {
+    const int N = static_cast<int>(cells_.size());
+    stats::add(stats::Counter::SolverCalls);
+
+    if (!solverLive_) {
+        solverLive_   = true;
+        solverCursor_ = 0;
+        solverDirty_.clear();
+        solverQueued_.assign(N, 0);
+        solverTouched_.clear();
+    }
 
-            // Rule 2
-            int minesLeft = t.adjacentMines - flagCount;
-            if (minesLeft > 0 && unrevealedCount == minesLeft) {
-                forEachNeighbor(x, y, [&](int, int, Tile& n) {
-                    if (!n.revealed && !n.flagged) n.flagged = true;
-                });
-                return true;
+    for (int i : solverTouched_) {
+        const int x = i % cols_;
+        const int y = i / cols_;
+        for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, rows_ - 1); ++ny) {
+            for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, cols_ - 1); ++nx) {
+                const int n = index(nx, ny);
+                if (n >= solverCursor_ || solverQueued_[n]) continue;
+                solverQueued_[n] = 1;
+                solverDirty_.push_back(n);
+                std::push_heap(solverDirty_.begin(), solverDirty_.end(), std::greater<int>());
             }
         }
     }
+    solverTouched_.clear();
+
+    int        scanned = 0;
+    SolverMove move;
+    while (move.action == SolverMove::Action::None) {
+        int i;
+        if (!solverDirty_.empty()) {
+            std::pop_heap(solverDirty_.begin(), solverDirty_.end(), std::greater<int>());
+            i = solverDirty_.back();
+            solverDirty_.pop_back();
+            solverQueued_[i] = 0;
+        } else if (solverCursor_ < N) {
+            i = solverCursor_++;
+        } else {
+            break;
+        }
+        ++scanned;
+        move = solverMoveAt(*this, i % cols_, i / cols_);
+    }
 
-    // Reset highlight state if no moves were made
-    highlightX_ = -1;
-    highlightY_ = -1;
-    return false;
+    stats::add(stats::Counter::SolverCellsScanned, scanned);
+    if (move.action == SolverMove::Action::RevealNeighbors) stats::add(stats::Counter::Rule1Fires);
+    if (move.action == SolverMove::Action::FlagNeighbors)   stats::add(stats::Counter::Rule2Fires);
+    return move;
+}
+
+int Board::runAISolver(std::chrono::steady_clock::time_point deadline,
+                       std::vector<CellChange>* changes) {
+    int steps = 0;
+    while (AISolver(changes)) {
+        ++steps;
+        if (isCleared() || std::chrono::steady_clock::now() >= deadline) break;
+    }
+    return steps;
+}
+
+// Applies a solver move as one journaled step and moves the highlight to
+// its tile. Returns false for Action::None. A RevealTile guess can hit a
+// mine; check hasMineAt afterwards.
+bool Board::applySolverMove(const SolverMove& move, std::vector<CellChange>* changes) {
+    if (move.action == SolverMove::Action::None || !inBounds(move.x, move.y)) {
+        // Reset highlight state if no moves were made
+        highlightX_ = -1;
+        highlightY_ = -1;
+        return false;
+    }
+
+    highlightX_ = move.x;
+    highlightY_ = move.y;
+
+    // Single-tile moves go through the player paths, first click included
+    if (move.action == SolverMove::Action::RevealTile) {
+        reveal(move.x, move.y, changes);
+        return true;
+    }
+    if (move.action == SolverMove::Action::FlagTile) {
+        if (!isFlaggedAt(move.x, move.y)) flag(move.x, move.y, changes);
+        return true;
+    }
+
+    CellAccess access{*this};
+    beginMove(changes);
+    rules::forEachNeighbor(access, move.x, move.y, [&](int nx, int ny) {
+        const std::uint8_t n = cells_[index(nx, ny)];
+        if (n & (cell::REVEALED | cell::FLAGGED)) return;
+
+        if (move.action == SolverMove::Action::RevealNeighbors) {
+            rules::reveal(access, nx, ny, scratch_);
+        } else {
+            setCell(index(nx, ny), n | cell::FLAGGED);
+        }
+    });
+    endMove();
+    return true;
 }
 
 // Returns the index of the tile at (x,y)
@@ -338,6 +313,23 @@ bool Board::inBounds(int x, int y) const {
     return x >= 0 && x < cols_ && y >= 0 && y < rows_;
 }
 
+int Board::rows() const {
+    return rows_;
+}
+
+int Board::cols() const {
+    return cols_;
+}
+
+// Returns the packed cell byte at (x,y), or 0 out of bounds
+std::uint8_t Board::cellAt(int x, int y) const {
+    return inBounds(x, y) ? cells_[index(x, y)] : 0;
+}
+
+BoardView Board::view() const {
+    return {rows_, cols_, cells_.data()};
+}
+
 // Returns the x-coordinate of the highlighted tile
 int Board::getHighlightX() const {
     return highlightX_;
@@ -351,18 +343,13 @@ int Board::getHighlightY() const {
 // Test / puzzle setup: replace the current mine layout with mines at the
 // given linear indices. Clears revealed/flagged state and recomputes adjacency.
 void Board::placeMinesAt(const std::vector<int>& indices, bool consumeFirstClick) {
-    const int N = static_cast<int>(tiles.size());
+    const int N = static_cast<int>(cells_.size());
 
-    for (auto& t : tiles) {
-        t.revealed      = false;
-        t.flagged       = false;
-        t.mine          = false;
-        t.adjacentMines = 0;
-    }
+    cells_.assign(N, 0);
 
     for (int idx : indices) {
         if (idx >= 0 && idx < N) {
-            tiles[idx].mine = true;
+            cells_[idx] |= cell::MINE;
         }
     }
 
@@ -371,20 +358,148 @@ void Board::placeMinesAt(const std::vector<int>& indices, bool consumeFirstClick
     highlightY_  = -1;
 
     computeAdjacentMines();
+    recount();
+    clearHistory();
 }
 
 int Board::mineCount() const {
     int count = 0;
-    for (const auto& t : tiles) {
-        if (t.mine) ++count;
+    for (std::uint8_t t : cells_) {
+        if (t & cell::MINE) ++count;
     }
     return count;
 }
 
 bool Board::hasMineAt(int x, int y) const {
-    return inBounds(x, y) && tiles[index(x, y)].mine;
+    return inBounds(x, y) && (cells_[index(x, y)] & cell::MINE);
 }
 
 bool Board::isFlaggedAt(int x, int y) const {
-    return inBounds(x, y) && tiles[index(x, y)].flagged;
-}
\ No newline at end of file
+    return inBounds(x, y) && (cells_[index(x, y)] & cell::FLAGGED);
+}
+BoardFork Board::fork() const {
+    return BoardFork(rows_, cols_, cells_.data());
+}
+
+// =============================================================================
+// Undo / redo journal
+// =============================================================================
+
+// Undoes the most recent move by restoring the recorded bytes in reverse
+bool Board::undo(std::vector<CellChange>* changes) {
+    if (appliedMoves_ == 0) return false;
+
+    const std::size_t m     = --appliedMoves_;
+    const std::size_t begin = moves_[m].begin;
+    const std::size_t end   = m + 1 < moves_.size() ? moves_[m + 1].begin : deltas_.size();
+    for (std::size_t d = end; d-- > begin; ) {
+        const CellChange& delta = deltas_[d];
+        writeCell(delta.index, delta.before);
+        if (changes) changes->push_back({delta.index, delta.after, delta.before});
+    }
+    firstClick_ = moves_[m].firstClickBefore;
+    highlightX_ = -1;
+    highlightY_ = -1;
+    return true;
+}
+
+// Re-applies the most recently undone move
+bool Board::redo(std::vector<CellChange>* changes) {
+    if (appliedMoves_ == moves_.size()) return false;
+
+    const std::size_t m     = appliedMoves_++;
+    const std::size_t begin = moves_[m].begin;
+    const std::size_t end   = m + 1 < moves_.size() ? moves_[m + 1].begin : deltas_.size();
+    for (std::size_t d = begin; d < end; ++d) {
+        writeCell(deltas_[d].index, deltas_[d].after);
+        if (changes) changes->push_back(deltas_[d]);
+    }
+    firstClick_ = moves_[m].firstClickAfter;
+    highlightX_ = -1;
+    highlightY_ = -1;
+    return true;
+}
+
+bool Board::canUndo() const {
+    return appliedMoves_ > 0;
+}
+
+bool Board::canRedo() const {
+    return appliedMoves_ < moves_.size();
+}
+
+void Board::setJournaling(bool enabled) {
+    journaling_ = enabled;
+    clearHistory();
+}
+
+void Board::clearHistory() {
+    deltas_.clear();
+    moves_.clear();
+    appliedMoves_ = 0;
+}
+
+// Opens a journal entry for a public mutation. The entry is only created
+// once the move actually changes a tile, so no-op clicks leave redo intact.
+void Board::beginMove(std::vector<CellChange>* changes) {
+    moveOpen_         = journaling_;
+    moveHasDeltas_    = false;
+    firstClickBefore_ = firstClick_;
+    changes_          = changes;
+}
+
+void Board::endMove() {
+    if (moveOpen_ && moveHasDeltas_) {
+        moves_.back().firstClickAfter = firstClick_;
+        ++appliedMoves_;
+    }
+    moveOpen_ = false;
+    changes_  = nullptr;
+}
+
+// Single write path for every tile mutation made by a move
+void Board::setCell(int i, std::uint8_t value) {
+    const std::uint8_t before = cells_[i];
+    if (before == value) return;
+    writeCell(i, value);
+    if (changes_) changes_->push_back({i, before, value});
+
+    if (!moveOpen_) return;
+    if (!moveHasDeltas_) {
+        // A new move discards anything that was undone.
+        if (appliedMoves_ < moves_.size()) {
+            deltas_.resize(moves_[appliedMoves_].begin);
+            moves_.resize(appliedMoves_);
+        }
+        moves_.push_back({deltas_.size(), firstClickBefore_, firstClickBefore_});
+        moveHasDeltas_ = true;
+    }
+    deltas_.push_back({i, before, value});
+}
+
+// Stores a tile byte and keeps the counters in step; moves, undo and redo
+// all write through here
+void Board::writeCell(int i, std::uint8_t value) {
+    const std::uint8_t before = cells_[i];
+    cells_[i] = value;
+    hiddenSafe_ += !(value  & (cell::REVEALED | cell::MINE)) - !(before & (cell::REVEALED | cell::MINE));
+    flags_      += !!(value & cell::FLAGGED) - !!(before & cell::FLAGGED);
+
+    // Past one write per tile, a fresh sweep costs less than the rechecks
+    if (solverLive_) {
+        if (solverTouched_.size() < cells_.size()) solverTouched_.push_back(i);
+        else solverLive_ = false;
+    }
+}
+
+// Rebuilds the counters, and restarts the solver's scan, after cells_ was
+// replaced wholesale
+void Board::recount() {
+    solverLive_ = false;
+    hiddenSafe_ = 0;
+    flags_      = 0;
+    for (std::uint8_t t : cells_) {
+        hiddenSafe_ += !(t & (cell::REVEALED | cell::MINE));
+        flags_      += (t & cell::FLAGGED) != 0;
+    }
+}
@@ -0,0 +1,144 @@
+#include "BoardFork.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// Grid adapter handing the shared rules (Rules.hpp) copy-on-write access.
+struct BoardFork::CellAccess {
+    BoardFork& f;
+
+    int          rows() const                  { return f.rows_; }
+    int          cols() const                  { return f.cols_; }
+    std::uint8_t get(int i) const              { return f.get(i); }
+    void         set(int i, std::uint8_t v)    { f.set(i, v); }
+};
+
+BoardFork::BoardFork(int rows, int cols, const std::uint8_t* cells)
+: rows_(rows)
+, cols_(cols)
+, safeHidden_(0)
+, pages_(std::make_shared<PageTable>()) {
+    const int N = rows_ * cols_;
+
+    pages_->reserve((N + PAGE_CELLS - 1) / PAGE_CELLS);
+    for (int begin = 0; begin < N; begin += PAGE_CELLS) {
+        auto page = std::make_shared<Page>();
+        const int count = std::min(PAGE_CELLS, N - begin);
+        std::copy(cells + begin, cells + begin + count, page->begin());
+        std::fill(page->begin() + count, page->end(), 0);
+        pages_->push_back(std::move(page));
+    }
+
+    for (int i = 0; i < N; ++i) {
+        if (!(cells[i] & (cell::MINE | cell::REVEALED))) ++safeHidden_;
+    }
+}
+
+BoardFork::BoardFork()
+: BoardFork(0, 0, nullptr) {}
+
+// Shares every page with the new fork; nothing is copied until written.
+BoardFork BoardFork::fork() const {
+    return *this;
+}
+
+// Copy-on-write store. A use_count of 1 means no other fork can reach the
+// table or page, so it can be written in place; the acquire fence orders
+// that write after any reads other forks made before dropping their share.
+void BoardFork::set(int i, std::uint8_t value) {
+    if (pages_.use_count() != 1) {
+        pages_ = std::make_shared<PageTable>(*pages_);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    auto& page = (*pages_)[i >> PAGE_SHIFT];
+    if (page.use_count() != 1) {
+        page = std::make_shared<Page>(*page);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    (*page)[i & (PAGE_CELLS - 1)] = value;
+}
+
+bool BoardFork::reveal(int x, int y) {
+    if (!inBounds(x, y)) return false;
+
+    CellAccess access{*this};
+    const rules::RevealResult r = rules::reveal(access, x, y, stack_);
+    safeHidden_ -= r.opened;
+    return r.hit;
+}
+
+// Toggles flag on an unrevealed tile
+void BoardFork::flag(int x, int y) {
+    if (!inBounds(x, y)) return;
+
+    CellAccess access{*this};
+    rules::toggleFlag(access, x, y);
+}
+
+bool BoardFork::chord(int x, int y) {
+    if (!inBounds(x, y)) return false;
+
+    CellAccess access{*this};
+    const rules::RevealResult r = rules::chord(access, x, y, stack_);
+    safeHidden_ -= r.opened;
+    return r.hit;
+}
+
+bool BoardFork::isCleared() const {
+    return safeHidden_ == 0;
+}
+
+int BoardFork::rows() const {
+    return rows_;
+}
+
+int BoardFork::cols() const {
+    return cols_;
+}
+
+bool BoardFork::inBounds(int x, int y) const {
+    return x >= 0 && x < cols_ && y >= 0 && y < rows_;
+}
+
+int BoardFork::index(int x, int y) const {
+    return y * cols_ + x;
+}
+
+std::uint8_t BoardFork::cellAt(int x, int y) const {
+    return inBounds(x, y) ? get(index(x, y)) : 0;
+}
+
+bool BoardFork::isRevealed(int x, int y) const {
+    return cellAt(x, y) & cell::REVEALED;
+}
+
+bool BoardFork::isFlaggedAt(int x, int y) const {
+    return cellAt(x, y) & cell::FLAGGED;
+}
+
+bool BoardFork::hasMineAt(int x, int y) const {
+    return cellAt(x, y) & cell::MINE;
+}
+
+int BoardFork::getAdjacentMines(int x, int y) const {
+    return cell::adjacent(cellAt(x, y));
+}
+
+int BoardFork::pageCount() const {
+    return static_cast<int>(pages_->size());
+}
+
+// Number of pages this fork and other currently share without a copy
+int BoardFork::sharedPageCount(const BoardFork& other) const {
+    if (pages_ == other.pages_) return pageCount();
+
+    int shared = 0;
+    const int n = std::min(pageCount(), other.pageCount());
+    for (int p = 0; p < n; ++p) {
+        if ((*pages_)[p] == (*other.pages_)[p]) ++shared;
+    }
+    return shared;
+}
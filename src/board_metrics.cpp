@@ -0,0 +1,183 @@
+#include "BoardMetrics.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+enum : std::uint8_t { HIDDEN, OPEN, FLAG };
+
+// Grid adapter handing the shared rules (Rules.hpp) a raw cell buffer.
+struct RawGrid {
+    std::uint8_t*   c;
+    int             r;
+    int             w;
+
+    int          rows() const                  { return r; }
+    int          cols() const                  { return w; }
+    std::uint8_t get(int i) const              { return c[i]; }
+    void         set(int i, std::uint8_t v)    { c[i] = v; }
+};
+
+template<typename F>
+void forEachNeighborIndex(int i, int rows, int cols, F&& fn) {
+    const int x = i % cols;
+    const int y = i / cols;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || nx >= cols || ny < 0 || ny >= rows) continue;
+            fn(ny * cols + nx);
+        }
+    }
+}
+
+}  // namespace
+
+const std::vector<std::uint8_t>& LayoutMeter::deal(int rows, int cols, int mines, std::uint32_t seed,
+                                                   int startX, int startY) {
+    cells_.resize(static_cast<std::size_t>(rows) * cols);
+    RawGrid grid{cells_.data(), rows, cols};
+
+    // Same RNG, same calls, same order as Board::reset and its first reveal
+    std::mt19937 rng(seed);
+    rules::placeMines(grid, mines, rng, scratch_);
+    rules::relocateFromSafeArea(grid, startX, startY, rng, scratch_);
+    return cells_;
+}
+
+BoardMetrics LayoutMeter::measure(const std::vector<std::uint8_t>& cells, int rows, int cols,
+                                  int startX, int startY) {
+    BoardMetrics m = measureOpenings(cells, rows, cols);
+    m.guesses = countGuesses(cells, rows, cols, startX, startY);
+    return m;
+}
+
+BoardMetrics LayoutMeter::measureOpenings(const std::vector<std::uint8_t>& cells, int rows, int cols) {
+    const int N = rows * cols;
+    auto isMine = [&](int i) { return (cells[i] & cell::MINE) != 0; };
+    auto isZero = [&](int i) { return !isMine(i) && cell::adjacent(cells[i]) == 0; };
+
+    BoardMetrics m;
+
+    // Openings: flood each unvisited 0 tile. stamp_ records the last
+    // opening to reach a tile, so a number bordering an opening twice is
+    // counted once, and a number no opening reaches is isolated.
+    stamp_.assign(N, -1);
+    for (int i = 0; i < N; ++i) {
+        if (!isZero(i) || stamp_[i] >= 0) continue;
+
+        const int id = m.openings++;
+        int size = 1;
+        stamp_[i] = id;
+        stack_.clear();
+        stack_.push_back(i);
+        while (!stack_.empty()) {
+            const int c = stack_.back();
+            stack_.pop_back();
+            forEachNeighborIndex(c, rows, cols, [&](int n) {
+                if (stamp_[n] == id) return;
+                stamp_[n] = id;
+                ++size;
+                if (isZero(n)) stack_.push_back(n);
+            });
+        }
+        m.largestOpening = std::max(m.largestOpening, size);
+    }
+    for (int i = 0; i < N; ++i) {
+        if (!isMine(i) && stamp_[i] < 0) ++m.isolated;
+    }
+    m.bbbv = m.openings + m.isolated;
+    return m;
+}
+
+// Revealing or flagging a tile re-queues the numbers around it, so each
+// tile is looked at a bounded number of times.
+int LayoutMeter::countGuesses(const std::vector<std::uint8_t>& cells, int rows, int cols,
+                              int startX, int startY) {
+    const int N = rows * cols;
+    auto isMine = [&](int i) { return (cells[i] & cell::MINE) != 0; };
+
+    int guesses  = 0;
+    int safeLeft = 0;
+    for (int i = 0; i < N; ++i) safeLeft += !isMine(i);
+    state_.assign(N, HIDDEN);
+    work_.clear();
+    frontier_.clear();
+
+    auto requeueAround = [&](int i) {
+        forEachNeighborIndex(i, rows, cols, [&](int n) {
+            if (state_[n] == OPEN && cell::adjacent(cells[n]) > 0) work_.push_back(n);
+        });
+    };
+    auto reveal = [&](int i) {
+        stack_.clear();
+        stack_.push_back(i);
+        state_[i] = OPEN;
+        while (!stack_.empty()) {
+            const int c = stack_.back();
+            stack_.pop_back();
+            --safeLeft;
+            requeueAround(c);
+            if (cell::adjacent(cells[c]) > 0) {
+                work_.push_back(c);
+                forEachNeighborIndex(c, rows, cols, [&](int n) {
+                    if (state_[n] == HIDDEN) frontier_.push_back(n);
+                });
+                continue;
+            }
+            forEachNeighborIndex(c, rows, cols, [&](int n) {
+                if (state_[n] != HIDDEN) return;
+                state_[n] = OPEN;
+                stack_.push_back(n);
+            });
+        }
+    };
+
+    reveal(startY * cols + startX);
+    int cursor = 0;
+    while (safeLeft > 0) {
+        while (!work_.empty()) {
+            const int c = work_.back();
+            work_.pop_back();
+
+            int flagged = 0;
+            int hidden  = 0;
+            forEachNeighborIndex(c, rows, cols, [&](int n) {
+                flagged += state_[n] == FLAG;
+                hidden  += state_[n] == HIDDEN;
+            });
+            if (hidden == 0) continue;
+
+            const int left = cell::adjacent(cells[c]) - flagged;
+            if (left != 0 && left != hidden) continue;
+            forEachNeighborIndex(c, rows, cols, [&](int n) {
+                if (state_[n] != HIDDEN) return;
+                if (left == 0) {
+                    reveal(n);              // rule 1
+                } else {
+                    state_[n] = FLAG;       // rule 2
+                    requeueAround(n);
+                }
+            });
+        }
+        if (safeLeft == 0) break;
+
+        // Stalled: reveal a safe tile, from the frontier when possible
+        int guess = -1;
+        while (guess < 0 && !frontier_.empty()) {
+            const int t = frontier_.back();
+            frontier_.pop_back();
+            if (state_[t] == HIDDEN && !isMine(t)) guess = t;
+        }
+        while (guess < 0) {
+            if (state_[cursor] == HIDDEN && !isMine(cursor)) guess = cursor;
+            ++cursor;
+        }
+        ++guesses;
+        reveal(guess);
+    }
+    return guesses;
+}
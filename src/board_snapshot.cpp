@@ -0,0 +1,183 @@
+#include "Board.hpp"
+#include "Varint.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+// Board snapshot format:
+//
+//      "MSBS"  version:u8  payloadSize:varint  payload
+//
+// payload:
+//      rows:varint  cols:varint  flags:u8 (bit 0 = first click pending)
+//      rngWords:varint  rngWords x u32 little-endian   (std::mt19937 state)
+//      mine bitset, one bit per tile, LSB first        (ceil(N/8) bytes)
+//      visibility runs until all N tiles are covered, each a varint
+//          ((runLength - 1) << 2) | visibility
+//      with visibility 0 = hidden, 1 = flagged, 2 = revealed.
+//
+// Each tile therefore costs one mine bit plus its share of a run; large
+// unrevealed or flood-revealed areas collapse to a single varint.
+
+namespace {
+
+constexpr char          kSnapshotMagic[4]   = {'M', 'S', 'B', 'S'};
+constexpr std::uint8_t  kSnapshotVersion    = 1;
+constexpr std::uint64_t kMaxSnapshotTiles   = 1ull << 26;
+
+enum Visibility : std::uint8_t { HIDDEN = 0, FLAGGED = 1, REVEALED = 2 };
+
+std::uint8_t visibilityOf(std::uint8_t c) {
+    if (c & cell::REVEALED) return REVEALED;
+    if (c & cell::FLAGGED)  return FLAGGED;
+    return HIDDEN;
+}
+
+void appendVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    std::uint8_t tmp[MAX_VARINT_BYTES];
+    out.insert(out.end(), tmp, tmp + encodeVarint(tmp, value));
+}
+
+[[noreturn]] void snapshotError() {
+    throw std::runtime_error("Board snapshot error");
+}
+
+}  // namespace
+
+void Board::save(std::ostream& out) const {
+    const int N = rows_ * cols_;
+    std::vector<std::uint8_t> payload;
+    payload.reserve(16 + 4 * 625 + N / 8 + 64);
+
+    appendVarint(payload, static_cast<std::uint64_t>(rows_));
+    appendVarint(payload, static_cast<std::uint64_t>(cols_));
+    payload.push_back(firstClick_ ? 1 : 0);
+
+    // std::mt19937 only exposes its state through operator<<, as decimal words.
+    std::vector<std::uint32_t> rngWords;
+    {
+        std::stringstream ss;
+        ss << rng_;
+        std::uint32_t w;
+        while (ss >> w) rngWords.push_back(w);
+    }
+    appendVarint(payload, rngWords.size());
+    for (std::uint32_t w : rngWords) {
+        for (int b = 0; b < 4; ++b) payload.push_back(static_cast<std::uint8_t>(w >> (8 * b)));
+    }
+
+    // Mine bitset
+    const std::size_t bitsetStart = payload.size();
+    payload.resize(bitsetStart + (N + 7) / 8, 0);
+    for (int i = 0; i < N; ++i) {
+        if (cells_[i] & cell::MINE) payload[bitsetStart + i / 8] |= 1u << (i % 8);
+    }
+
+    // Visibility runs
+    for (int i = 0; i < N; ) {
+        const std::uint8_t vis = visibilityOf(cells_[i]);
+        int run = 1;
+        while (i + run < N && visibilityOf(cells_[i + run]) == vis) ++run;
+        appendVarint(payload, (static_cast<std::uint64_t>(run - 1) << 2) | vis);
+        i += run;
+    }
+
+    std::uint8_t header[sizeof(kSnapshotMagic) + 1 + MAX_VARINT_BYTES];
+    std::copy(kSnapshotMagic, kSnapshotMagic + sizeof(kSnapshotMagic), header);
+    header[sizeof(kSnapshotMagic)] = kSnapshotVersion;
+    const std::size_t headerSize = sizeof(kSnapshotMagic) + 1
+        + encodeVarint(header + sizeof(kSnapshotMagic) + 1, payload.size());
+
+    out.write(reinterpret_cast<const char*>(header), static_cast<std::streamsize>(headerSize));
+    out.write(reinterpret_cast<const char*>(payload.data()),
+              static_cast<std::streamsize>(payload.size()));
+}
+
+void Board::load(std::istream& in) {
+    char magic[sizeof(kSnapshotMagic)] = {};
+    in.read(magic, sizeof(magic));
+    const int version = in.get();
+    if (!in || !std::equal(magic, magic + sizeof(magic), kSnapshotMagic)
+        || version != kSnapshotVersion) {
+        snapshotError();
+    }
+
+    // The payload size is a varint read straight off the stream; everything
+    // after it is decoded from one contiguous buffer.
+    std::uint64_t payloadSize = 0;
+    for (int shift = 0;; shift += 7) {
+        const int byte = in.get();
+        if (!in || shift >= 64) snapshotError();
+        payloadSize |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) break;
+    }
+    if (payloadSize > 4 * kMaxSnapshotTiles) snapshotError();
+
+    std::vector<std::uint8_t> payload(payloadSize);
+    in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payloadSize));
+    if (static_cast<std::uint64_t>(in.gcount()) != payloadSize) snapshotError();
+
+    const std::uint8_t* p   = payload.data();
+    const std::uint8_t* end = p + payload.size();
+
+    std::uint64_t rows, cols, rngCount;
+    if (!decodeVarint(p, end, rows) || !decodeVarint(p, end, cols)) snapshotError();
+    // Each side is bounded first so the product cannot wrap
+    if (rows == 0 || cols == 0 || rows > kMaxSnapshotTiles || cols > kMaxSnapshotTiles
+        || rows * cols > kMaxSnapshotTiles || p == end) {
+        snapshotError();
+    }
+    const bool firstClick = (*p++ & 1) != 0;
+
+    if (!decodeVarint(p, end, rngCount) || rngCount > 1024
+        || static_cast<std::uint64_t>(end - p) < 4 * rngCount) {
+        snapshotError();
+    }
+    std::mt19937 rng;
+    {
+        std::stringstream ss;
+        for (std::uint64_t k = 0; k < rngCount; ++k, p += 4) {
+            ss << (std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8
+                 | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24) << ' ';
+        }
+        ss >> rng;
+        if (ss.fail()) snapshotError();
+    }
+
+    const int N = static_cast<int>(rows * cols);
+    if (end - p < (N + 7) / 8) snapshotError();
+
+    std::vector<std::uint8_t> cells(N);
+    for (int i = 0; i < N; ++i) {
+        cells[i] = (p[i / 8] >> (i % 8)) & 1;
+    }
+    p += (N + 7) / 8;
+
+    static constexpr std::uint8_t visBits[3] = {0, cell::FLAGGED, cell::REVEALED};
+    for (int i = 0; i < N; ) {
+        std::uint64_t token;
+        if (!decodeVarint(p, end, token)) snapshotError();
+        const std::uint8_t  vis = token & 3;
+        const std::uint64_t run = (token >> 2) + 1;
+        if (vis > REVEALED || run > static_cast<std::uint64_t>(N - i)) snapshotError();
+
+        if (vis != HIDDEN) {
+            for (int k = i, stop = i + static_cast<int>(run); k < stop; ++k) cells[k] |= visBits[vis];
+        }
+        i += static_cast<int>(run);
+    }
+    if (p != end) snapshotError();
+
+    // Decoded cleanly; commit.
+    rows_       = static_cast<int>(rows);
+    cols_       = static_cast<int>(cols);
+    cells_      = std::move(cells);
+    firstClick_ = firstClick;
+    rng_        = rng;
+    highlightX_ = -1;
+    highlightY_ = -1;
+
+    computeAdjacentMines();
+    recount();
+    clearHistory();
+}
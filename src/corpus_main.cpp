@@ -0,0 +1,91 @@
+#include "PuzzleCorpus.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " generate <file> <rows> <cols> <mines> <count> [first-seed]\n"
+        << "  " << prog << " solve <file> [--start <x> <y>] [--strategy <name>]\n"
+        << "\n"
+        << "generate writes the layouts Board would deal for seeds first-seed, first-seed+1, ...\n"
+        << "solve streams one CSV row per puzzle; the start cell defaults to the board center.\n";
+}
+
+int generate(int argc, char** argv) {
+    if (argc != 7 && argc != 8) return -1;
+
+    const int           rows  = std::stoi(argv[3]);
+    const int           cols  = std::stoi(argv[4]);
+    const int           mines = std::stoi(argv[5]);
+    const std::uint32_t count = static_cast<std::uint32_t>(std::stoul(argv[6]));
+    const std::uint32_t seed  = argc == 8 ? static_cast<std::uint32_t>(std::stoul(argv[7])) : 1;
+    if (rows < 1 || cols < 1 || rows > 0xFFFF || cols > 0xFFFF || mines < 0 || mines >= rows * cols) {
+        return -1;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot open " << argv[2] << " for writing\n";
+        return 1;
+    }
+    generateCorpus(out, rows, cols, mines, seed, count);
+    return 0;
+}
+
+int solve(int argc, char** argv) {
+    if (argc < 3) return -1;
+
+    const PuzzleCorpus corpus(argv[2]);
+    int         startX   = corpus.cols() / 2;
+    int         startY   = corpus.rows() / 2;
+    std::string strategy = "two-rule";
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--start" && i + 2 < argc) {
+            startX = std::stoi(argv[++i]);
+            startY = std::stoi(argv[++i]);
+        } else if (arg == "--strategy" && i + 1 < argc) {
+            strategy = argv[++i];
+        } else {
+            return -1;
+        }
+    }
+
+    for (const StrategyInfo& info : strategyRegistry()) {
+        if (info.name != strategy) continue;
+
+        std::unique_ptr<Strategy> s = info.create();
+        solveCorpus(corpus, startX, startY, *s, std::cout);
+        return 0;
+    }
+    std::cerr << "Unknown strategy " << strategy << '\n';
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+
+    int rc = -1;
+    try {
+        const std::string command = argc > 1 ? argv[1] : "";
+        if (command == "generate") rc = generate(argc, argv);
+        else if (command == "solve") rc = solve(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (rc < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return rc;
+}
@@ -0,0 +1,205 @@
+#include "Dashboard.hpp"
+#include "Resources.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace {
+
+// Room the grid may fill; tiles are whole pixels
+constexpr float kMaxGridW = 1600.f;
+constexpr float kMaxGridH = 900.f;
+
+sf::Color tileColor(std::uint8_t c) {
+    // Board::draw's number colors; an opened 0 keeps the revealed color
+    static const std::array<sf::Color, 9> numberColors = {
+        sf::Color(51,58,65),
+        {124,199,255},
+        {99,193,99},
+        {255,119,136},
+        {238,136,255},
+        {221,170,34},
+        {0,128,128},
+        {0,0,0},
+        {128,128,128}
+    };
+
+    if (!(c & cell::REVEALED)) return (c & cell::FLAGGED) ? sf::Color(238,102,102) : sf::Color(76,84,92);
+    if (c & cell::MINE)        return sf::Color(255,220,0);
+    return numberColors[cell::adjacent(c)];
+}
+
+}  // namespace
+
+Dashboard::Dashboard(const GameFeed::Config& config)
+: feed_(config)
+, rows_(config.rows)
+, cols_(config.cols)
+, font_(resources::font())
+{
+    // Pick the grid shape that gives the biggest tiles
+    const int n = config.boards;
+    for (int gc = 1; gc <= n; ++gc) {
+        const int   gr   = (n + gc - 1) / gc;
+        const float tile = std::floor(std::min((kMaxGridW / gc - GAP) / cols_,
+                                               (kMaxGridH / gr - GAP) / rows_));
+        if (tile > tileSize_ || gc == 1) {
+            tileSize_ = std::max(tile, 1.f);
+            gridCols_ = gc;
+        }
+    }
+    const int   gridRows = (n + gridCols_ - 1) / gridCols_;
+    const float boardW   = cols_ * tileSize_;
+    const float boardH   = rows_ * tileSize_;
+
+    window_.create(sf::VideoMode(static_cast<unsigned>(gridCols_ * (boardW + GAP) + GAP),
+                                 static_cast<unsigned>(gridRows * (boardH + GAP) + GAP + STATUS_H)),
+                   "Minesweeper Dashboard", sf::Style::Titlebar | sf::Style::Close);
+    window_.setFramerateLimit(FRAME_RATE);
+
+    // One quad per tile; a one-pixel seam shows the grid when tiles are big enough
+    const float seam = tileSize_ >= 4.f ? 1.f : 0.f;
+    for (int b = 0; b < n; ++b) {
+        const float ox = GAP + (b % gridCols_) * (boardW + GAP);
+        const float oy = STATUS_H + GAP + (b / gridCols_) * (boardH + GAP);
+
+        sf::VertexArray tiles(sf::Quads, static_cast<std::size_t>(rows_) * cols_ * 4);
+        for (int y = 0; y < rows_; ++y) {
+            for (int x = 0; x < cols_; ++x) {
+                sf::Vertex* quad = &tiles[(y * cols_ + x) * 4];
+                const float left = ox + x * tileSize_, top = oy + y * tileSize_;
+                quad[0].position = {left,                    top};
+                quad[1].position = {left + tileSize_ - seam, top};
+                quad[2].position = {left + tileSize_ - seam, top + tileSize_ - seam};
+                quad[3].position = {left,                    top + tileSize_ - seam};
+                for (int v = 0; v < 4; ++v) quad[v].color = tileColor(0);
+            }
+        }
+        boards_.push_back(std::move(tiles));
+
+        sf::RectangleShape frame({boardW, boardH});
+        frame.setPosition(ox, oy);
+        frame.setFillColor(sf::Color::Transparent);
+        frame.setOutlineThickness(2.f);
+        frame.setOutlineColor(sf::Color::Transparent);
+        frames_.push_back(frame);
+    }
+
+    statusText_.setFont(font_);
+    statusText_.setCharacterSize(12);
+    statusText_.setFillColor(sf::Color::White);
+    statusText_.setPosition(GAP, 5.f);
+
+    profilerBackground_.setFillColor(sf::Color(0, 0, 0, 170));
+    profilerBackground_.setPosition(4.f, STATUS_H + 4.f);
+    profilerText_.setFont(font_);
+    profilerText_.setCharacterSize(12);
+    profilerText_.setFillColor(sf::Color::White);
+    profilerText_.setPosition(8.f, STATUS_H + 6.f);
+}
+
+void Dashboard::run() {
+    while (window_.isOpen()) {
+        profiler_.beginFrame();
+        processEvents();
+        profiler_.endPhase(FrameProfiler::Series::Events);
+        update();
+        profiler_.endPhase(FrameProfiler::Series::Update);
+        render();
+        profiler_.endFrame();
+    }
+}
+
+const FrameProfiler& Dashboard::profiler() const {
+    return profiler_;
+}
+
+void Dashboard::processEvents() {
+    sf::Event event;
+    while (window_.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) window_.close();
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            profilerVisible_ = !profilerVisible_;
+        }
+    }
+}
+
+// Applies everything the feed published since the last frame. Work is
+// proportional to the tiles that changed, not to the boards on screen.
+void Dashboard::update() {
+    updates_.clear();
+    feed_.drain(updates_);
+
+    for (const GameFeed::Update& u : updates_) {
+        sf::RectangleShape& frame = frames_[u.board];
+        switch (u.kind) {
+            case GameFeed::Update::Kind::Tile:
+                setTile(u.board, static_cast<int>(u.index), u.cell);
+                break;
+            case GameFeed::Update::Kind::NewGame:
+                for (int i = 0; i < rows_ * cols_; ++i) setTile(u.board, i, 0);
+                frame.setOutlineColor(sf::Color::Transparent);
+                break;
+            case GameFeed::Update::Kind::Won:
+                ++won_;
+                frame.setOutlineColor(sf::Color(99,193,99));
+                break;
+            case GameFeed::Update::Kind::Lost:
+                ++lost_;
+                frame.setOutlineColor(sf::Color(238,102,102));
+                break;
+            case GameFeed::Update::Kind::Stuck:
+                ++stuck_;
+                frame.setOutlineColor(sf::Color(221,170,34));
+                break;
+        }
+    }
+}
+
+void Dashboard::setTile(int board, int index, std::uint8_t cell) {
+    const sf::Color color = tileColor(cell);
+    sf::Vertex* quad = &boards_[board][static_cast<std::size_t>(index) * 4];
+    for (int v = 0; v < 4; ++v) quad[v].color = color;
+    ++tileWrites_;
+}
+
+void Dashboard::render() {
+    window_.clear(sf::Color(30,34,38));
+    for (const sf::VertexArray& tiles : boards_) window_.draw(tiles);
+    profiler_.endPhase(FrameProfiler::Series::BoardDraw);
+
+    for (const sf::RectangleShape& frame : frames_) {
+        if (frame.getOutlineColor() != sf::Color::Transparent) window_.draw(frame);
+    }
+
+    // Status: totals, the win rate and how fast tiles are changing
+    if (statusClock_.getElapsedTime() >= sf::milliseconds(250)) {
+        const float seconds = statusClock_.restart().asSeconds();
+        const std::uint64_t games = won_ + lost_ + stuck_;
+        statusText_.setString(std::to_string(boards_.size()) + " boards  "
+                              + std::to_string(games) + " games  "
+                              + std::to_string(won_) + " won / " + std::to_string(lost_) + " lost / "
+                              + std::to_string(stuck_) + " stuck  "
+                              + (games ? std::to_string(100 * won_ / games) + "% wins  " : std::string())
+                              + std::to_string(std::lround((tileWrites_ - statusWrites_) / seconds)) + " tiles/s");
+        statusWrites_ = tileWrites_;
+
+        if (profilerVisible_) {
+            profilerText_.setString(profiler_.overlayText());
+            auto b = profilerText_.getLocalBounds();
+            profilerBackground_.setSize({b.left + b.width + 8.f, b.top + b.height + 8.f});
+        }
+    }
+    window_.draw(statusText_);
+    if (profilerVisible_) {
+        window_.draw(profilerBackground_);
+        window_.draw(profilerText_);
+    }
+    profiler_.endPhase(FrameProfiler::Series::UiDraw);
+
+    window_.display();
+    profiler_.endPhase(FrameProfiler::Series::Display);
+}
@@ -0,0 +1,100 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+const char* FrameProfiler::name(Series s) {
+    static const std::array<const char*, NUM_SERIES> names = {
+        "events", "update", "board_draw", "ui_draw", "display", "frame", "input_latency"
+    };
+    return names[static_cast<int>(s)];
+}
+
+void FrameProfiler::beginFrame() {
+    frameStart_ = Clock::now();
+    phaseStart_ = frameStart_;
+}
+
+// Attributes the time since the previous mark to phase
+void FrameProfiler::endPhase(Series phase) {
+    const Clock::time_point now = Clock::now();
+    addSample(phase, msBetween(phaseStart_, now));
+    phaseStart_ = now;
+}
+
+// Clicks past MAX_PENDING in a single frame go unrecorded.
+void FrameProfiler::inputReceived() {
+    const Clock::time_point now = Clock::now();
+    if (numPending_ < MAX_PENDING) {
+        pending_[numPending_++] = now;
+    }
+}
+
+void FrameProfiler::endFrame() {
+    const Clock::time_point now = Clock::now();
+    addSample(Series::Frame, msBetween(frameStart_, now));
+
+    for (int i = 0; i < numPending_; ++i) {
+        addSample(Series::InputLatency, msBetween(pending_[i], now));
+    }
+    numPending_ = 0;
+}
+
+void FrameProfiler::addSample(Series s, float ms) {
+    Ring& r = ring_[static_cast<int>(s)];
+    r.samples[r.next] = ms;
+    r.next = (r.next + 1) % WINDOW;
+    r.count = std::min(r.count + 1, WINDOW);
+}
+
+// Nearest-rank percentiles over the current window
+FrameProfiler::Summary FrameProfiler::summary(Series s) const {
+    const Ring& r = ring_[static_cast<int>(s)];
+
+    Summary out;
+    out.samples = r.count;
+    if (r.count == 0) return out;
+
+    auto begin = sortScratch_.begin();
+    auto end   = begin + r.count;
+    std::copy(r.samples.begin(), r.samples.begin() + r.count, begin);
+
+    auto rank = [&](float p) {
+        const int k = static_cast<int>(std::ceil(p * r.count)) - 1;
+        return std::max(0, std::min(k, r.count - 1));
+    };
+    std::nth_element(begin, begin + rank(0.50f), end);
+    out.p50Ms = begin[rank(0.50f)];
+    std::nth_element(begin, begin + rank(0.99f), end);
+    out.p99Ms = begin[rank(0.99f)];
+    out.maxMs = *std::max_element(begin, end);
+    return out;
+}
+
+void FrameProfiler::writeReport(std::ostream& os) const {
+    os << "series,samples,p50_ms,p99_ms,max_ms\n";
+    for (int i = 0; i < NUM_SERIES; ++i) {
+        const Summary s = summary(static_cast<Series>(i));
+        os << name(static_cast<Series>(i)) << ',' << s.samples << ','
+           << s.p50Ms << ',' << s.p99Ms << ',' << s.maxMs << '\n';
+    }
+}
+
+std::string FrameProfiler::overlayText() const {
+    char line[64];
+    std::snprintf(line, sizeof(line), "%-13s %6s %6s\n", "ms", "p50", "p99");
+    std::string text = line;
+    for (int i = 0; i < NUM_SERIES; ++i) {
+        const Summary s = summary(static_cast<Series>(i));
+        std::snprintf(line, sizeof(line), "%-13s %6.2f %6.2f\n",
+                      name(static_cast<Series>(i)), s.p50Ms, s.p99Ms);
+        text += line;
+    }
+    return text;
+}
+
+float FrameProfiler::msBetween(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<float, std::milli>(b - a).count();
+}
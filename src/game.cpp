@@ -1,19 +1,24 @@
 #include "Game.hpp"
+#include "Resources.hpp"
 
-Game::Game(int rows, int cols, int numMines)
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+Game::Game(int rows, int cols, int numMines, MoveLogWriter* moveLog, sf::Time turboSlice)
 : rows_(rows)
 , cols_(cols)
 , numMines_(numMines)
 , window(sf::VideoMode(cols_ * TILE_SIZE, rows_ * TILE_SIZE + 50), "AI-Powered Minesweeper")
 , board(rows_, cols_, TILE_SIZE, numMines_)
+, moveLog_(moveLog)
+, font_(resources::font())
+, turboSlice_(turboSlice)
 {
     window.setFramerateLimit(FRAME_RATE);
 
-    // Load font for numbers, flags, mine, etc.
-    if (!font_.loadFromFile("assets/mine-sweeper.ttf")) {
-        throw std::runtime_error("Font error");
-    }
-
     // ========== Restart button ==========
     // --- Button positioning/dimensions ---
     float btnSize   = 40.f;
@@ -95,22 +100,139 @@ Game::Game(int rows, int cols, int numMines)
         );
     }
 
+    // ========== Heatmap toggle, left of the AI button ==========
+    heatmapButton_.setSize({60.f, 24.f});
+    heatmapButton_.setFillColor({200,200,200});
+    heatmapButton_.setPosition(AIButton_.getPosition().x - 8.f - 60.f, AIButton_.getPosition().y);
+
+    heatmapButtonText_.setFont(font_);
+    heatmapButtonText_.setCharacterSize(12);
+    heatmapButtonText_.setString("HEAT");
+    heatmapButtonText_.setFillColor(sf::Color::White);
+    {
+        auto b = heatmapButtonText_.getLocalBounds();
+        heatmapButtonText_.setOrigin(b.width / 2.f + b.left, b.height / 2.f + b.top);
+        heatmapButtonText_.setPosition(
+            heatmapButton_.getPosition().x + heatmapButton_.getSize().x / 2.f,
+            heatmapButton_.getPosition().y + heatmapButton_.getSize().y / 2.f
+        );
+    }
+
+    // ========== AI speed, right of the flag counter ==========
+    speedButton_.setSize({44.f, 24.f});
+    speedButton_.setPosition(100.f, AIButton_.getPosition().y);
+
+    speedButtonText_.setFont(font_);
+    speedButtonText_.setCharacterSize(12);
+    speedButtonText_.setFillColor(sf::Color::White);
+    setSpeed(0);
+
+    turboBackground_.setFillColor(sf::Color(0, 0, 0, 170));
+    turboText_.setFont(font_);
+    turboText_.setCharacterSize(12);
+    turboText_.setFillColor(sf::Color::White);
+
+    // One quad per tile, transparent until a map arrives
+    heatmapTiles_.setPrimitiveType(sf::Quads);
+    heatmapTiles_.resize(static_cast<std::size_t>(rows_) * cols_ * 4);
+    for (int y = 0; y < rows_; ++y) {
+        for (int x = 0; x < cols_; ++x) {
+            sf::Vertex* quad = &heatmapTiles_[(y * cols_ + x) * 4];
+            quad[0].position = {x * TILE_SIZE,             y * TILE_SIZE};
+            quad[1].position = {(x + 1) * TILE_SIZE - 1.f, y * TILE_SIZE};
+            quad[2].position = {(x + 1) * TILE_SIZE - 1.f, (y + 1) * TILE_SIZE - 1.f};
+            quad[3].position = {x * TILE_SIZE,             (y + 1) * TILE_SIZE - 1.f};
+        }
+    }
+    clearHeatmap();
+
+    // ========== Profiler overlay ==========
+    profilerBackground_.setFillColor(sf::Color(0, 0, 0, 170));
+    profilerBackground_.setPosition(4.f, 4.f);
+
+    profilerText_.setFont(font_);
+    profilerText_.setCharacterSize(12);
+    profilerText_.setFillColor(sf::Color::White);
+    profilerText_.setPosition(8.f, 6.f);
+
     // Set up the game view to allow resizing of window
     float worldW = cols_ * TILE_SIZE;
     float worldH = rows_ * TILE_SIZE + uiH;
     gameView_.reset({0.f, 0.f, worldW, worldH});
     window.setView(gameView_);
+
+    newGame();
+}
+
+// Starts a fresh game with an explicit seed so it can be recorded and replayed
+void Game::newGame() {
+    seed_ = std::random_device{}();
+    board.reset(rows_, cols_, numMines_, seed_);
+    state_ = GameState::PLAYING;
+    stepRequested_ = false;
+    turboMoves_ = 0;
+    turboClock_.restart();
+    clearHeatmap();
+    boardChanged();
+
+    if (moveLog_) moveLog_->beginGame({seed_, rows_, cols_, numMines_});
+}
+
+// Invalidates any solver answer computed for the previous board state
+void Game::boardChanged() {
+    ++boardGeneration_;
+    solverResult_.reset();
+}
+
+void Game::setAISolveEnabled(bool enabled) {
+    AISolveEnabled_ = enabled;
+    AIButtonText_.setString(enabled ? "AI:   ON" : "AI: OFF");
+    AIButton_.setFillColor(enabled ? sf::Color(0, 255, 0) : sf::Color(200, 200, 200));
+    AISolveClock_.restart();
+    if (enabled) {
+        turboMoves_ = 0;
+        turboClock_.restart();
+    }
+}
+
+// Selects AI_SPEEDS[index] and relabels the speed button
+void Game::setSpeed(int index) {
+    speedIndex_ = index;
+    speedButtonText_.setString(turbo() ? "MAX" : std::to_string(AI_SPEEDS[index]) + "x");
+    speedButton_.setFillColor(turbo() ? sf::Color(255, 140, 0) : sf::Color(200, 200, 200));
+
+    auto b = speedButtonText_.getLocalBounds();
+    speedButtonText_.setOrigin(b.width / 2.f + b.left, b.height / 2.f + b.top);
+    speedButtonText_.setPosition(
+        speedButton_.getPosition().x + speedButton_.getSize().x / 2.f,
+        speedButton_.getPosition().y + speedButton_.getSize().y / 2.f
+    );
+
+    turboMoves_ = 0;
+    turboClock_.restart();
+}
+
+bool Game::turbo() const {
+    return AI_SPEEDS[speedIndex_] == 0;
 }
 
 // Main game loop
 void Game::run() {
     while (window.isOpen()) {
+        profiler_.beginFrame();
         processEvents();
+        profiler_.endPhase(FrameProfiler::Series::Events);
         update();
+        profiler_.endPhase(FrameProfiler::Series::Update);
         render();
+        profiler_.endFrame();
     }
 }
 
+const FrameProfiler& Game::profiler() const {
+    return profiler_;
+}
+
 // Handles user input and events
 void Game::processEvents() {
     sf::Event event;
@@ -119,6 +241,8 @@ void Game::processEvents() {
             window.close();
 
         if (event.type == sf::Event::MouseButtonPressed) {
+            profiler_.inputReceived();
+
             // Update the game view if the window is resized
             auto pixelPos = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
             auto worldPos = window.mapPixelToCoords(pixelPos, gameView_);
@@ -126,8 +250,21 @@ void Game::processEvents() {
             // Watch for restart button click
             sf::Vector2f mp(worldPos.x, worldPos.y);
             if (restartButton_.getGlobalBounds().contains(mp)) {
-                board.reset(rows_, cols_, numMines_);
-                state_ = GameState::PLAYING;
+                newGame();
+                continue;
+            }
+
+            // Watch for heatmap toggle; also useful after the game ends
+            if (heatmapButton_.getGlobalBounds().contains(mp)) {
+                heatmapEnabled_ = !heatmapEnabled_;
+                heatmapButton_.setFillColor(heatmapEnabled_ ? sf::Color(255, 140, 0) : sf::Color(200, 200, 200));
+                heatmapRequested_ = 0;      // resubmit the current board
+                continue;
+            }
+
+            // Watch for the speed button; cycles 1x, 4x, 16x, MAX
+            if (speedButton_.getGlobalBounds().contains(mp)) {
+                setSpeed((speedIndex_ + 1) % static_cast<int>(std::size(AI_SPEEDS)));
                 continue;
             }
 
@@ -137,10 +274,7 @@ void Game::processEvents() {
 
             // Watch for AI button click
             if (AIButton_.getGlobalBounds().contains(mp)) {
-                AISolveEnabled_ = !AISolveEnabled_;
-                AIButtonText_.setString(AISolveEnabled_ ? "AI:   ON" : "AI: OFF");
-                AIButton_.setFillColor(AISolveEnabled_ ? sf::Color(0, 255, 0) : sf::Color(200, 200, 200));
-                AISolveClock_.restart();
+                setAISolveEnabled(!AISolveEnabled_);
                 continue;
             }
 
@@ -148,10 +282,13 @@ void Game::processEvents() {
             int x = worldPos.x / TILE_SIZE;
             int y = worldPos.y / TILE_SIZE;
             bool hit = false;
+            const bool onBoard = board.inBounds(x, y);
             if (event.mouseButton.button == sf::Mouse::Left) {
                 if (board.isRevealed(x,y) && board.getAdjacentMines(x,y) > 0) {
+                    if (moveLog_ && onBoard) moveLog_->chord(x, y);
                     hit = board.chord(x, y);
                 } else {
+                    if (moveLog_ && onBoard) moveLog_->reveal(x, y);
                     hit = board.reveal(x, y);
                 }
 
@@ -160,8 +297,11 @@ void Game::processEvents() {
                 } else if (board.isCleared()) {
                     state_ = GameState::WIN;
                 }
+                if (onBoard) boardChanged();
             } else if (event.mouseButton.button == sf::Mouse::Right) {
+                if (moveLog_ && onBoard) moveLog_->flag(x, y);
                 board.flag(x, y);
+                if (onBoard) boardChanged();
             }
         }
 
@@ -170,29 +310,147 @@ void Game::processEvents() {
             if (state_ != GameState::PLAYING)
                 continue;
 
-            if (board.AISolver() && board.isCleared())
-                state_ = GameState::WIN;
+            // Applied by update() as soon as the worker has an answer
+            stepRequested_ = true;
+        }
+
+        // Toggles the frame profiler overlay
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            profilerVisible_ = !profilerVisible_;
         }
     }
 }
 
-// Update game logic - AI on or off
+// Update game logic - AI on or off. The solver runs on solver_'s thread;
+// this only hands it snapshots and applies its answers, so a slow solve
+// never holds up the frame.
 void Game::update() {
-    if (AISolveEnabled_ && state_ == GameState::PLAYING) {
-        // Simulates "thinking" delay
-        if (AISolveClock_.getElapsedTime() >=  AISolveDelay_){
-            bool moved = board.AISolver();
-            AISolveClock_.restart();
+    updateHeatmap();
+
+    if (state_ != GameState::PLAYING || (!AISolveEnabled_ && !stepRequested_))
+        return;
 
-            // Checks win condition, turns AI off if game is won
+    // Collect answers; anything computed for an older board state is stale.
+    SolverWorker::Result result;
+    while (solver_.poll(result)) {
+        if (result.generation == boardGeneration_) solverResult_ = result;
+    }
+
+    // Turbo: the two rules run right here until the frame's slice is used
+    // up; the worker's deeper tiers only come in once they stall.
+    if (turbo() && AISolveEnabled_ && !stepRequested_) {
+        const int steps = board.runAISolver(std::chrono::steady_clock::now()
+                                            + std::chrono::microseconds(turboSlice_.asMicroseconds()));
+        if (steps > 0) {
+            if (moveLog_) {
+                for (int i = 0; i < steps; ++i) moveLog_->aiStep();
+            }
+            turboMoves_ += steps;
+            boardChanged();
             if (board.isCleared()) {
                 state_ = GameState::WIN;
-                AISolveEnabled_ = false;
-                AIButtonText_.setString("AI: OFF");
-                AIButton_.setFillColor(sf::Color(200, 200, 200));
+                setAISolveEnabled(false);
+            }
+            return;
+        }
+    }
+
+    // Ask for a move once per board state. The "thinking" delay doubles as
+    // the worker's time budget, so the answer is ready when it is due.
+    const sf::Time delay  = turbo() ? sf::Time::Zero : AISolveDelay_ / static_cast<float>(AI_SPEEDS[speedIndex_]);
+    const sf::Time budget = turbo() ? turboSlice_ : delay;
+    const auto deadline = SolverWorker::Clock::now()
+                        + std::chrono::microseconds(budget.asMicroseconds());
+    if (!solverResult_ && requestedGeneration_ != boardGeneration_
+        && solver_.submit(board.fork(), boardGeneration_, numMines_, deadline)) {
+        requestedGeneration_ = boardGeneration_;
+    }
+
+    // Simulates "thinking" delay in continuous mode; Space steps at once
+    if (!solverResult_ || (!stepRequested_ && AISolveClock_.getElapsedTime() < delay))
+        return;
+
+    // A guess can lose the game, so continuous mode stops at one and
+    // render() marks it; Space plays it.
+    const SolverWorker::Result answer = *solverResult_;
+    if (!answer.proven && !stepRequested_)
+        return;
+
+    stepRequested_ = false;
+    AISolveClock_.restart();
+
+    // A stuck answer stays cached until the board changes, so it is not resubmitted.
+    if (!board.applySolverMove(answer.move))
+        return;
+
+    if (moveLog_) {
+        switch (answer.move.action) {
+            case SolverMove::Action::RevealTile: moveLog_->reveal(answer.move.x, answer.move.y); break;
+            case SolverMove::Action::FlagTile:   moveLog_->flag(answer.move.x, answer.move.y);   break;
+            default:                             moveLog_->aiStep();                             break;
+        }
+    }
+    boardChanged();
+    ++turboMoves_;
+
+    if (answer.move.action == SolverMove::Action::RevealTile && board.hasMineAt(answer.move.x, answer.move.y)) {
+        state_ = GameState::LOSE;
+        return;
+    }
+
+    // Checks win condition, turns AI off if game is won
+    if (board.isCleared()) {
+        state_ = GameState::WIN;
+        setAISolveEnabled(false);
+    }
+}
+
+// Hands the heatmap worker the current board once per board state and
+// recolors the tiles whose shade changed in the newest map. A map for an
+// older state is still shown until a newer one lands; it is never more
+// than a frame or two behind.
+void Game::updateHeatmap() {
+    // Drained even when hidden, so the worker never waits on a full queue
+    HeatmapWorker::Result result;
+    while (heatmap_.poll(result)) {
+        if (!heatmapEnabled_ || result.generation <= heatmapShown_
+            || result.probabilities.size() != heatmapShades_.size()) {
+            continue;
+        }
+        heatmapShown_ = result.generation;
+
+        for (std::size_t i = 0; i < heatmapShades_.size(); ++i) {
+            // 32 shades from green (safe) through yellow to red (mine)
+            const float p = result.probabilities[i];
+            const std::uint8_t shade = p >= 0.f ? static_cast<std::uint8_t>(1 + std::lround(p * 31.f)) : 0;
+            if (shade == heatmapShades_[i]) continue;
+            heatmapShades_[i] = shade;
+
+            sf::Color color = sf::Color::Transparent;
+            if (shade) {
+                const float t = (shade - 1) / 31.f;
+                color = sf::Color(static_cast<sf::Uint8>(255.f * std::min(1.f, 2.f * t)),
+                                  static_cast<sf::Uint8>(255.f * std::min(1.f, 2.f - 2.f * t)),
+                                  0, 110);
             }
+            sf::Vertex* quad = &heatmapTiles_[i * 4];
+            for (int v = 0; v < 4; ++v) quad[v].color = color;
         }
     }
+
+    if (heatmapEnabled_ && heatmapRequested_ != boardGeneration_
+        && heatmap_.submit(board.fork(), numMines_, boardGeneration_)) {
+        heatmapRequested_ = boardGeneration_;
+    }
+}
+
+// Drops the overlay, e.g. for a new game, so old shades never show
+void Game::clearHeatmap() {
+    heatmapShades_.assign(static_cast<std::size_t>(rows_) * cols_, 0);
+    for (std::size_t v = 0; v < heatmapTiles_.getVertexCount(); ++v) {
+        heatmapTiles_[v].color = sf::Color::Transparent;
+    }
+    heatmapShown_ = boardGeneration_;
 }
 
 // Rendering/drawing the game
@@ -200,11 +458,14 @@ void Game::render() {
     window.setView(gameView_);
     window.clear();
     board.draw(window);
+    if (heatmapEnabled_) window.draw(heatmapTiles_);
+    profiler_.endPhase(FrameProfiler::Series::BoardDraw);
 
-    // Highlights the tile the AI is currently working on
+    // Highlights the tile the AI is currently working on; in turbo it moves
+    // too fast to follow and the progress line stands in for it
     int hx = board.getHighlightX();
     int hy = board.getHighlightY();
-    if (hx >= 0 && hy >= 0) {
+    if (hx >= 0 && hy >= 0 && !(turbo() && AISolveEnabled_)) {
         sf::RectangleShape highlight;
         highlight.setSize({TILE_SIZE, TILE_SIZE});
         highlight.setFillColor(sf::Color(255, 255, 0, 50));
@@ -212,6 +473,16 @@ void Game::render() {
         window.draw(highlight);
     }
 
+    // Marks the guess continuous mode is waiting on
+    if (solverResult_ && !solverResult_->proven && solverResult_->move.action == SolverMove::Action::RevealTile) {
+        sf::RectangleShape guess({TILE_SIZE - 5.f, TILE_SIZE - 5.f});
+        guess.setFillColor(sf::Color::Transparent);
+        guess.setOutlineColor(sf::Color(255, 140, 0));
+        guess.setOutlineThickness(2.f);
+        guess.setPosition(solverResult_->move.x * TILE_SIZE + 2.f, solverResult_->move.y * TILE_SIZE + 2.f);
+        window.draw(guess);
+    }
+
     // Draw UI elements
     window.draw(restartButton_);
     window.draw(smileFace_);
@@ -224,6 +495,10 @@ void Game::render() {
     window.draw(flagCountText_);
     window.draw(AIButton_);
     window.draw(AIButtonText_);
+    window.draw(heatmapButton_);
+    window.draw(heatmapButtonText_);
+    window.draw(speedButton_);
+    window.draw(speedButtonText_);
 
     // Draw win/lose message
     if (state_ == GameState::WIN || state_ == GameState::LOSE) {
@@ -244,10 +519,51 @@ void Game::render() {
         window.draw(msg);
         
         // Reset AI state if game is over
-        AISolveEnabled_ = false;
-        AIButtonText_.setString("AI: OFF");
-        AIButton_.setFillColor(sf::Color(200, 200, 200));
+        if (AISolveEnabled_) setAISolveEnabled(false);
     }
 
+    if (turbo() && turboMoves_ > 0) drawTurboProgress();
+    if (profilerVisible_) drawProfiler();
+    profiler_.endPhase(FrameProfiler::Series::UiDraw);
+
     window.display();
-}
\ No newline at end of file
+    profiler_.endPhase(FrameProfiler::Series::Display);
+}
+
+// Draws the rolling p50/p99 table in the top-left corner
+void Game::drawProfiler() {
+    if (profilerRefreshClock_.getElapsedTime() >= sf::milliseconds(250)) {
+        profilerRefreshClock_.restart();
+        profilerText_.setString(profiler_.overlayText());
+
+        auto b = profilerText_.getLocalBounds();
+        profilerBackground_.setSize({b.left + b.width + 8.f, b.top + b.height + 8.f});
+    }
+    window.draw(profilerBackground_);
+    window.draw(profilerText_);
+}
+// Draws the turbo summary in the top-right corner: moves made since the AI
+// was switched on, their rate, and how much of the board is cleared
+void Game::drawTurboProgress() {
+    if (turboRefreshClock_.getElapsedTime() >= sf::milliseconds(250)) {
+        turboRefreshClock_.restart();
+
+        int revealed = 0;
+        for (int y = 0; y < rows_; ++y) {
+            for (int x = 0; x < cols_; ++x) revealed += board.isRevealed(x, y);
+        }
+        const int   safe    = rows_ * cols_ - numMines_;
+        const float seconds = std::max(turboClock_.getElapsedTime().asSeconds(), 0.001f);
+        turboText_.setString(std::to_string(turboMoves_) + " moves  "
+                             + std::to_string(std::lround(turboMoves_ / seconds)) + "/s  "
+                             + std::to_string(100 * revealed / safe) + "% cleared");
+
+        auto b = turboText_.getLocalBounds();
+        const float worldW = cols_ * TILE_SIZE;
+        turboBackground_.setSize({b.left + b.width + 8.f, b.top + b.height + 8.f});
+        turboBackground_.setPosition(worldW - 4.f - turboBackground_.getSize().x, 4.f);
+        turboText_.setPosition(turboBackground_.getPosition().x + 4.f, 6.f);
+    }
+    window.draw(turboBackground_);
+    window.draw(turboText_);
+}
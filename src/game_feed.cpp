@@ -0,0 +1,186 @@
+#include "GameFeed.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kQueueCapacity = 1 << 15;
+
+}  // namespace
+
+GameFeed::Seat::Seat(const Config& config, std::unique_ptr<Strategy> s)
+: board(config.rows, config.cols, 1.f, config.mines, config.seed)
+, strategy(std::move(s)) {
+    board.setJournaling(false);
+}
+
+GameFeed::GameFeed(const Config& config)
+: config_(config) {
+    if (config_.rows < 3 || config_.cols < 3 || config_.mines < 0
+        || config_.mines > config_.rows * config_.cols - 9
+        || config_.boards < 1 || config_.boards > 0xFFFF || config_.threads < 1) {
+        throw std::runtime_error("game feed config error");
+    }
+
+    const std::vector<StrategyInfo>& registry = strategyRegistry();
+    const auto info = std::find_if(registry.begin(), registry.end(),
+                                   [&](const StrategyInfo& s) { return s.name == config_.strategy; });
+    if (info == registry.end()) throw std::runtime_error("game feed strategy error");
+
+    for (int b = 0; b < config_.boards; ++b) {
+        seats_.push_back(std::make_unique<Seat>(config_, info->create()));
+    }
+
+    const int threads = std::min(config_.threads, config_.boards);
+    for (int t = 0; t < threads; ++t) {
+        workers_.push_back(std::make_unique<Worker>(kQueueCapacity));
+        for (int b = t; b < config_.boards; b += threads) workers_.back()->seats.push_back(b);
+    }
+    for (auto& w : workers_) w->thread = std::thread(&GameFeed::run, this, std::ref(*w));
+}
+
+GameFeed::~GameFeed() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& w : workers_) w->thread.join();
+}
+
+std::size_t GameFeed::drain(std::vector<Update>& out, std::size_t max) {
+    std::size_t n = 0;
+    Update u;
+    for (auto& w : workers_) {
+        while (n < max && w->queue.pop(u)) {
+            out.push_back(u);
+            ++n;
+        }
+    }
+    return n;
+}
+
+const GameFeed::Config& GameFeed::config() const {
+    return config_;
+}
+
+void GameFeed::run(Worker& worker) {
+    for (int b : worker.seats) startGame(b, worker);
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        Clock::time_point wakeAt;
+        if (!flush(worker)) {
+            // The consumer is behind; hold every board until it catches up
+            wakeAt = Clock::now() + std::chrono::milliseconds(1);
+        } else {
+            const Clock::time_point now = Clock::now();
+            wakeAt = Clock::time_point::max();
+            for (int b : worker.seats) {
+                Seat& seat = *seats_[b];
+                if (seat.due <= now) {
+                    if (seat.over) startGame(b, worker);
+                    else           playMove(b, worker);
+                }
+                wakeAt = std::min(wakeAt, seat.due);
+            }
+            if (wakeAt <= Clock::now()) continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait_until(lock, wakeAt, [&] { return stop_.load(); });
+    }
+}
+
+// Deals the board's next game, publishes it whole and plays the opening
+// click at the center
+void GameFeed::startGame(int b, Worker& worker) {
+    Seat& seat = *seats_[b];
+    const std::uint32_t seed = config_.seed + static_cast<std::uint32_t>(b)
+                             + seat.game * static_cast<std::uint32_t>(config_.boards);
+    ++seat.game;
+
+    seat.board.reset(config_.rows, config_.cols, config_.mines, seed);
+    seat.strategy->newGame(config_.rows, config_.cols, config_.mines);
+    seat.queued.clear();
+    seat.next  = 0;
+    seat.moves = 0;
+    seat.over  = false;
+
+    const auto board = static_cast<std::uint16_t>(b);
+    worker.backlog.push_back({Update::Kind::NewGame, 0, board, seed});
+    for (int y = 0; y < config_.rows; ++y) {
+        for (int x = 0; x < config_.cols; ++x) {
+            const std::uint8_t c = seat.board.cellAt(x, y);
+            if (c) worker.backlog.push_back({Update::Kind::Tile, c, board, static_cast<std::uint32_t>(y * config_.cols + x)});
+        }
+    }
+
+    worker.changes.clear();
+    seat.board.reveal(config_.cols / 2, config_.rows / 2, &worker.changes);
+    for (const CellChange& c : worker.changes) {
+        worker.backlog.push_back({Update::Kind::Tile, c.after, board, static_cast<std::uint32_t>(c.index)});
+    }
+
+    seat.due = Clock::now() + config_.moveDelay;
+    if (seat.board.isCleared()) {
+        seat.over = true;
+        seat.due  = Clock::now() + config_.holdTime;
+        worker.backlog.push_back({Update::Kind::Won, 0, board, 0});
+    }
+}
+
+// Plays the board's next queued move, asking the strategy for more when
+// none are left
+void GameFeed::playMove(int b, Worker& worker) {
+    Seat& seat = *seats_[b];
+    const auto board = static_cast<std::uint16_t>(b);
+
+    auto finish = [&](Update::Kind outcome) {
+        seat.over = true;
+        seat.due  = Clock::now() + config_.holdTime;
+        worker.backlog.push_back({outcome, 0, board, 0});
+    };
+
+    if (seat.next == seat.queued.size()) {
+        seat.queued.clear();
+        seat.next = 0;
+        // A strategy that keeps toggling flags never finishes; cap the moves
+        if (seat.moves < 4 * config_.rows * config_.cols) {
+            seat.strategy->nextMoves(seat.board.view(), seat.queued);
+        }
+        if (seat.queued.empty()) {
+            finish(Update::Kind::Stuck);
+            return;
+        }
+    }
+
+    const StrategyMove move = seat.queued[seat.next++];
+    ++seat.moves;
+
+    worker.changes.clear();
+    bool hit = false;
+    switch (move.action) {
+        case StrategyMove::Action::Reveal: hit = seat.board.reveal(move.x, move.y, &worker.changes); break;
+        case StrategyMove::Action::Chord:  hit = seat.board.chord(move.x, move.y, &worker.changes);  break;
+        case StrategyMove::Action::Flag:   seat.board.flag(move.x, move.y, &worker.changes);         break;
+    }
+    for (const CellChange& c : worker.changes) {
+        worker.backlog.push_back({Update::Kind::Tile, c.after, board, static_cast<std::uint32_t>(c.index)});
+    }
+
+    seat.due = Clock::now() + config_.moveDelay;
+    if (hit)                          finish(Update::Kind::Lost);
+    else if (seat.board.isCleared())  finish(Update::Kind::Won);
+}
+
+// Moves the backlog into the queue; false if it did not all fit
+bool GameFeed::flush(Worker& worker) {
+    for (; worker.sent < worker.backlog.size(); ++worker.sent) {
+        Update u = worker.backlog[worker.sent];
+        if (!worker.queue.push(std::move(u))) return false;
+    }
+    worker.backlog.clear();
+    worker.sent = 0;
+    return true;
+}
@@ -0,0 +1,396 @@
+#include "GameServer.hpp"
+#include "BoardView.hpp"
+#include "Solver.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Stop reading from a client that is not draining its responses
+constexpr std::size_t   MAX_PENDING_OUTPUT  = 4u << 20;
+// Board copies held by queued and running hints, across all clients
+constexpr std::size_t   MAX_HINT_BYTES      = 64u << 20;
+constexpr std::size_t   READ_CHUNK          = 64u << 10;
+constexpr std::uint16_t NO_COORD            = 0xFFFF;
+
+bool setNonBlocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void replyStatus(std::vector<std::uint8_t>& out, std::uint32_t tag, proto::Status status) {
+    proto::endFrame(out, proto::beginFrame(out, tag, static_cast<std::uint8_t>(status)));
+}
+
+}  // namespace
+
+GameServer::GameServer(const Config& config)
+: config_(config) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (config_.socketPath.empty() || config_.socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Server socket path error");
+    }
+    std::memcpy(addr.sun_path, config_.socketPath.c_str(), config_.socketPath.size() + 1);
+
+    // Replace a stale socket left by a previous run, but never a regular file
+    struct stat st;
+    if (stat(config_.socketPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(config_.socketPath.c_str());
+    }
+
+    int wake[2] = {-1, -1};
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0
+        || bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || listen(listenFd_, SOMAXCONN) != 0
+        || !setNonBlocking(listenFd_)
+        || pipe(wake) != 0
+        || !setNonBlocking(wake[0])
+        || !setNonBlocking(wake[1])) {
+        if (listenFd_ >= 0) close(listenFd_);
+        if (wake[0] >= 0)   close(wake[0]);
+        if (wake[1] >= 0)   close(wake[1]);
+        throw std::runtime_error("Server socket error");
+    }
+    wakeRead_  = wake[0];
+    wakeWrite_ = wake[1];
+
+    for (int t = 0; t < std::max(1, config_.hintThreads); ++t) {
+        hintWorkers_.emplace_back(&GameServer::hintLoop, this);
+    }
+}
+
+GameServer::~GameServer() {
+    {
+        std::lock_guard<std::mutex> lock(hintMutex_);
+        hintsStopping_ = true;
+    }
+    hintReady_.notify_all();
+    for (auto& w : hintWorkers_) w.join();
+
+    for (auto& entry : connections_) close(entry.second.fd);
+    close(listenFd_);
+    close(wakeRead_);
+    close(wakeWrite_);
+    unlink(config_.socketPath.c_str());
+}
+
+void GameServer::run() {
+    std::vector<pollfd>         fds;
+    std::vector<std::uint64_t>  ids;
+
+    while (!stopping_.load()) {
+        fds.clear();
+        ids.clear();
+        fds.push_back({wakeRead_, POLLIN, 0});
+        fds.push_back({listenFd_, POLLIN, 0});
+        for (const auto& entry : connections_) {
+            const Connection& c = entry.second;
+            const std::size_t pending = c.out.size() - c.outSent;
+            short events = 0;
+            if (pending < MAX_PENDING_OUTPUT) events |= POLLIN;
+            if (pending > 0)                  events |= POLLOUT;
+            fds.push_back({c.fd, events, 0});
+            ids.push_back(entry.first);
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Server poll error");
+        }
+
+        if (fds[0].revents) {
+            char drain[256];
+            while (read(wakeRead_, drain, sizeof(drain)) > 0) {}
+            collectHints();
+        }
+        if (fds[1].revents & POLLIN) acceptClients();
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const short revents = fds[i + 2].revents;
+            auto it = connections_.find(ids[i]);
+            if (!revents || it == connections_.end()) continue;
+
+            bool alive = true;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) alive = readFrom(it->first, it->second);
+            if (alive && (revents & POLLOUT))           alive = flush(it->second);
+            if (!alive) {
+                close(it->second.fd);
+                connections_.erase(it);
+            }
+        }
+    }
+}
+
+void GameServer::stop() {
+    stopping_.store(true);
+    wake();
+}
+
+int GameServer::liveSessions() const {
+    return liveSessions_.load();
+}
+
+void GameServer::acceptClients() {
+    while (true) {
+        const int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) return;                     // EAGAIN, or a client gave up
+        if (!setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        connections_.emplace(nextConnection_++, Connection{fd, {}, {}, 0, 0});
+    }
+}
+
+// Reads what is available (bounded, for fairness), answers every complete
+// frame and tries to send the answers right away. False drops the client;
+// frames that arrived just before end-of-stream are still answered.
+bool GameServer::readFrom(std::uint64_t id, Connection& c) {
+    bool        open  = true;
+    std::size_t total = 0;
+    while (open && total < 4 * READ_CHUNK) {
+        const std::size_t old = c.in.size();
+        c.in.resize(old + READ_CHUNK);
+        const ssize_t n = read(c.fd, c.in.data() + old, READ_CHUNK);
+        c.in.resize(old + (n > 0 ? n : 0));
+
+        if (n > 0) {
+            total += n;
+            continue;
+        }
+        if (n == 0) {
+            open = false;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            open = false;
+        }
+    }
+
+    // Frame by frame; a malformed size means the stream is unrecoverable
+    std::size_t pos = 0;
+    while (c.in.size() - pos >= 4) {
+        const std::uint32_t size = proto::loadU32(c.in.data() + pos);
+        if (size < proto::HEADER_SIZE - 4 || size > proto::MAX_BODY_SIZE) return false;
+        if (c.in.size() - pos - 4 < size) break;
+
+        handleFrame(id, c.in.data() + pos + 4, size, c.out);
+        pos += 4 + size;
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + pos);
+
+    return flush(c) && open;
+}
+
+bool GameServer::flush(Connection& c) {
+    while (c.outSent < c.out.size()) {
+        const ssize_t n = send(c.fd, c.out.data() + c.outSent, c.out.size() - c.outSent, MSG_NOSIGNAL);
+        if (n > 0) {
+            c.outSent += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+
+    if (c.outSent == c.out.size()) {
+        c.out.clear();
+        c.outSent = 0;
+    } else if (c.outSent > c.out.size() / 2) {
+        c.out.erase(c.out.begin(), c.out.begin() + c.outSent);
+        c.outSent = 0;
+    }
+    return true;
+}
+
+// Answers one request (everything after the size field) into out
+void GameServer::handleFrame(std::uint64_t id, const std::uint8_t* body, std::uint32_t size,
+                             std::vector<std::uint8_t>& out) {
+    proto::Reader r{body, body + size};
+    const std::uint32_t tag = r.u32();
+    const auto          op  = static_cast<proto::Op>(r.u8());
+
+    switch (op) {
+        case proto::Op::NewGame: {
+            const int           rows  = r.u16();
+            const int           cols  = r.u16();
+            const std::uint32_t mines = r.u32();
+            const std::uint8_t  flags = r.u8();
+            std::uint32_t       seed  = r.u32();
+            if (!r.ok || rows < 1 || rows > proto::MAX_DIMENSION || cols < 1
+                || cols > proto::MAX_DIMENSION
+                || static_cast<std::int64_t>(mines) > static_cast<std::int64_t>(rows) * cols - 9) {
+                replyStatus(out, tag, proto::Status::BadArguments);
+                return;
+            }
+
+            const std::uint32_t session = sessions_.create();
+            if (session == SessionPool::INVALID_ID) {
+                replyStatus(out, tag, proto::Status::ServerFull);
+                return;
+            }
+            if (!(flags & proto::NEW_GAME_USE_SEED)) seed = seedSource_();
+            sessions_.find(session)->start(rows, cols, static_cast<int>(mines), seed, scratch_);
+            liveSessions_.store(sessions_.liveCount());
+
+            const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(proto::Status::Ok));
+            proto::putU32(out, session);
+            proto::putU32(out, seed);
+            proto::endFrame(out, f);
+            return;
+        }
+
+        case proto::Op::Reveal:
+        case proto::Op::Flag:
+        case proto::Op::Chord: {
+            const std::uint32_t session = r.u32();
+            const int           x       = r.u16();
+            const int           y       = r.u16();
+            Session* s = r.ok ? sessions_.find(session) : nullptr;
+            if (!s) {
+                replyStatus(out, tag, r.ok ? proto::Status::UnknownSession : proto::Status::BadArguments);
+                return;
+            }
+
+            rules::RevealResult result;
+            if (op == proto::Op::Reveal)     result = s->reveal(x, y, scratch_);
+            else if (op == proto::Op::Chord) result = s->chord(x, y, scratch_);
+            else                             s->flag(x, y);
+
+            const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(proto::Status::Ok));
+            proto::putU8(out, static_cast<std::uint8_t>(s->status));
+            proto::putU32(out, static_cast<std::uint32_t>(result.opened));
+            proto::putU32(out, static_cast<std::uint32_t>(s->safeHidden));
+            proto::endFrame(out, f);
+            return;
+        }
+
+        case proto::Op::Hint: {
+            const std::uint32_t session = r.u32();
+            Session* s = r.ok ? sessions_.find(session) : nullptr;
+            if (!s) {
+                replyStatus(out, tag, r.ok ? proto::Status::UnknownSession : proto::Status::BadArguments);
+                return;
+            }
+
+            Connection& c = connections_.at(id);
+            if (c.hints >= proto::MAX_PENDING_HINTS || hintBytes_ + s->cells.size() > MAX_HINT_BYTES) {
+                replyStatus(out, tag, proto::Status::ServerFull);
+                return;
+            }
+            ++c.hints;
+            hintBytes_ += s->cells.size();
+
+            // The solver gets a copy, so the game can move on meanwhile
+            {
+                std::lock_guard<std::mutex> lock(hintMutex_);
+                hintJobs_.push_back({id, tag, s->rows, s->cols, s->cells});
+            }
+            hintReady_.notify_one();
+            return;
+        }
+
+        case proto::Op::State: {
+            const std::uint32_t session = r.u32();
+            Session* s = r.ok ? sessions_.find(session) : nullptr;
+            if (!s) {
+                replyStatus(out, tag, r.ok ? proto::Status::UnknownSession : proto::Status::BadArguments);
+                return;
+            }
+
+            const BoardView view(s->rows, s->cols, s->cells.data());
+            const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(proto::Status::Ok));
+            proto::putU8(out, static_cast<std::uint8_t>(s->status));
+            proto::putU16(out, static_cast<std::uint16_t>(s->rows));
+            proto::putU16(out, static_cast<std::uint16_t>(s->cols));
+            for (int y = 0; y < s->rows; ++y) {
+                for (int x = 0; x < s->cols; ++x) proto::putU8(out, view.cellAt(x, y));
+            }
+            proto::endFrame(out, f);
+            return;
+        }
+
+        case proto::Op::Close: {
+            const std::uint32_t session = r.u32();
+            const bool closed = r.ok && sessions_.destroy(session);
+            liveSessions_.store(sessions_.liveCount());
+            replyStatus(out, tag, closed ? proto::Status::Ok
+                                  : r.ok ? proto::Status::UnknownSession
+                                         : proto::Status::BadArguments);
+            return;
+        }
+    }
+
+    replyStatus(out, tag, proto::Status::UnknownOp);
+}
+
+// Hands finished hints to their connections, if still open
+void GameServer::collectHints() {
+    std::vector<HintDone> done;
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        done.swap(hintsDone_);
+    }
+
+    for (HintDone& h : done) {
+        hintBytes_ -= h.bytes;
+        auto it = connections_.find(h.connection);
+        if (it == connections_.end()) continue;
+
+        Connection& c = it->second;
+        --c.hints;
+        c.out.insert(c.out.end(), h.frame.begin(), h.frame.end());
+        if (!flush(c)) {
+            close(c.fd);
+            connections_.erase(it);
+        }
+    }
+}
+
+void GameServer::hintLoop() {
+    while (true) {
+        HintJob job;
+        {
+            std::unique_lock<std::mutex> lock(hintMutex_);
+            hintReady_.wait(lock, [&] { return hintsStopping_ || !hintJobs_.empty(); });
+            if (hintsStopping_) return;
+            job = std::move(hintJobs_.front());
+            hintJobs_.pop_front();
+        }
+
+        const SolverMove move = findSolverMove(BoardView(job.rows, job.cols, job.cells.data()));
+        const bool found = move.action != SolverMove::Action::None;
+
+        HintDone done{job.connection, job.cells.size(), {}};
+        const std::size_t f = proto::beginFrame(done.frame, job.tag, static_cast<std::uint8_t>(proto::Status::Ok));
+        proto::putU8(done.frame, static_cast<std::uint8_t>(move.action));
+        proto::putU16(done.frame, found ? static_cast<std::uint16_t>(move.x) : NO_COORD);
+        proto::putU16(done.frame, found ? static_cast<std::uint16_t>(move.y) : NO_COORD);
+        proto::endFrame(done.frame, f);
+
+        {
+            std::lock_guard<std::mutex> lock(doneMutex_);
+            hintsDone_.push_back(std::move(done));
+        }
+        wake();
+    }
+}
+
+// A full pipe already guarantees a wakeup, so a failed write is fine
+void GameServer::wake() {
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t n = write(wakeWrite_, &byte, 1);
+}
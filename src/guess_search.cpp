@@ -0,0 +1,238 @@
+#include "GuessSearch.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace {
+
+// The k hidden tiles least likely to be mines, safest first; ties go to
+// the lower index. Known mines and UNKNOWN tiles are skipped.
+void lowestRisk(const std::vector<float>& probabilities, int k, std::vector<int>& out) {
+    out.clear();
+    for (int i = 0; i < static_cast<int>(probabilities.size()); ++i) {
+        const float p = probabilities[i];
+        if (p >= 0.f && p < 1.f) out.push_back(i);
+    }
+    auto safer = [&](int a, int b) {
+        return probabilities[a] < probabilities[b] || (probabilities[a] == probabilities[b] && a < b);
+    };
+    const std::size_t keep = std::min(out.size(), static_cast<std::size_t>(std::max(k, 1)));
+    std::partial_sort(out.begin(), out.begin() + keep, out.end(), safer);
+    out.resize(keep);
+}
+
+}  // namespace
+
+// One worker's state: a private copy of the board that hypothetical
+// reveals are written into and undone, and a private probability cache.
+struct GuessSearch::Searcher {
+    GuessSearch&                owner;
+    MineProbability             probability;
+    std::vector<std::uint8_t>   cells;
+    int                         rows        = 0;
+    int                         cols        = 0;
+    int                         mines       = 0;
+    Clock::time_point           deadline;
+    bool                        expired     = false;
+
+    explicit Searcher(GuessSearch& o) : owner(o) {}
+
+    // Layout count and value of the position in cells
+    Entry evaluate(std::uint64_t hash, int depth) {
+        Entry e;
+        if (owner.lookup(hash, depth, e)) return e;
+
+        // MineProbability only looks at the clock inside large components
+        std::vector<float> p;
+        if (Clock::now() >= deadline
+            || !probability.compute(BoardView(rows, cols, cells.data()), mines, p, deadline)) {
+            expired = true;
+            return e;
+        }
+        e.logLayouts = probability.lastStats().logLayouts;
+        e.depth      = depth;
+        e.value      = 1.f;
+
+        std::vector<int> candidates;
+        lowestRisk(p, depth > 0 ? owner.config_.candidates : 1, candidates);
+        if (!candidates.empty() && p[candidates.front()] > 0.f) {
+            if (depth == 0) {
+                e.value = 1.f - p[candidates.front()];
+            } else {
+                float best = 0.f;
+                for (int t : candidates) {
+                    const float s = score(t, p[t], hash, depth - 1);
+                    if (expired) return e;
+                    best = std::max(best, s);
+                }
+                e.value = best;
+            }
+        }
+        owner.store(hash, e);
+        return e;
+    }
+
+    // P(safe) * expected value once tile shows its number. Every number the
+    // tile could show is tried in place; its weight is the count of layouts
+    // that agree with it.
+    float score(int tile, float mineChance, std::uint64_t hash, int depth) {
+        const int x = tile % cols;
+        const int y = tile / cols;
+        int flagged = 0;
+        int hidden  = 0;
+        rules::forEachNeighbor(BoardView(rows, cols, cells.data()), x, y, [&](int nx, int ny) {
+            const std::uint8_t n = cells[ny * cols + nx];
+            if (n & cell::FLAGGED) ++flagged;
+            else if (!(n & cell::REVEALED)) ++hidden;
+        });
+
+        const std::uint8_t saved = cells[tile];
+        double logLayouts[9];
+        float  values[9];
+        double top = -std::numeric_limits<double>::infinity();
+        for (int n = flagged; n <= flagged + hidden; ++n) {
+            cells[tile] = static_cast<std::uint8_t>(cell::REVEALED | n << cell::ADJ_SHIFT);
+            const Entry child = evaluate(hash ^ owner.key(tile, 1 + n), depth);
+            if (expired) break;
+            logLayouts[n] = child.logLayouts;
+            values[n]     = child.value;
+            top = std::max(top, child.logLayouts);
+        }
+        cells[tile] = saved;
+        if (expired || std::isinf(top)) return 0.f;
+
+        double weight = 0.0;
+        double value  = 0.0;
+        for (int n = flagged; n <= flagged + hidden; ++n) {
+            const double w = std::exp(logLayouts[n] - top);
+            weight += w;
+            value  += w * values[n];
+        }
+        return static_cast<float>((1.0 - mineChance) * value / weight);
+    }
+};
+
+GuessSearch::GuessSearch()
+: GuessSearch(Config{}) {}
+
+GuessSearch::GuessSearch(const Config& config)
+: config_(config) {
+    if (config_.depth < 0)      config_.depth      = 0;
+    if (config_.candidates < 1) config_.candidates = 1;
+    if (config_.threads < 1)    config_.threads    = 1;
+    for (int t = 0; t < config_.threads; ++t) searchers_.push_back(std::make_unique<Searcher>(*this));
+}
+
+GuessSearch::~GuessSearch() = default;
+
+std::size_t GuessSearch::tableSize() const {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    return table_.size();
+}
+
+std::uint64_t GuessSearch::tableHits() const {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    return hits_;
+}
+
+bool GuessSearch::lookup(std::uint64_t hash, int depth, Entry& out) {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    auto it = table_.find(hash);
+    if (it == table_.end() || it->second.depth < depth) return false;
+    out = it->second;
+    ++hits_;
+    return true;
+}
+
+void GuessSearch::store(std::uint64_t hash, const Entry& entry) {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    if (table_.size() >= MAX_TABLE_SIZE) table_.clear();
+    Entry& slot = table_[hash];
+    if (entry.depth >= slot.depth) slot = entry;
+}
+
+GuessSearch::Choice GuessSearch::choose(const BoardView& view, int mines,
+                                        const std::vector<float>& probabilities,
+                                        Clock::time_point deadline) {
+    const int rows = view.rows();
+    const int cols = view.cols();
+    const int N    = rows * cols;
+
+    // A new board shape or mine count starts a new table
+    if (rows != rows_ || cols != cols_ || mines != mines_) {
+        rows_  = rows;
+        cols_  = cols;
+        mines_ = mines;
+        std::mt19937_64 rng(0x9E3779B97F4A7C15ull);
+        keys_.resize(static_cast<std::size_t>(N) * 10);
+        for (std::uint64_t& k : keys_) k = rng();
+        std::lock_guard<std::mutex> lock(tableMutex_);
+        table_.clear();
+    }
+
+    Choice choice;
+    std::vector<int> candidates;
+    lowestRisk(probabilities, config_.candidates, candidates);
+    if (candidates.empty()) return choice;
+    choice.tile       = candidates.front();
+    choice.mineChance = probabilities[choice.tile];
+    choice.value      = 1.f - choice.mineChance;
+    if (candidates.size() == 1) return choice;
+
+    std::vector<std::uint8_t> cells(N);
+    std::uint64_t hash = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const int i = y * cols + x;
+            const std::uint8_t t = view.cellAt(x, y);
+            cells[i] = t;
+            if (t & cell::FLAGGED)       hash ^= key(i, 0);
+            else if (t & cell::REVEALED) hash ^= key(i, 1 + cell::adjacent(t));
+        }
+    }
+
+    // Workers claim candidates safest first, so a short budget still
+    // covers the likeliest answers
+    const int K = static_cast<int>(candidates.size());
+    std::vector<float> scores(K, -1.f);
+    std::atomic<int> next{0};
+    auto work = [&](Searcher& s) {
+        s.cells    = cells;
+        s.rows     = rows;
+        s.cols     = cols;
+        s.mines    = mines;
+        s.deadline = deadline;
+        s.expired  = false;
+        for (int i = next++; i < K; i = next++) {
+            const int t = candidates[i];
+            const float v = s.score(t, probabilities[t], hash, config_.depth);
+            if (s.expired) break;
+            scores[i] = v;
+        }
+    };
+
+    const int T = std::min(config_.threads, K);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < T; ++t) workers.emplace_back(work, std::ref(*searchers_[t]));
+    work(*searchers_[0]);
+    for (std::thread& w : workers) w.join();
+
+    // Another tile has to beat the safest one's score, not its bare odds
+    for (int i = 0; i < K; ++i) {
+        if (scores[i] >= 0.f) ++choice.searched;
+    }
+    if (scores[0] < 0.f) return choice;
+    for (int i = 0; i < K; ++i) {
+        if (i == 0 || scores[i] > choice.value) {
+            choice.tile       = candidates[i];
+            choice.mineChance = probabilities[candidates[i]];
+            choice.value      = scores[i];
+        }
+    }
+    return choice;
+}
@@ -0,0 +1,63 @@
+#include "HeatmapWorker.hpp"
+
+HeatmapWorker::HeatmapWorker()
+: requests_(16)
+, results_(4)
+, thread_(&HeatmapWorker::run, this) {}
+
+HeatmapWorker::~HeatmapWorker() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+bool HeatmapWorker::submit(BoardFork board, int mines, std::uint64_t generation) {
+    if (!requests_.push({std::move(board), mines, generation})) return false;
+
+    // Same lost-wakeup guard as SolverWorker::submit
+    { std::lock_guard<std::mutex> lock(wakeMutex_); }
+    wake_.notify_one();
+    return true;
+}
+
+bool HeatmapWorker::poll(Result& out) {
+    return results_.pop(out);
+}
+
+void HeatmapWorker::run() {
+    MineProbability           probability;
+    Request                   request;
+    std::vector<std::uint8_t> cells;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait(lock, [&] { return stop_ || !requests_.empty(); });
+            if (stop_) return;
+        }
+
+        // Skip to the newest board
+        bool pending = false;
+        while (requests_.pop(request)) pending = true;
+        if (!pending) continue;
+
+        const int rows = request.board.rows();
+        const int cols = request.board.cols();
+        cells.resize(static_cast<std::size_t>(rows) * cols);
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) cells[y * cols + x] = request.board.cellAt(x, y);
+        }
+
+        Result result;
+        probability.compute(BoardView(rows, cols, cells.data()), request.mines, result.probabilities);
+        result.stats      = probability.lastStats();
+        result.generation = request.generation;
+
+        while (!results_.push(std::move(result))) {
+            if (stop_) return;
+            std::this_thread::yield();
+        }
+    }
+}
@@ -1,7 +1,15 @@
+#include "Dashboard.hpp"
 #include "Game.hpp"
+#include "Stats.hpp"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -13,6 +21,11 @@ void printUsage(const char* prog) {
         << "  " << prog << "                        # medium (default)\n"
         << "  " << prog << " easy | medium | hard\n"
         << "  " << prog << " <rows> <cols> <mines>\n"
+        << "  " << prog << " ... --record <file>    # append every game to a move log\n"
+        << "  " << prog << " ... --stats <file>     # write hot-path counters on exit (.json or .csv)\n"
+        << "  " << prog << " ... --profile <file>   # write frame-time percentiles on exit (CSV)\n"
+        << "  " << prog << " ... --turbo-slice <ms> # frame time the MAX AI speed may use (default 8)\n"
+        << "  " << prog << " ... --dashboard <n>    # watch n AI games at once in one window (1..256)\n"
         << "\n"
         << "Constraints: rows >= 3, cols >= 3, 0 < mines <= rows*cols - 9\n";
 }
@@ -48,16 +61,115 @@ bool parseArgs(int argc, char** argv, Difficulty& out) {
     return false;
 }
 
+// Removes "<option> <file>" from the argument list, storing the path.
+bool extractPathOption(std::vector<char*>& args, const std::string& option, std::string& path) {
+    for (auto it = args.begin(); it != args.end(); ++it) {
+        if (std::string(*it) != option) continue;
+        if (it + 1 == args.end()) return false;
+        path = *(it + 1);
+        args.erase(it, it + 2);
+        return true;
+    }
+    return true;
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    std::string recordPath;
+    std::string statsPath;
+    std::string profilePath;
+    std::string turboSliceArg;
+    std::string dashboardArg;
+
     Difficulty d;
-    if (!parseArgs(argc, argv, d)) {
+    if (!extractPathOption(args, "--record", recordPath)
+        || !extractPathOption(args, "--stats", statsPath)
+        || !extractPathOption(args, "--profile", profilePath)
+        || !extractPathOption(args, "--turbo-slice", turboSliceArg)
+        || !extractPathOption(args, "--dashboard", dashboardArg)
+        || !parseArgs(static_cast<int>(args.size()), args.data(), d)) {
         printUsage(argv[0]);
         return 1;
     }
 
-    Game game(d.rows, d.cols, d.mines);
+    int turboSliceMs = 8;
+    if (!turboSliceArg.empty()) {
+        try {
+            turboSliceMs = std::stoi(turboSliceArg);
+        } catch (...) { turboSliceMs = 0; }
+        if (turboSliceMs < 1 || turboSliceMs > 1000) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int dashboardBoards = 0;
+    if (!dashboardArg.empty()) {
+        try {
+            dashboardBoards = std::stoi(dashboardArg);
+        } catch (...) { dashboardBoards = 0; }
+        if (dashboardBoards < 1 || dashboardBoards > 256) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Dashboard mode: headless AI games only, so no move log
+    if (dashboardBoards > 0) {
+        GameFeed::Config config;
+        config.rows    = d.rows;
+        config.cols    = d.cols;
+        config.mines   = d.mines;
+        config.boards  = dashboardBoards;
+        config.seed    = std::random_device{}();
+        config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() - 1));
+
+        Dashboard dashboard(config);
+        dashboard.run();
+        if (!profilePath.empty()) {
+            std::ofstream out(profilePath, std::ios::trunc);
+            dashboard.profiler().writeReport(out);
+        }
+        return 0;
+    }
+
+    std::ofstream                   recordFile;
+    std::unique_ptr<MoveLogWriter>  moveLog;
+    if (!recordPath.empty()) {
+        recordFile.open(recordPath, std::ios::binary | std::ios::trunc);
+        if (!recordFile) {
+            std::cerr << "Cannot open " << recordPath << " for writing\n";
+            return 1;
+        }
+        moveLog = std::make_unique<MoveLogWriter>(recordFile);
+    }
+
+    if (!statsPath.empty()) {
+        if (!MINESWEEPER_STATS) {
+            std::cerr << "Stats are compiled out of this build; " << statsPath << " will be all zeros\n";
+        }
+        stats::setEnabled(true);
+    }
+
+    Game game(d.rows, d.cols, d.mines, moveLog.get(), sf::milliseconds(turboSliceMs));
     game.run();
+
+    if (!profilePath.empty()) {
+        std::ofstream out(profilePath, std::ios::trunc);
+        game.profiler().writeReport(out);
+    }
+
+    if (!statsPath.empty()) {
+        std::ofstream out(statsPath, std::ios::trunc);
+        const bool csv = statsPath.size() >= 4
+                      && statsPath.compare(statsPath.size() - 4, 4, ".csv") == 0;
+        if (csv) {
+            stats::writeCsv(out, stats::snapshot());
+        } else {
+            stats::writeJson(out, stats::snapshot());
+        }
+    }
     return 0;
 }
@@ -0,0 +1,336 @@
+#include "MineProbability.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Backtracking over a component's tiles in order. need and left track,
+// per constraint, the mines still to place and the tiles still unassigned;
+// a branch dies as soon as one of its constraints cannot be met.
+struct Enumerator {
+    const std::vector<std::vector<int>>&    varConstraints;
+    std::vector<int>                        need;
+    std::vector<int>                        left;
+    std::vector<std::uint8_t>               value;
+    std::vector<double>&                    counts;
+    std::vector<double>&                    tileCounts;
+    MineProbability::Clock::time_point      deadline;
+    long                                    nodes       = 0;
+    int                                     mines       = 0;
+    bool                                    overflow    = false;
+    bool                                    timedOut    = false;
+
+    void run(int v) {
+        if (overflow || timedOut) return;
+        if (++nodes > MineProbability::MAX_SEARCH_NODES) {
+            overflow = true;
+            return;
+        }
+        if ((nodes & 1023) == 0 && MineProbability::Clock::now() >= deadline) {
+            timedOut = true;
+            return;
+        }
+
+        const int V = static_cast<int>(value.size());
+        if (v == V) {
+            counts[mines] += 1.0;
+            for (int u = 0; u < V; ++u) {
+                if (value[u]) tileCounts[u * (V + 1) + mines] += 1.0;
+            }
+            return;
+        }
+
+        for (int mine = 0; mine <= 1; ++mine) {
+            bool ok = true;
+            for (int c : varConstraints[v]) {
+                --left[c];
+                need[c] -= mine;
+                if (need[c] < 0 || need[c] > left[c]) ok = false;
+            }
+            if (ok) {
+                value[v] = static_cast<std::uint8_t>(mine);
+                mines += mine;
+                run(v + 1);
+                mines -= mine;
+            }
+            for (int c : varConstraints[v]) {
+                ++left[c];
+                need[c] += mine;
+            }
+        }
+    }
+};
+
+// a * b truncated to limit + 1 entries, scaled so the largest entry is 1;
+// only ratios matter and this keeps long products in range. The log of the
+// scale removed is added to logScale when given.
+std::vector<double> convolve(const std::vector<double>& a, const std::vector<double>& b, int limit,
+                             double* logScale = nullptr) {
+    const std::size_t size = std::min<std::size_t>(a.size() + b.size() - 1, limit + 1);
+    std::vector<double> r(size, 0.0);
+    for (std::size_t i = 0; i < a.size() && i < size; ++i) {
+        if (a[i] == 0.0) continue;
+        for (std::size_t j = 0; j < b.size() && i + j < size; ++j) r[i + j] += a[i] * b[j];
+    }
+
+    const double top = *std::max_element(r.begin(), r.end());
+    if (top > 0.0) {
+        for (double& v : r) v /= top;
+        if (logScale) *logScale += std::log(top);
+    }
+    return r;
+}
+
+void appendInt(std::string& key, int v) {
+    key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+}  // namespace
+
+MineProbability::Summary MineProbability::enumerate(const Component& c, Clock::time_point deadline) {
+    const int V = static_cast<int>(c.vars.size());
+    for (int v = 0; v < V; ++v) localIndex_[c.vars[v]] = v;
+
+    Summary s;
+    s.counts.assign(V + 1, 0.0);
+    s.tileCounts.assign(static_cast<std::size_t>(V) * (V + 1), 0.0);
+
+    std::vector<std::vector<int>> varConstraints(V);
+    Enumerator e{varConstraints, {}, {}, std::vector<std::uint8_t>(V), s.counts, s.tileCounts, deadline};
+    for (int ci = 0; ci < static_cast<int>(c.constraints.size()); ++ci) {
+        const int k = c.constraints[ci];
+        int tiles = 0;
+        for (int j = 0; j < 8; ++j) {
+            const int t = constraintVars_[k * 8 + j];
+            if (t < 0) break;
+            varConstraints[localIndex_[t]].push_back(ci);
+            ++tiles;
+        }
+        if (remaining_[k] < 0 || remaining_[k] > tiles) return s;     // no layout fits
+        e.need.push_back(remaining_[k]);
+        e.left.push_back(tiles);
+    }
+
+    e.run(0);
+    s.overflow = e.overflow;
+    s.timedOut = e.timedOut;
+    return s;
+}
+
+void MineProbability::compute(const BoardView& view, int mines, std::vector<float>& out) {
+    compute(view, mines, out, Clock::time_point::max());
+}
+
+bool MineProbability::compute(const BoardView& view, int mines, std::vector<float>& out,
+                              Clock::time_point deadline) {
+    const int rows = view.rows();
+    const int cols = view.cols();
+    const int N    = rows * cols;
+    out.assign(N, NOT_HIDDEN);
+    stats_ = {};
+
+    parent_.resize(N);
+    componentOf_.assign(N, -1);
+    localIndex_.resize(N);
+    placed_.assign(N, 0);
+    constraintTiles_.clear();
+    remaining_.clear();
+    constraintVars_.clear();
+    components_.clear();
+
+    auto find = [&](int i) {
+        while (parent_[i] != i) i = parent_[i] = parent_[parent_[i]];
+        return i;
+    };
+
+    // Constraints: every revealed tile with hidden neighbors. Their hidden
+    // neighbors are unioned into components.
+    int flags  = 0;
+    int hidden = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const int i = y * cols + x;
+            const std::uint8_t t = view.cellAt(x, y);
+            parent_[i] = i;
+            if (t & cell::FLAGGED) {
+                ++flags;
+            } else if (!(t & cell::REVEALED)) {
+                ++hidden;
+                out[i] = 0.f;
+            }
+        }
+    }
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const std::uint8_t t = view.cellAt(x, y);
+            if (!(t & cell::REVEALED)) continue;
+
+            int vars[8];
+            int count   = 0;
+            int flagged = 0;
+            rules::forEachNeighbor(view, x, y, [&](int nx, int ny) {
+                const std::uint8_t n = view.cellAt(nx, ny);
+                if (n & cell::FLAGGED) ++flagged;
+                else if (!(n & cell::REVEALED)) vars[count++] = ny * cols + nx;
+            });
+            if (count == 0) continue;
+
+            constraintTiles_.push_back(y * cols + x);
+            remaining_.push_back(cell::adjacent(t) - flagged);
+            for (int j = 0; j < 8; ++j) constraintVars_.push_back(j < count ? vars[j] : -1);
+            for (int j = 1; j < count; ++j) parent_[find(vars[j])] = find(vars[0]);
+        }
+    }
+
+    // Group constraints by component; tiles are numbered in the order the
+    // constraints reach them, which keeps the search local
+    for (int k = 0; k < static_cast<int>(constraintTiles_.size()); ++k) {
+        const int root = find(constraintVars_[k * 8]);
+        if (componentOf_[root] < 0) {
+            componentOf_[root] = static_cast<int>(components_.size());
+            components_.emplace_back();
+        }
+        Component& c = components_[componentOf_[root]];
+        c.constraints.push_back(k);
+        for (int j = 0; j < 8 && constraintVars_[k * 8 + j] >= 0; ++j) {
+            const int t = constraintVars_[k * 8 + j];
+            if (!placed_[t]) {
+                placed_[t] = 1;
+                c.vars.push_back(t);
+            }
+        }
+    }
+
+    // Summaries, from the cache where the constraints are unchanged
+    std::unordered_map<std::string, Summary> next;
+    std::string key;
+    for (Component& c : components_) {
+        key.clear();
+        appendInt(key, static_cast<int>(c.vars.size()));
+        for (int t : c.vars) appendInt(key, t);
+        for (int k : c.constraints) {
+            appendInt(key, constraintTiles_[k]);
+            appendInt(key, remaining_[k]);
+        }
+
+        auto cached = cache_.find(key);
+        if (cached != cache_.end()) {
+            c.summary = &next.emplace(key, std::move(cached->second)).first->second;
+            cache_.erase(cached);
+            continue;
+        }
+
+        Summary s = enumerate(c, deadline);
+        ++stats_.enumerated;
+        if (s.timedOut) {
+            // Keep what is already known for the next attempt
+            for (auto& entry : next) cache_.insert(std::move(entry));
+            for (float& p : out) {
+                if (p != NOT_HIDDEN) p = UNKNOWN;
+            }
+            return false;
+        }
+        c.summary = &next.emplace(key, std::move(s)).first->second;
+    }
+    cache_.swap(next);
+    stats_.components = static_cast<int>(components_.size());
+
+    // Over-budget components are left UNKNOWN and count as unconstrained
+    std::vector<const Component*> solved;
+    int floating = hidden;
+    for (const Component& c : components_) {
+        if (c.summary->overflow) {
+            for (int t : c.vars) out[t] = UNKNOWN;
+        } else {
+            solved.push_back(&c);
+            floating -= static_cast<int>(c.vars.size());
+        }
+    }
+
+    // No consistent layout: nothing to report, but the computation finished
+    auto giveUp = [&] {
+        for (float& p : out) {
+            if (p != NOT_HIDDEN) p = UNKNOWN;
+        }
+        return true;
+    };
+
+    const int M = mines - flags;
+    if (M < 0) return giveUp();
+
+    // prefix[i] / suffix[i]: mine-total distribution of components before
+    // i / from i on
+    const int n = static_cast<int>(solved.size());
+    std::vector<std::vector<double>> prefix(n + 1, {1.0});
+    std::vector<std::vector<double>> suffix(n + 1, {1.0});
+    double prefixScale = 0.0;
+    for (int i = 0; i < n; ++i) {
+        prefix[i + 1] = convolve(prefix[i], solved[i]->summary->counts, M, &prefixScale);
+    }
+    for (int i = n - 1; i >= 0; --i) suffix[i] = convolve(suffix[i + 1], solved[i]->summary->counts, M);
+
+    // w[s]: ways to put the other M - s mines on the floating tiles, scaled
+    const double negInf = -std::numeric_limits<double>::infinity();
+    std::vector<double> logW(M + 1, negInf);
+    double base = negInf;
+    for (int s = 0; s <= M; ++s) {
+        const int m = M - s;
+        if (m > floating) continue;
+        logW[s] = std::lgamma(floating + 1.0) - std::lgamma(m + 1.0) - std::lgamma(floating - m + 1.0);
+        base = std::max(base, logW[s]);
+    }
+    if (base == negInf) return giveUp();
+
+    std::vector<double> w(M + 1);
+    for (int s = 0; s <= M; ++s) w[s] = std::exp(logW[s] - base);
+
+    const std::vector<double>& all = prefix[n];
+    double total = 0.0;
+    double floatingMines = 0.0;
+    for (std::size_t s = 0; s < all.size(); ++s) {
+        total         += all[s] * w[s];
+        floatingMines += all[s] * w[s] * (M - static_cast<int>(s));
+    }
+    if (!(total > 0.0)) return giveUp();
+    stats_.logLayouts = std::log(total) + prefixScale + base;
+
+    if (floating > 0) {
+        const float p = static_cast<float>(floatingMines / (total * floating));
+        for (int i = 0; i < N; ++i) {
+            if (out[i] == 0.f && !placed_[i]) out[i] = p;
+        }
+    }
+
+    // Component tiles: weight each k by the ways the rest of the board
+    // can hold the other mines
+    std::vector<double> g;
+    for (int i = 0; i < n; ++i) {
+        const Component& c = *solved[i];
+        const Summary&   s = *c.summary;
+        const int V = static_cast<int>(c.vars.size());
+        const std::vector<double> rest = convolve(prefix[i], suffix[i + 1], M);
+
+        g.assign(V + 1, 0.0);
+        double z = 0.0;
+        for (int k = 0; k <= V && k <= M; ++k) {
+            for (std::size_t j = 0; j < rest.size() && k + j <= static_cast<std::size_t>(M); ++j) {
+                g[k] += rest[j] * w[k + j];
+            }
+            z += s.counts[k] * g[k];
+        }
+
+        for (int v = 0; v < V; ++v) {
+            if (!(z > 0.0)) {
+                out[c.vars[v]] = UNKNOWN;
+                continue;
+            }
+            double mine = 0.0;
+            for (int k = 0; k <= V; ++k) mine += s.tileCounts[v * (V + 1) + k] * g[k];
+            out[c.vars[v]] = static_cast<float>(std::min(1.0, std::max(0.0, mine / z)));
+        }
+    }
+    return true;
+}
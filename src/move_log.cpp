@@ -0,0 +1,200 @@
+#include "MoveLog.hpp"
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr char          kMagic[4]   = {'M', 'S', 'L', 'G'};
+constexpr std::uint8_t  kVersion    = 1;
+constexpr int           kActionBits = 3;
+constexpr std::uint64_t kMaxTiles   = 1ull << 26;   // as for board snapshots
+
+}  // namespace
+
+// =============================================================================
+// Writer
+// =============================================================================
+
+MoveLogWriter::MoveLogWriter(std::ostream& out, std::size_t bufferSize)
+: out_(out)
+, buffer_(bufferSize < 16 ? 16 : bufferSize) {
+    out_.write(kMagic, sizeof(kMagic));
+    out_.put(static_cast<char>(kVersion));
+}
+
+MoveLogWriter::~MoveLogWriter() {
+    flush();
+}
+
+void MoveLogWriter::beginGame(const GameHeader& header) {
+    putVarint(static_cast<std::uint64_t>(MoveAction::BeginGame));
+    putVarint(header.seed);
+    putVarint(static_cast<std::uint64_t>(header.rows));
+    putVarint(static_cast<std::uint64_t>(header.cols));
+    putVarint(static_cast<std::uint64_t>(header.mines));
+    cols_     = header.cols;
+    prevCell_ = 0;
+}
+
+void MoveLogWriter::reveal(int x, int y) { record(MoveAction::Reveal, y * cols_ + x); }
+void MoveLogWriter::flag  (int x, int y) { record(MoveAction::Flag,   y * cols_ + x); }
+void MoveLogWriter::chord (int x, int y) { record(MoveAction::Chord,  y * cols_ + x); }
+void MoveLogWriter::aiStep()             { record(MoveAction::AIStep, prevCell_);     }
+
+// Writes any buffered records to the underlying stream
+void MoveLogWriter::flush() {
+    if (used_ > 0) {
+        out_.write(reinterpret_cast<const char*>(buffer_.data()),
+                   static_cast<std::streamsize>(used_));
+        used_ = 0;
+    }
+    out_.flush();
+}
+
+// Encodes a cell action relative to the previous cell of this game. AI steps
+// pass prevCell_ so their delta is zero and the record fits in one byte.
+void MoveLogWriter::record(MoveAction action, int cell) {
+    const std::int64_t delta = static_cast<std::int64_t>(cell) - prevCell_;
+    prevCell_ = cell;
+    putVarint((zigzag(delta) << kActionBits) | static_cast<std::uint64_t>(action));
+}
+
+void MoveLogWriter::putVarint(std::uint64_t value) {
+    // Make room for the longest possible varint before encoding.
+    if (buffer_.size() - used_ < MAX_VARINT_BYTES) {
+        out_.write(reinterpret_cast<const char*>(buffer_.data()),
+                   static_cast<std::streamsize>(used_));
+        used_ = 0;
+    }
+    used_ += encodeVarint(buffer_.data() + used_, value);
+}
+
+// =============================================================================
+// Reader
+// =============================================================================
+
+MoveLogReader::MoveLogReader(std::istream& in, std::size_t bufferSize)
+: in_(in)
+, buffer_(bufferSize < 16 ? 16 : bufferSize) {
+    char magic[sizeof(kMagic)] = {};
+    in_.read(magic, sizeof(magic));
+    const int version = in_.get();
+    if (!in_ || !std::equal(magic, magic + sizeof(magic), kMagic) || version != kVersion) {
+        throw std::runtime_error("Move log header error");
+    }
+}
+
+bool MoveLogReader::nextGame(GameHeader& out) {
+    // Skip whatever is left of the current game.
+    Move skipped;
+    while (inGame_ && nextMove(skipped)) {}
+
+    if (!pendingBegin_) {
+        std::uint64_t tag;
+        if (!getVarint(tag)) return false;
+        if ((tag & ((1u << kActionBits) - 1)) != static_cast<std::uint64_t>(MoveAction::BeginGame)) {
+            throw std::runtime_error("Move log record error");
+        }
+    }
+
+    readHeaderFields(out);
+    pendingBegin_ = false;
+    inGame_       = true;
+    prevCell_     = 0;
+    return true;
+}
+
+bool MoveLogReader::nextMove(Move& out) {
+    if (!inGame_) return false;
+
+    std::uint64_t tag;
+    if (!getVarint(tag)) {
+        inGame_ = false;
+        return false;
+    }
+
+    const auto action = static_cast<MoveAction>(tag & ((1u << kActionBits) - 1));
+    if (action == MoveAction::BeginGame) {
+        inGame_       = false;
+        pendingBegin_ = true;
+        return false;
+    }
+    if (action > MoveAction::AIStep) {
+        throw std::runtime_error("Move log record error");
+    }
+
+    prevCell_  += static_cast<int>(unzigzag(tag >> kActionBits));
+    out.action  = action;
+    out.cell    = prevCell_;
+    return true;
+}
+
+// Refills the buffer from the stream. Returns false at end of stream.
+bool MoveLogReader::fill() {
+    in_.read(reinterpret_cast<char*>(buffer_.data()),
+             static_cast<std::streamsize>(buffer_.size()));
+    pos_ = 0;
+    end_ = static_cast<std::size_t>(in_.gcount());
+    return end_ > 0;
+}
+
+// Decodes one varint. Returns false on a clean end of stream; a varint cut
+// off part-way through is reported as corruption.
+bool MoveLogReader::getVarint(std::uint64_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos_ == end_ && !fill()) {
+            if (shift == 0) return false;
+            throw std::runtime_error("Move log truncated");
+        }
+        const std::uint8_t byte = buffer_[pos_++];
+        out |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    throw std::runtime_error("Move log record error");
+}
+
+void MoveLogReader::readHeaderFields(GameHeader& out) {
+    std::uint64_t seed, rows, cols, mines;
+    if (!getVarint(seed) || !getVarint(rows) || !getVarint(cols) || !getVarint(mines)) {
+        throw std::runtime_error("Move log truncated");
+    }
+    // Each side is bounded first so the product cannot wrap
+    if (seed > UINT32_MAX || rows == 0 || cols == 0 || rows > kMaxTiles || cols > kMaxTiles
+        || rows * cols > kMaxTiles || rows * cols < 9 || mines > rows * cols - 9) {
+        throw std::runtime_error("Move log record error");
+    }
+    out.seed  = static_cast<std::uint32_t>(seed);
+    out.rows  = static_cast<int>(rows);
+    out.cols  = static_cast<int>(cols);
+    out.mines = static_cast<int>(mines);
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+ReplayResult replayGame(MoveLogReader& reader, const GameHeader& header, Board& board) {
+    board.reset(header.rows, header.cols, header.mines, header.seed);
+
+    ReplayResult result;
+    Move move;
+    while (reader.nextMove(move)) {
+        ++result.moves;
+
+        const int x = header.cols > 0 ? move.cell % header.cols : 0;
+        const int y = header.cols > 0 ? move.cell / header.cols : 0;
+        switch (move.action) {
+            case MoveAction::Reveal: result.lost |= board.reveal(x, y); break;
+            case MoveAction::Chord:  result.lost |= board.chord(x, y);  break;
+            case MoveAction::Flag:   board.flag(x, y);                  break;
+            case MoveAction::AIStep: board.AISolver();                  break;
+            default: break;
+        }
+    }
+
+    result.cleared = !result.lost && board.isCleared();
+    return result;
+}
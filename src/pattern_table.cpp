@@ -0,0 +1,18 @@
+#include "PatternTable.hpp"
+
+namespace patterns {
+
+// Function-local statics with constant initializers: no guard and no
+// startup cost when the compiler evaluates the builders, and a one-time
+// build on first use when it gives up.
+const SingleTable& singleTable() {
+    static const SingleTable table = buildSingleTable();
+    return table;
+}
+
+const PairTable& pairTable() {
+    static const PairTable table = buildPairTable();
+    return table;
+}
+
+}  // namespace patterns
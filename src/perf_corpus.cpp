@@ -0,0 +1,165 @@
+#include "PerfCorpus.hpp"
+#include "BoardMetrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr PerfCase::Kind kKinds[] = {
+    PerfCase::Kind::Opening, PerfCase::Kind::Dense, PerfCase::Kind::Relocate, PerfCase::Kind::Chain
+};
+
+// Seeds a chain case may try before giving up
+constexpr std::uint32_t kChainSearchLimit = 100000;
+
+[[noreturn]] void manifestError() {
+    throw std::runtime_error("perf manifest error");
+}
+
+// Row-major mine layout on the first mines tiles
+std::vector<int> leadingTiles(int mines) {
+    std::vector<int> indices(mines);
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+
+bool buildable(const PerfCase& c) {
+    if (c.rows < 3 || c.cols < 3 || c.rows > 0xFFFF || c.cols > 0xFFFF) return false;
+    const long long tiles = static_cast<long long>(c.rows) * c.cols;
+    if (tiles > (1 << 26) || c.mines < 0 || c.mines > tiles - 9) return false;
+
+    // The free tiles must all lie past the center's 3x3
+    if (c.kind == PerfCase::Kind::Relocate) {
+        const long long lastOfBlock = static_cast<long long>(c.rows / 2 + 1) * c.cols + c.cols / 2 + 1;
+        return c.mines > lastOfBlock;
+    }
+    return true;
+}
+
+}  // namespace
+
+const char* perfKindName(PerfCase::Kind kind) {
+    switch (kind) {
+        case PerfCase::Kind::Opening:  return "opening";
+        case PerfCase::Kind::Dense:    return "dense";
+        case PerfCase::Kind::Relocate: return "relocate";
+        case PerfCase::Kind::Chain:    return "chain";
+    }
+    return "?";
+}
+
+std::vector<PerfCase> readPerfManifest(std::istream& in) {
+    std::vector<PerfCase> cases;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+
+        PerfCase c;
+        std::string kind;
+        if (!(fields >> c.name)) continue;          // blank or comment
+        if (!(fields >> kind >> c.rows >> c.cols >> c.mines >> c.seed >> c.budgetMs)) manifestError();
+
+        std::string extra;
+        if (fields >> extra) manifestError();
+
+        bool known = false;
+        for (PerfCase::Kind k : kKinds) {
+            if (kind == perfKindName(k)) {
+                c.kind = k;
+                known  = true;
+            }
+        }
+        if (!known || !buildable(c) || !(c.budgetMs > 0.0)) manifestError();
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+void writePerfManifest(std::ostream& out, const std::vector<PerfCase>& cases) {
+    out << "# name  kind  rows  cols  mines  seed  budget_ms\n";
+    for (const PerfCase& c : cases) {
+        out << std::left  << std::setw(20) << c.name << ' '
+            << std::setw(9) << perfKindName(c.kind) << ' '
+            << std::right << std::setw(5) << c.rows << ' '
+            << std::setw(5) << c.cols << ' '
+            << std::setw(8) << c.mines << ' '
+            << std::setw(10) << c.seed << ' '
+            << std::fixed << std::setprecision(3) << std::setw(10) << c.budgetMs << '\n';
+    }
+}
+
+Board buildPerfBoard(const PerfCase& c) {
+    if (!buildable(c)) throw std::runtime_error("perf case error");
+
+    switch (c.kind) {
+        case PerfCase::Kind::Opening: {
+            Board board(c.rows, c.cols, 1.f, 0, c.seed);
+            board.placeMinesAt(leadingTiles(c.mines));
+            return board;
+        }
+        case PerfCase::Kind::Dense:
+            return Board(c.rows, c.cols, 1.f, c.mines, c.seed);
+        case PerfCase::Kind::Relocate: {
+            Board board(c.rows, c.cols, 1.f, 0, c.seed);
+            board.placeMinesAt(leadingTiles(c.mines), /*consumeFirstClick=*/false);
+            return board;
+        }
+        case PerfCase::Kind::Chain: {
+            LayoutMeter meter;
+            for (std::uint32_t k = 0; k < kChainSearchLimit; ++k) {
+                const std::uint32_t seed = c.seed + k;
+                const std::vector<std::uint8_t>& cells =
+                    meter.deal(c.rows, c.cols, c.mines, seed, c.cols / 2, c.rows / 2);
+                if (meter.countGuesses(cells, c.rows, c.cols, c.cols / 2, c.rows / 2) == 0) {
+                    return Board(c.rows, c.cols, 1.f, c.mines, seed);
+                }
+            }
+            break;
+        }
+    }
+    throw std::runtime_error("perf case error");
+}
+
+void runPerfCase(const PerfCase& c, Board& board) {
+    const int cx = c.cols / 2;
+    const int cy = c.rows / 2;
+    switch (c.kind) {
+        case PerfCase::Kind::Opening:
+            board.reveal(c.cols - 1, c.rows - 1);
+            break;
+        case PerfCase::Kind::Dense:
+            board.reset(c.rows, c.cols, c.mines, c.seed);
+            board.reveal(cx, cy);
+            break;
+        case PerfCase::Kind::Relocate:
+            board.reveal(cx, cy);
+            break;
+        case PerfCase::Kind::Chain:
+            board.reveal(cx, cy);
+            while (board.AISolver()) {}
+            break;
+    }
+}
+
+double timePerfCase(const PerfCase& c, int repeat) {
+    using Clock = std::chrono::steady_clock;
+
+    const Board start = buildPerfBoard(c);
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < std::max(repeat, 1); ++r) {
+        Board board = start;
+        const auto t0 = Clock::now();
+        runPerfCase(c, board);
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+    return best;
+}
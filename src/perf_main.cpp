@@ -0,0 +1,134 @@
+#include "PerfCorpus.hpp"
+#include "PuzzleCorpus.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " check <manifest> [--margin <x>] [--floor <ms>] [--repeat <n>] [--case <name>]\n"
+        << "  " << prog << " record <manifest> [--repeat <n>] [--case <name>]\n"
+        << "  " << prog << " export <manifest> <dir>\n"
+        << "\n"
+        << "check times every case (best of --repeat runs, default 5) and fails if one\n"
+        << "takes longer than margin (default 1.5) times its budget and longer than\n"
+        << "floor (default 5 ms), so sub-millisecond cases do not fail on timer noise.\n"
+        << "record prints the manifest with the budgets set to the times measured here.\n"
+        << "export writes each case's starting layout to <dir>/<name>.mspc (PuzzleCorpus.hpp).\n";
+}
+
+std::vector<PerfCase> loadManifest(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    return readPerfManifest(in);
+}
+
+struct Options {
+    double      margin  = 1.5;
+    double      floorMs = 5.0;
+    int         repeat  = 5;
+    std::string only;
+};
+
+bool parseOptions(int argc, char** argv, int first, Options& out) {
+    for (int i = first; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        if      (arg == "--margin") out.margin  = std::stod(argv[++i]);
+        else if (arg == "--floor")  out.floorMs = std::stod(argv[++i]);
+        else if (arg == "--repeat") out.repeat = std::stoi(argv[++i]);
+        else if (arg == "--case")   out.only   = argv[++i];
+        else return false;
+    }
+    return out.margin > 0.0 && out.floorMs >= 0.0 && out.repeat >= 1;
+}
+
+int check(int argc, char** argv) {
+    Options options;
+    if (argc < 3 || !parseOptions(argc, argv, 3, options)) return -1;
+
+    int slow = 0;
+    std::cout << std::left << std::setw(20) << "case" << std::right
+              << std::setw(12) << "budget_ms" << std::setw(12) << "best_ms" << std::setw(8) << "ratio" << '\n';
+    for (const PerfCase& c : loadManifest(argv[2])) {
+        if (!options.only.empty() && c.name != options.only) continue;
+
+        const double ms    = timePerfCase(c, options.repeat);
+        const double ratio = ms / c.budgetMs;
+        const bool   over  = ratio > options.margin && ms > options.floorMs;
+        slow += over;
+        std::cout << std::left << std::setw(20) << c.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << c.budgetMs << std::setw(12) << ms
+                  << std::setprecision(2) << std::setw(8) << ratio << (over ? "  OVER BUDGET" : "") << '\n';
+    }
+
+    if (slow) {
+        std::cerr << slow << " case(s) over " << options.margin << "x their budget and "
+                  << options.floorMs << " ms\n";
+    }
+    return slow ? 1 : 0;
+}
+
+int record(int argc, char** argv) {
+    Options options;
+    if (argc < 3 || !parseOptions(argc, argv, 3, options)) return -1;
+
+    std::vector<PerfCase> cases = loadManifest(argv[2]);
+    for (PerfCase& c : cases) {
+        if (options.only.empty() || c.name == options.only) c.budgetMs = timePerfCase(c, options.repeat);
+    }
+    writePerfManifest(std::cout, cases);
+    return 0;
+}
+
+int exportLayouts(int argc, char** argv) {
+    if (argc != 4) return -1;
+
+    for (const PerfCase& c : loadManifest(argv[2])) {
+        const Board board = buildPerfBoard(c);
+        std::vector<std::uint8_t> cells;
+        for (int y = 0; y < c.rows; ++y) {
+            for (int x = 0; x < c.cols; ++x) cells.push_back(board.cellAt(x, y));
+        }
+
+        const std::string path = std::string(argv[3]) + "/" + c.name + ".mspc";
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Cannot open " << path << " for writing\n";
+            return 1;
+        }
+        PuzzleCorpusWriter writer(out, c.rows, c.cols);
+        writer.add(cells.data());
+        writer.finish();
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+
+    int rc = -1;
+    try {
+        const std::string command = argc > 1 ? argv[1] : "";
+        if (command == "check")       rc = check(argc, argv);
+        else if (command == "record") rc = record(argc, argv);
+        else if (command == "export") rc = exportLayouts(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (rc < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return rc;
+}
@@ -0,0 +1,262 @@
+#include "PuzzleCorpus.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'S', 'P', 'C'};
+
+std::uint16_t loadU16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | p[1] << 8);
+}
+
+std::uint32_t loadU32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8
+         | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+void storeU16(std::uint8_t* p, std::uint16_t v) {
+    p[0] = static_cast<std::uint8_t>(v);
+    p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void storeU32(std::uint8_t* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+std::size_t recordBytes(int rows, int cols) {
+    return (static_cast<std::size_t>(rows) * cols + 7) / 8;
+}
+
+bool validSize(long long rows, long long cols) {
+    return rows >= 1 && cols >= 1 && rows <= UINT16_MAX && cols <= UINT16_MAX
+        && rows * cols <= PuzzleCorpus::MAX_TILES;
+}
+
+// Record size for a writer, refusing what the header cannot describe
+std::size_t checkedRecordBytes(int rows, int cols) {
+    if (!validSize(rows, cols)) throw std::runtime_error("Puzzle corpus error");
+    return recordBytes(rows, cols);
+}
+
+// Grid adapter handing the shared rules (Rules.hpp) a raw cell buffer.
+struct RawGrid {
+    std::uint8_t*   c;
+    int             r;
+    int             w;
+
+    int          rows() const                  { return r; }
+    int          cols() const                  { return w; }
+    std::uint8_t get(int i) const              { return c[i]; }
+    void         set(int i, std::uint8_t v)    { c[i] = v; }
+};
+
+const char* outcomeName(PuzzleResult::Outcome o) {
+    switch (o) {
+        case PuzzleResult::Outcome::Solved: return "solved";
+        case PuzzleResult::Outcome::Stuck:  return "stuck";
+        case PuzzleResult::Outcome::Lost:   return "lost";
+    }
+    return "?";
+}
+
+}  // namespace
+
+PuzzleCorpus::PuzzleCorpus(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < HEADER_SIZE) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Puzzle corpus error");
+    }
+
+    length_ = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) throw std::runtime_error("Puzzle corpus error");
+    data_ = static_cast<const std::uint8_t*>(map);
+    madvise(map, length_, MADV_SEQUENTIAL);
+
+    rows_       = loadU16(data_ + 6);
+    cols_       = loadU16(data_ + 8);
+    count_      = loadU32(data_ + 12);
+    recordSize_ = recordBytes(rows_, cols_);
+    if (std::memcmp(data_, kMagic, 4) != 0 || loadU16(data_ + 4) != VERSION
+        || !validSize(rows_, cols_) || length_ != HEADER_SIZE + count_ * recordSize_) {
+        munmap(map, length_);
+        throw std::runtime_error("Puzzle corpus error");
+    }
+}
+
+PuzzleCorpus::~PuzzleCorpus() {
+    munmap(const_cast<std::uint8_t*>(data_), length_);
+}
+
+const std::uint8_t* PuzzleCorpus::mineBits(std::size_t i) const {
+    return data_ + HEADER_SIZE + i * recordSize_;
+}
+
+PuzzleCorpusWriter::PuzzleCorpusWriter(std::ostream& out, int rows, int cols)
+: out_(out)
+, rows_(rows)
+, cols_(cols)
+, start_(out.tellp())
+, record_(checkedRecordBytes(rows, cols)) {
+    std::uint8_t header[PuzzleCorpus::HEADER_SIZE] = {};
+    std::memcpy(header, kMagic, 4);
+    storeU16(header + 4, PuzzleCorpus::VERSION);
+    storeU16(header + 6, static_cast<std::uint16_t>(rows));
+    storeU16(header + 8, static_cast<std::uint16_t>(cols));
+    out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+PuzzleCorpusWriter::~PuzzleCorpusWriter() {
+    if (!finished_) {
+        try { finish(); } catch (...) {}
+    }
+}
+
+void PuzzleCorpusWriter::add(const std::uint8_t* cells) {
+    std::fill(record_.begin(), record_.end(), 0);
+    for (int i = 0, N = rows_ * cols_; i < N; ++i) {
+        if (cells[i] & cell::MINE) record_[i >> 3] |= static_cast<std::uint8_t>(1 << (i & 7));
+    }
+    out_.write(reinterpret_cast<const char*>(record_.data()), record_.size());
+    ++count_;
+}
+
+// Patches the record count into the header
+void PuzzleCorpusWriter::finish() {
+    finished_ = true;
+
+    const std::streampos end = out_.tellp();
+    std::uint8_t count[4];
+    storeU32(count, count_);
+    out_.seekp(start_ + std::streamoff(12));
+    out_.write(reinterpret_cast<const char*>(count), 4);
+    out_.seekp(end);
+    out_.flush();
+    if (!out_) throw std::runtime_error("Puzzle corpus error");
+}
+
+void generateCorpus(std::ostream& out, int rows, int cols, int mines,
+                    std::uint32_t firstSeed, std::uint32_t count) {
+    PuzzleCorpusWriter writer(out, rows, cols);
+    std::vector<std::uint8_t> cells(static_cast<std::size_t>(rows) * cols);
+    std::vector<int> scratch;
+    std::mt19937 rng;
+
+    RawGrid grid{cells.data(), rows, cols};
+    for (std::uint32_t k = 0; k < count; ++k) {
+        rng.seed(firstSeed + k);
+        rules::placeMines(grid, mines, rng, scratch);
+        writer.add(cells.data());
+    }
+    writer.finish();
+}
+
+CorpusSolver::CorpusSolver(int rows, int cols)
+: rows_(rows)
+, cols_(cols)
+, cells_(static_cast<std::size_t>(rows) * cols) {
+    scratch_.reserve(cells_.size());
+}
+
+// Unpacks a bitset into cells_ and returns the mine count. Adjacency is
+// built by bumping the neighbors of each mine, O(mines) rather than a
+// full neighbor scan of every tile.
+int CorpusSolver::load(const std::uint8_t* mineBits) {
+    const int N = rows_ * cols_;
+    std::fill(cells_.begin(), cells_.end(), 0);
+
+    // Mine bits, skipping empty bytes; the record's padding bits are zero
+    scratch_.clear();
+    const int bytes = (N + 7) / 8;
+    for (int b = 0; b < bytes; ++b) {
+        for (unsigned bits = mineBits[b]; bits; bits &= bits - 1) {
+            int bit = 0;
+            while (!(bits & (1u << bit))) ++bit;
+            const int i = b * 8 + bit;
+            if (i >= N) break;
+            cells_[i] = cell::MINE;
+            scratch_.push_back(i);
+        }
+    }
+
+    RawGrid grid{cells_.data(), rows_, cols_};
+    for (int i : scratch_) {
+        rules::forEachNeighbor(grid, i % cols_, i / cols_, [&](int nx, int ny) {
+            std::uint8_t& n = cells_[ny * cols_ + nx];
+            if (!(n & cell::MINE)) n = static_cast<std::uint8_t>(n + (1 << cell::ADJ_SHIFT));
+        });
+    }
+    return static_cast<int>(scratch_.size());
+}
+
+PuzzleResult CorpusSolver::solve(const std::uint8_t* mineBits, int startX, int startY,
+                                 Strategy& strategy) {
+    const auto start = std::chrono::steady_clock::now();
+
+    PuzzleResult result;
+    result.safeTiles = rows_ * cols_ - load(mineBits);
+    strategy.newGame(rows_, cols_, rows_ * cols_ - result.safeTiles);
+
+    RawGrid grid{cells_.data(), rows_, cols_};
+    auto play = [&](const StrategyMove& m) {
+        rules::RevealResult r;
+        switch (m.action) {
+            case StrategyMove::Action::Reveal: r = rules::reveal(grid, m.x, m.y, scratch_); break;
+            case StrategyMove::Action::Chord:  r = rules::chord (grid, m.x, m.y, scratch_); break;
+            case StrategyMove::Action::Flag:   rules::toggleFlag(grid, m.x, m.y);           break;
+        }
+        result.revealed += r.opened;
+        ++result.moves;
+        if (r.hit) result.outcome = PuzzleResult::Outcome::Lost;
+        else if (result.revealed == result.safeTiles) result.outcome = PuzzleResult::Outcome::Solved;
+    };
+
+    if (startX >= 0 && startX < cols_ && startY >= 0 && startY < rows_) {
+        play({StrategyMove::Action::Reveal, startX, startY});
+    }
+
+    // Same call cap as the tournament runner, against flag-toggling loops
+    const int maxCalls = 4 * rows_ * cols_;
+    for (int call = 0; result.outcome == PuzzleResult::Outcome::Stuck && call < maxCalls; ++call) {
+        moves_.clear();
+        strategy.nextMoves(BoardView(rows_, cols_, cells_.data()), moves_);
+        if (moves_.empty()) break;
+
+        for (const StrategyMove& m : moves_) {
+            if (m.x < 0 || m.x >= cols_ || m.y < 0 || m.y >= rows_) continue;
+            play(m);
+            if (result.outcome != PuzzleResult::Outcome::Stuck) break;
+        }
+    }
+
+    result.micros = std::chrono::duration<float, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void solveCorpus(const PuzzleCorpus& corpus, int startX, int startY,
+                 Strategy& strategy, std::ostream& out) {
+    CorpusSolver solver(corpus.rows(), corpus.cols());
+
+    out << "index,outcome,revealed,safe,moves,us\n";
+    for (std::size_t i = 0; i < corpus.size(); ++i) {
+        const PuzzleResult r = solver.solve(corpus.mineBits(i), startX, startY, strategy);
+        out << i << ',' << outcomeName(r.outcome) << ',' << r.revealed << ','
+            << r.safeTiles << ',' << r.moves << ',' << r.micros << '\n';
+    }
+}
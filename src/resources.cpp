@@ -0,0 +1,18 @@
+#include "Resources.hpp"
+
+#include <stdexcept>
+
+namespace resources {
+
+const sf::Font& font() {
+    static const sf::Font shared = [] {
+        sf::Font f;
+        if (!f.loadFromMemory(FONT_DATA, FONT_SIZE)) {
+            throw std::runtime_error("Font error");
+        }
+        return f;
+    }();
+    return shared;
+}
+
+}  // namespace resources
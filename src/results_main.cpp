@@ -0,0 +1,44 @@
+#include "ResultsStore.hpp"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " summary <file> [--by-strategy]\n"
+        << "  " << prog << " dump <file>\n"
+        << "\n"
+        << "summary prints win rates and move/time percentiles per difficulty as CSV,\n"
+        << "decoding one block at a time and only the columns it needs.\n"
+        << "dump prints every game record as CSV.\n"
+        << "Results files are written by MinesweeperTournament --results.\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+
+    const std::string command = argc > 1 ? argv[1] : "";
+    try {
+        if (command == "summary" && (argc == 3 || (argc == 4 && std::string(argv[3]) == "--by-strategy"))) {
+            const ResultsReader reader(argv[2]);
+            writeResultsSummaryCsv(std::cout, summarizeResults(reader, argc == 4));
+            return 0;
+        }
+        if (command == "dump" && argc == 3) {
+            const ResultsReader reader(argv[2]);
+            writeResultsCsv(std::cout, reader);
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
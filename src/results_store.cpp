@@ -0,0 +1,479 @@
+#include "ResultsStore.hpp"
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char          kFileMagic[4]   = {'M', 'S', 'R', 'S'};
+constexpr char          kBlockMagic[4]  = {'M', 'S', 'R', 'B'};
+constexpr std::size_t   kFileHeader     = 8;
+constexpr std::size_t   kBlockHeader    = 12;
+constexpr int           kNumColumns     = 9;
+
+[[noreturn]] void formatError() {
+    throw std::runtime_error("Results store error");
+}
+
+std::uint32_t loadU32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8
+         | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+void storeU32(std::uint8_t* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    std::uint8_t buf[MAX_VARINT_BYTES];
+    out.insert(out.end(), buf, buf + encodeVarint(buf, v));
+}
+
+// Runs of equal values; batch runs rarely change difficulty mid-block
+template<typename Get>
+void putRuns(std::vector<std::uint8_t>& out, std::size_t n, Get get) {
+    for (std::size_t i = 0; i < n; ) {
+        const std::uint64_t v = get(i);
+        std::size_t run = 1;
+        while (i + run < n && get(i + run) == v) ++run;
+        putVarint(out, v);
+        putVarint(out, run);
+        i += run;
+    }
+}
+
+// Cursor over one column's bytes; every read is bounds-checked
+struct ColumnReader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+
+    std::uint64_t varint() {
+        std::uint64_t v;
+        if (!decodeVarint(p, end, v)) formatError();
+        return v;
+    }
+    std::uint32_t u32() {
+        const std::uint64_t v = varint();
+        if (v > UINT32_MAX) formatError();
+        return static_cast<std::uint32_t>(v);
+    }
+    void done() const {
+        if (p != end) formatError();
+    }
+};
+
+void readRuns(ColumnReader& in, std::size_t count, std::vector<std::uint32_t>& out) {
+    out.clear();
+    while (out.size() < count) {
+        const std::uint32_t v   = in.u32();
+        const std::uint64_t run = in.varint();
+        if (run == 0 || run > count - out.size()) formatError();
+        out.insert(out.end(), run, v);
+    }
+    in.done();
+}
+
+void readVarints(ColumnReader& in, std::size_t count, std::vector<std::uint32_t>& out) {
+    if (count > static_cast<std::size_t>(in.end - in.p)) formatError();     // a byte per value at least
+    out.resize(count);
+    for (std::uint32_t& v : out) v = in.u32();
+    in.done();
+}
+
+// Fixed-size histogram of u32 values: one bucket per value below 64, then
+// 32 buckets per power of two. A percentile is reported as its bucket's
+// midpoint, so it is exact below 64 and within 1/64 of the true value above.
+class LogHistogram {
+public:
+    void add(std::uint32_t v) { ++counts_[bucket(v)]; }
+
+    // Same rank rule as the tournament runner
+    double percentile(std::uint64_t n, double p) const {
+        if (n == 0) return 0.0;
+        const std::uint64_t k = static_cast<std::uint64_t>(std::max(1.0, std::ceil(p * n)));
+        std::uint64_t seen = 0;
+        int i = 0;
+        while (i + 1 < BUCKETS && (seen += counts_[i]) < k) ++i;
+        return midpoint(i);
+    }
+
+private:
+    static constexpr int SUB_BITS   = 5;
+    static constexpr int SUB        = 1 << SUB_BITS;
+    static constexpr int EXACT      = 2 * SUB;
+    static constexpr int BUCKETS    = EXACT + (32 - SUB_BITS - 1) * SUB;
+
+    std::array<std::uint64_t, BUCKETS> counts_{};
+
+    static int bucket(std::uint32_t v) {
+        if (v < EXACT) return static_cast<int>(v);
+        int e = SUB_BITS + 1;
+        while (e < 31 && v >> (e + 1)) ++e;
+        return EXACT + (e - SUB_BITS - 1) * SUB + static_cast<int>((v >> (e - SUB_BITS)) & (SUB - 1));
+    }
+
+    static double midpoint(int i) {
+        if (i < EXACT) return i;
+        const int           e     = (i - EXACT) / SUB + SUB_BITS + 1;
+        const std::uint64_t width = 1ull << (e - SUB_BITS);
+        const std::uint64_t low   = static_cast<std::uint64_t>(SUB + (i - EXACT) % SUB) * width;
+        return static_cast<double>(low) + (width - 1) / 2.0;
+    }
+};
+
+const char* outcomeName(std::uint8_t o) {
+    switch (static_cast<GameRecord::Outcome>(o)) {
+        case GameRecord::Outcome::Win:   return "win";
+        case GameRecord::Outcome::Loss:  return "loss";
+        case GameRecord::Outcome::Stuck: return "stuck";
+    }
+    return "?";
+}
+
+}  // namespace
+
+// =============================================================================
+// Writing
+// =============================================================================
+
+ResultsWriter::ResultsWriter(const std::string& path) {
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if (fd_ < 0 || fstat(fd_, &st) != 0) {
+        if (fd_ >= 0) close(fd_);
+        throw std::runtime_error("Results store error");
+    }
+
+    if (st.st_size == 0) {
+        std::uint8_t header[kFileHeader] = {};
+        std::memcpy(header, kFileMagic, 4);
+        header[4] = static_cast<std::uint8_t>(VERSION);
+        header[5] = static_cast<std::uint8_t>(VERSION >> 8);
+        end_ = 0;
+        try {
+            append(std::vector<std::uint8_t>(header, header + kFileHeader));
+        } catch (...) {
+            close(fd_);
+            throw;
+        }
+        return;
+    }
+
+    std::uint8_t header[kFileHeader];
+    if (pread(fd_, header, kFileHeader, 0) != static_cast<ssize_t>(kFileHeader)
+        || std::memcmp(header, kFileMagic, 4) != 0 || (header[4] | header[5] << 8) != VERSION) {
+        close(fd_);
+        throw std::runtime_error("Results store error");
+    }
+    end_ = static_cast<std::uint64_t>(st.st_size);
+}
+
+ResultsWriter::~ResultsWriter() {
+    close(fd_);
+}
+
+std::uint64_t ResultsWriter::size() const {
+    return end_.load();
+}
+
+void ResultsWriter::sync() {
+    if (fdatasync(fd_) != 0) throw std::runtime_error("Results store error");
+}
+
+// Reserves the next bytes of the file and fills them; concurrent appends
+// get disjoint ranges
+void ResultsWriter::append(const std::vector<std::uint8_t>& block) {
+    std::uint64_t offset = end_.fetch_add(block.size());
+    const std::uint8_t* p = block.data();
+    std::size_t left = block.size();
+    while (left > 0) {
+        const ssize_t n = pwrite(fd_, p, left, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("Results store error");
+        p      += n;
+        left   -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+}
+
+ResultsWriter::Buffer::Buffer(ResultsWriter& writer, std::size_t blockRecords)
+: writer_(writer)
+, blockRecords_(std::max<std::size_t>(blockRecords, 1)) {
+    records_.reserve(blockRecords_);
+}
+
+ResultsWriter::Buffer::~Buffer() {
+    try { flush(); } catch (...) {}
+}
+
+void ResultsWriter::Buffer::add(const GameRecord& record) {
+    records_.push_back(record);
+    if (records_.size() >= blockRecords_) flush();
+}
+
+void ResultsWriter::Buffer::flush() {
+    if (records_.empty()) return;
+    const std::size_t n = records_.size();
+
+    block_.assign(kBlockHeader, 0);
+    auto putColumn = [&] {
+        putVarint(block_, column_.size());
+        block_.insert(block_.end(), column_.begin(), column_.end());
+        column_.clear();
+    };
+    column_.clear();
+
+    // seed
+    putVarint(column_, records_[0].seed);
+    for (std::size_t i = 1; i < n; ++i) {
+        putVarint(column_, zigzag(static_cast<std::int64_t>(records_[i].seed) - records_[i - 1].seed));
+    }
+    putColumn();
+
+    // rows, cols, mines
+    putRuns(column_, n, [&](std::size_t i) { return static_cast<std::uint64_t>(records_[i].rows); });
+    putColumn();
+    putRuns(column_, n, [&](std::size_t i) { return static_cast<std::uint64_t>(records_[i].cols); });
+    putColumn();
+    putRuns(column_, n, [&](std::size_t i) { return static_cast<std::uint64_t>(records_[i].mines); });
+    putColumn();
+
+    // strategy: dictionary in first-seen order, then runs of indices
+    std::vector<const std::string*> names;
+    std::vector<std::uint32_t>      index(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::string& s = records_[i].strategy;
+        auto it = std::find_if(names.begin(), names.end(), [&](const std::string* k) { return *k == s; });
+        if (it == names.end()) it = names.insert(names.end(), &s);
+        index[i] = static_cast<std::uint32_t>(it - names.begin());
+    }
+    putVarint(column_, names.size());
+    for (const std::string* s : names) {
+        putVarint(column_, s->size());
+        column_.insert(column_.end(), s->begin(), s->end());
+    }
+    putRuns(column_, n, [&](std::size_t i) { return static_cast<std::uint64_t>(index[i]); });
+    putColumn();
+
+    // outcome: four per byte
+    column_.assign((n + 3) / 4, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        column_[i / 4] |= static_cast<std::uint8_t>(static_cast<unsigned>(records_[i].outcome) << (2 * (i % 4)));
+    }
+    putColumn();
+
+    for (std::size_t i = 0; i < n; ++i) putVarint(column_, records_[i].moves);
+    putColumn();
+    for (std::size_t i = 0; i < n; ++i) putVarint(column_, records_[i].guesses);
+    putColumn();
+    for (std::size_t i = 0; i < n; ++i) putVarint(column_, records_[i].micros);
+    putColumn();
+
+    std::memcpy(block_.data(), kBlockMagic, 4);
+    storeU32(block_.data() + 4, static_cast<std::uint32_t>(block_.size() - kBlockHeader));
+    storeU32(block_.data() + 8, static_cast<std::uint32_t>(n));
+    records_.clear();
+    writer_.append(block_);
+}
+
+// =============================================================================
+// Reading
+// =============================================================================
+
+ResultsReader::ResultsReader(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kFileHeader) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Results store error");
+    }
+
+    length_ = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) throw std::runtime_error("Results store error");
+    data_ = static_cast<const std::uint8_t*>(map);
+    madvise(map, length_, MADV_SEQUENTIAL);
+
+    if (std::memcmp(data_, kFileMagic, 4) != 0 || (data_[4] | data_[5] << 8) != ResultsWriter::VERSION) {
+        munmap(map, length_);
+        throw std::runtime_error("Results store error");
+    }
+}
+
+ResultsReader::~ResultsReader() {
+    munmap(const_cast<std::uint8_t*>(data_), length_);
+}
+
+std::uint64_t ResultsReader::recordCount() const {
+    std::uint64_t records = 0;
+    for (std::size_t pos = kFileHeader; pos < length_; ) {
+        if (length_ - pos < kBlockHeader || std::memcmp(data_ + pos, kBlockMagic, 4) != 0) formatError();
+        const std::uint32_t payload = loadU32(data_ + pos + 4);
+        const std::uint32_t n       = loadU32(data_ + pos + 8);
+        if (payload > length_ - pos - kBlockHeader || n > payload) formatError();
+        records += n;
+        pos += kBlockHeader + payload;
+    }
+    return records;
+}
+
+void ResultsReader::forEachBlock(unsigned columns, const std::function<void(const ResultsBlock&)>& visit) const {
+    ResultsBlock block;
+    for (std::size_t pos = kFileHeader; pos < length_; ) {
+        if (length_ - pos < kBlockHeader || std::memcmp(data_ + pos, kBlockMagic, 4) != 0) formatError();
+        const std::uint32_t payload = loadU32(data_ + pos + 4);
+        const std::uint32_t n       = loadU32(data_ + pos + 8);
+        // The seed column alone takes a byte per record, so a count beyond
+        // the payload is damage; checked before anything is sized by it
+        if (payload > length_ - pos - kBlockHeader || n > payload) formatError();
+
+        ColumnReader blockIn{data_ + pos + kBlockHeader, data_ + pos + kBlockHeader + payload};
+        pos += kBlockHeader + payload;
+        block.count = n;
+
+        for (int c = 0; c < kNumColumns; ++c) {
+            const std::uint64_t bytes = blockIn.varint();
+            if (bytes > static_cast<std::uint64_t>(blockIn.end - blockIn.p)) formatError();
+            ColumnReader in{blockIn.p, blockIn.p + bytes};
+            blockIn.p += bytes;
+            if (!(columns & (1u << c))) continue;
+
+            switch (1u << c) {
+                case SEED_COLUMN: {
+                    if (n > bytes) formatError();
+                    block.seeds.resize(n);
+                    std::int64_t seed = 0;
+                    for (std::uint32_t i = 0; i < n; ++i) {
+                        seed = i == 0 ? static_cast<std::int64_t>(in.u32()) : seed + unzigzag(in.varint());
+                        if (seed < 0 || seed > UINT32_MAX) formatError();
+                        block.seeds[i] = static_cast<std::uint32_t>(seed);
+                    }
+                    in.done();
+                    break;
+                }
+                case ROWS_COLUMN:  readRuns(in, n, block.rows);  break;
+                case COLS_COLUMN:  readRuns(in, n, block.cols);  break;
+                case MINES_COLUMN: readRuns(in, n, block.mines); break;
+                case STRATEGY_COLUMN: {
+                    const std::uint64_t names = in.varint();
+                    if (names > static_cast<std::uint64_t>(in.end - in.p)) formatError();
+                    block.strategyNames.resize(names);
+                    for (std::string& name : block.strategyNames) {
+                        const std::uint64_t len = in.varint();
+                        if (len > static_cast<std::uint64_t>(in.end - in.p)) formatError();
+                        name.assign(reinterpret_cast<const char*>(in.p), len);
+                        in.p += len;
+                    }
+                    readRuns(in, n, block.strategies);
+                    for (std::uint32_t s : block.strategies) {
+                        if (s >= names) formatError();
+                    }
+                    break;
+                }
+                case OUTCOME_COLUMN:
+                    if (bytes != (n + 3ull) / 4) formatError();
+                    block.outcomes.resize(n);
+                    for (std::uint32_t i = 0; i < n; ++i) {
+                        block.outcomes[i] = (in.p[i / 4] >> (2 * (i % 4))) & 3;
+                        if (block.outcomes[i] > static_cast<std::uint8_t>(GameRecord::Outcome::Stuck)) formatError();
+                    }
+                    break;
+                case MOVES_COLUMN:   readVarints(in, n, block.moves);   break;
+                case GUESSES_COLUMN: readVarints(in, n, block.guesses); break;
+                case MICROS_COLUMN:  readVarints(in, n, block.micros);  break;
+            }
+        }
+        blockIn.done();
+        visit(block);
+    }
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+std::vector<ResultsSummary> summarizeResults(const ResultsReader& reader, bool byStrategy) {
+    struct Group {
+        ResultsSummary      summary;
+        std::uint64_t       guesses = 0;
+        LogHistogram        moves;
+        LogHistogram        micros;
+    };
+    std::map<std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::string>, Group> groups;
+
+    unsigned columns = ALL_COLUMNS & ~SEED_COLUMN;
+    if (!byStrategy) columns &= ~STRATEGY_COLUMN;
+
+    reader.forEachBlock(columns, [&](const ResultsBlock& b) {
+        Group* group = nullptr;
+        for (std::size_t i = 0; i < b.count; ++i) {
+            // Rows of a block mostly share a group; look it up, and copy the
+            // strategy name into a key, on change only
+            if (!group || i == 0 || b.rows[i] != b.rows[i - 1] || b.cols[i] != b.cols[i - 1]
+                || b.mines[i] != b.mines[i - 1] || (byStrategy && b.strategies[i] != b.strategies[i - 1])) {
+                group = &groups[{b.rows[i], b.cols[i], b.mines[i],
+                                 byStrategy ? b.strategyNames[b.strategies[i]] : std::string()}];
+            }
+
+            ResultsSummary& s = group->summary;
+            ++s.games;
+            s.wins   += b.outcomes[i] == static_cast<std::uint8_t>(GameRecord::Outcome::Win);
+            s.losses += b.outcomes[i] == static_cast<std::uint8_t>(GameRecord::Outcome::Loss);
+            s.stuck  += b.outcomes[i] == static_cast<std::uint8_t>(GameRecord::Outcome::Stuck);
+            group->guesses += b.guesses[i];
+            group->moves.add(b.moves[i]);
+            group->micros.add(b.micros[i]);
+        }
+    });
+
+    std::vector<ResultsSummary> out;
+    for (auto& [key, g] : groups) {
+        ResultsSummary s = g.summary;
+        s.rows        = static_cast<int>(std::get<0>(key));
+        s.cols        = static_cast<int>(std::get<1>(key));
+        s.mines       = static_cast<int>(std::get<2>(key));
+        s.strategy    = std::get<3>(key);
+        s.movesP50    = g.moves.percentile(s.games, 0.50);
+        s.movesP99    = g.moves.percentile(s.games, 0.99);
+        s.microsP50   = g.micros.percentile(s.games, 0.50);
+        s.microsP99   = g.micros.percentile(s.games, 0.99);
+        s.guessesMean = static_cast<double>(g.guesses) / s.games;
+        out.push_back(s);
+    }
+    return out;
+}
+
+void writeResultsSummaryCsv(std::ostream& os, const std::vector<ResultsSummary>& summary) {
+    os << "rows,cols,mines,strategy,games,wins,losses,stuck,win_rate,moves_p50,moves_p99,guesses_mean,us_p50,us_p99\n";
+    for (const ResultsSummary& s : summary) {
+        os << s.rows << ',' << s.cols << ',' << s.mines << ',' << s.strategy << ','
+           << s.games << ',' << s.wins << ',' << s.losses << ',' << s.stuck << ','
+           << s.winRate() << ',' << s.movesP50 << ',' << s.movesP99 << ','
+           << s.guessesMean << ',' << s.microsP50 << ',' << s.microsP99 << '\n';
+    }
+}
+
+void writeResultsCsv(std::ostream& os, const ResultsReader& reader) {
+    os << "seed,rows,cols,mines,strategy,outcome,moves,guesses,us\n";
+    reader.forEachBlock(ALL_COLUMNS, [&](const ResultsBlock& b) {
+        for (std::size_t i = 0; i < b.count; ++i) {
+            os << b.seeds[i] << ',' << b.rows[i] << ',' << b.cols[i] << ',' << b.mines[i] << ','
+               << b.strategyNames[b.strategies[i]] << ',' << outcomeName(b.outcomes[i]) << ','
+               << b.moves[i] << ',' << b.guesses[i] << ',' << b.micros[i] << '\n';
+        }
+    });
+}
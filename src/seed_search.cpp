@@ -0,0 +1,81 @@
+#include "SeedSearch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+constexpr std::uint64_t kChunk = 4096;
+
+bool openingsMatch(const SeedSearchConfig& c, const BoardMetrics& m) {
+    return c.bbbv.contains(m.bbbv)
+        && c.openings.contains(m.openings)
+        && c.largestOpening.contains(m.largestOpening)
+        && c.isolated.contains(m.isolated);
+}
+
+}  // namespace
+
+std::vector<SeedMatch> searchSeeds(const SeedSearchConfig& config, std::uint64_t* scanned) {
+    const std::uint64_t chunks = (config.count + kChunk - 1) / kChunk;
+
+    std::vector<SeedMatch>      found;
+    std::mutex                  foundMutex;
+    std::atomic<std::uint64_t>  nextChunk{0};
+    std::atomic<std::uint64_t>  measured{0};
+    std::atomic<std::size_t>    matched{0};
+
+    auto worker = [&] {
+        LayoutMeter meter;
+        std::vector<SeedMatch> local;
+        // Claimed chunks always run to the end, so they form a prefix of
+        // the range; once it holds limit matches no later chunk is needed
+        while (!config.limit || matched.load(std::memory_order_relaxed) < config.limit) {
+            const std::uint64_t k = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (k >= chunks) break;
+
+            const std::uint64_t end = std::min(config.count, (k + 1) * kChunk);
+            for (std::uint64_t i = k * kChunk; i < end; ++i) {
+                const std::uint32_t seed = config.firstSeed + static_cast<std::uint32_t>(i);
+                const std::vector<std::uint8_t>& cells =
+                    meter.deal(config.rows, config.cols, config.mines, seed, config.startX, config.startY);
+                BoardMetrics m = meter.measureOpenings(cells, config.rows, config.cols);
+                if (!openingsMatch(config, m)) continue;
+                m.guesses = meter.countGuesses(cells, config.rows, config.cols, config.startX, config.startY);
+                if (!config.guesses.contains(m.guesses)) continue;
+
+                local.push_back({seed, m});
+                matched.fetch_add(1, std::memory_order_relaxed);
+            }
+            measured.fetch_add(end - k * kChunk, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(foundMutex);
+        found.insert(found.end(), local.begin(), local.end());
+    };
+
+    const int threads = static_cast<int>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(config.threads, chunks)));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    // Scan order is seed order relative to firstSeed, which may wrap
+    std::sort(found.begin(), found.end(), [&](const SeedMatch& a, const SeedMatch& b) {
+        return a.seed - config.firstSeed < b.seed - config.firstSeed;
+    });
+    if (config.limit && found.size() > config.limit) found.resize(config.limit);
+    if (scanned) *scanned = measured.load();
+    return found;
+}
+
+void writeSeedCsv(std::ostream& os, const std::vector<SeedMatch>& matches) {
+    os << "seed,3bv,openings,largest_opening,isolated,guesses\n";
+    for (const SeedMatch& m : matches) {
+        os << m.seed << ',' << m.metrics.bbbv << ',' << m.metrics.openings << ','
+           << m.metrics.largestOpening << ',' << m.metrics.isolated << ',' << m.metrics.guesses << '\n';
+    }
+}
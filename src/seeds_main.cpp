@@ -0,0 +1,96 @@
+#include "SeedSearch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage: " << prog << " <rows> <cols> <mines> [options]\n"
+        << "  --start <x> <y>         first click the layouts are dealt for (default: board center)\n"
+        << "  --from <seed>           first seed (default 0)\n"
+        << "  --count <n>             seeds to scan (default 1048576)\n"
+        << "  --limit <k>             stop after k matches (default: no limit)\n"
+        << "  --threads <t>           worker threads (default: hardware concurrency)\n"
+        << "  --3bv <lo:hi>           metric ranges, inclusive; either bound may be left out\n"
+        << "  --openings <lo:hi>\n"
+        << "  --largest-opening <lo:hi>\n"
+        << "  --isolated <lo:hi>\n"
+        << "  --guesses <lo:hi>\n"
+        << "\n"
+        << "Prints matching seeds with their metrics as CSV, in seed order.\n";
+}
+
+// "lo:hi", "lo:", ":hi" or a single value
+MetricRange parseRange(const std::string& s) {
+    MetricRange r;
+    const std::size_t colon = s.find(':');
+    if (colon == std::string::npos) {
+        r.min = r.max = std::stoi(s);
+        return r;
+    }
+    if (colon > 0)            r.min = std::stoi(s.substr(0, colon));
+    if (colon + 1 < s.size()) r.max = std::stoi(s.substr(colon + 1));
+    return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+
+    SeedSearchConfig config;
+    config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    try {
+        if (argc < 4) throw std::invalid_argument("arguments");
+        config.rows   = std::stoi(argv[1]);
+        config.cols   = std::stoi(argv[2]);
+        config.mines  = std::stoi(argv[3]);
+        config.startX = config.cols / 2;
+        config.startY = config.rows / 2;
+
+        for (int i = 4; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--start" && i + 2 < argc) {
+                config.startX = std::stoi(argv[++i]);
+                config.startY = std::stoi(argv[++i]);
+            }
+            else if (arg == "--from"            && hasValue) config.firstSeed      = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--count"           && hasValue) config.count          = std::stoull(argv[++i]);
+            else if (arg == "--limit"           && hasValue) config.limit          = std::stoull(argv[++i]);
+            else if (arg == "--threads"         && hasValue) config.threads        = std::stoi(argv[++i]);
+            else if (arg == "--3bv"             && hasValue) config.bbbv           = parseRange(argv[++i]);
+            else if (arg == "--openings"        && hasValue) config.openings       = parseRange(argv[++i]);
+            else if (arg == "--largest-opening" && hasValue) config.largestOpening = parseRange(argv[++i]);
+            else if (arg == "--isolated"        && hasValue) config.isolated       = parseRange(argv[++i]);
+            else if (arg == "--guesses"         && hasValue) config.guesses        = parseRange(argv[++i]);
+            else throw std::invalid_argument(arg);
+        }
+    } catch (const std::exception&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Same limits as the game, plus a start cell on the board
+    if (config.rows < 3 || config.cols < 3 || config.mines < 0 || config.mines > config.rows * config.cols - 9
+        || config.startX < 0 || config.startX >= config.cols || config.startY < 0 || config.startY >= config.rows
+        || config.count > (std::uint64_t(1) << 32) || config.threads < 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t scanned = 0;
+    const std::vector<SeedMatch> matches = searchSeeds(config, &scanned);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    writeSeedCsv(std::cout, matches);
+    std::cerr << scanned << " seeds scanned in " << seconds << " s ("
+              << static_cast<std::uint64_t>(scanned / std::max(seconds, 1e-9)) << "/s), "
+              << matches.size() << " matches\n";
+    return 0;
+}
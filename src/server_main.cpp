@@ -0,0 +1,64 @@
+#include "GameServer.hpp"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+
+namespace {
+
+GameServer* runningServer = nullptr;
+
+// stop() only stores an atomic and writes to a pipe, both signal-safe
+extern "C" void handleSignal(int) {
+    if (runningServer) runningServer->stop();
+}
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " <socket-path> [--hint-threads <n>]\n"
+        << "\n"
+        << "Hosts headless games over a Unix domain socket; see ServerProtocol.hpp.\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    GameServer::Config config;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--hint-threads" && i + 1 < argc) {
+                config.hintThreads = std::stoi(argv[++i]);
+            } else if (config.socketPath.empty() && arg.rfind("--", 0) != 0) {
+                config.socketPath = arg;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (...) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (config.socketPath.empty() || config.hintThreads < 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        GameServer server(config);
+        runningServer = &server;
+        std::signal(SIGINT,  handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        std::cerr << "Listening on " << config.socketPath << '\n';
+        server.run();
+        runningServer = nullptr;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
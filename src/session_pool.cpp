@@ -0,0 +1,120 @@
+#include "SessionPool.hpp"
+
+// Grid adapter handing the shared rules (Rules.hpp) a session's cells.
+struct Session::Grid {
+    Session& s;
+
+    int          rows() const                  { return s.rows; }
+    int          cols() const                  { return s.cols; }
+    std::uint8_t get(int i) const              { return s.cells[i]; }
+    void         set(int i, std::uint8_t v)    { s.cells[i] = v; }
+};
+
+void Session::start(int numRows, int numCols, int numMines, std::uint32_t gameSeed,
+                    std::vector<int>& scratch) {
+    rows        = numRows;
+    cols        = numCols;
+    mines       = numMines;
+    seed        = gameSeed;
+    safeHidden  = rows * cols - mines;
+    firstClick  = true;
+    status      = proto::GameStatus::Playing;
+
+    cells.assign(static_cast<std::size_t>(rows) * cols, 0);
+    rng.seed(seed);
+    Grid grid{*this};
+    rules::placeMines(grid, mines, rng, scratch);
+}
+
+rules::RevealResult Session::reveal(int x, int y, std::vector<int>& scratch) {
+    if (!playable(x, y)) return {};
+
+    Grid grid{*this};
+    if (firstClick) {
+        firstClick = false;
+        const int dropped = rules::relocateFromSafeArea(grid, x, y, rng, scratch);
+        mines      -= dropped;
+        safeHidden += dropped;
+    }
+    const rules::RevealResult r = rules::reveal(grid, x, y, scratch);
+    finishMove(r);
+    return r;
+}
+
+rules::RevealResult Session::chord(int x, int y, std::vector<int>& scratch) {
+    if (!playable(x, y)) return {};
+
+    Grid grid{*this};
+    const rules::RevealResult r = rules::chord(grid, x, y, scratch);
+    finishMove(r);
+    return r;
+}
+
+void Session::flag(int x, int y) {
+    if (!playable(x, y)) return;
+
+    Grid grid{*this};
+    rules::toggleFlag(grid, x, y);
+}
+
+bool Session::playable(int x, int y) const {
+    return status == proto::GameStatus::Playing
+        && x >= 0 && x < cols && y >= 0 && y < rows;
+}
+
+void Session::finishMove(const rules::RevealResult& r) {
+    safeHidden -= r.opened;
+    if (r.hit) {
+        status = proto::GameStatus::Lost;
+    } else if (safeHidden == 0) {
+        status = proto::GameStatus::Won;
+    }
+}
+
+std::uint32_t SessionPool::create() {
+    if (free_.empty()) {
+        if (capacity() >= MAX_SESSIONS) return INVALID_ID;
+
+        // Grow by one slab; push its slots so the lowest is reused first
+        const std::uint32_t base = static_cast<std::uint32_t>(capacity());
+        slabs_.push_back(std::make_unique<Session[]>(SLAB_SIZE));
+        for (int i = SLAB_SIZE - 1; i >= 0; --i) free_.push_back(base + i);
+    }
+
+    const std::uint32_t s = free_.back();
+    free_.pop_back();
+    Session& session = slot(s);
+    session.live_ = true;
+    ++live_;
+    return (session.generation_ << SLOT_BITS) | s;
+}
+
+Session* SessionPool::find(std::uint32_t id) {
+    const std::uint32_t s = id & (MAX_SESSIONS - 1);
+    if (s >= static_cast<std::uint32_t>(capacity())) return nullptr;
+
+    Session& session = slot(s);
+    const std::uint32_t generation = id >> SLOT_BITS;
+    return session.live_ && session.generation_ == generation ? &session : nullptr;
+}
+
+// Keeps the cell buffer for the slot's next game
+bool SessionPool::destroy(std::uint32_t id) {
+    Session* session = find(id);
+    if (!session) return false;
+
+    session->live_ = false;
+    session->generation_ = (session->generation_ + 1) & ((1u << (32 - SLOT_BITS)) - 1);
+    if (session->generation_ == 0) session->generation_ = 1;     // slot 0 would make INVALID_ID
+    free_.push_back(id & (MAX_SESSIONS - 1));
+    --live_;
+    return true;
+}
+
+int SessionPool::liveCount() const {
+    return live_;
+}
+
+int SessionPool::capacity() const {
+    return static_cast<int>(slabs_.size()) * SLAB_SIZE;
+}
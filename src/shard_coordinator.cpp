@@ -0,0 +1,511 @@
+#include "ShardCoordinator.hpp"
+#include "ResultsStore.hpp"
+#include "ServerProtocol.hpp"
+#include "Strategy.hpp"
+#include "Tournament.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Worker -> coordinator
+//      Want        tag 0, nothing      ready for a shard
+//      Result      tag shard, u32 records, then per record u32 seed,
+//                  u8 strategy index, u8 GameRecord::Outcome, u32 moves,
+//                  u32 guesses, u32 micros; strategy-major, seed order
+// Coordinator -> worker
+//      Assign      tag shard, u32 first seed, u32 seeds, u16 rows, u16 cols,
+//                  u32 mines, u8 strategies, then per strategy u8 length
+//                  and the name
+//      Finished    tag 0, nothing      no shards left; disconnect
+enum class ShardOp : std::uint8_t { Want = 1, Result, Assign, Finished };
+
+constexpr std::uint32_t RECORD_BYTES    = 18;
+constexpr std::size_t   READ_CHUNK      = 64u << 10;
+
+bool setNonBlocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool sendAll(int fd, const std::vector<std::uint8_t>& bytes) {
+    std::size_t sent = 0;
+    while (sent < bytes.size()) {
+        const ssize_t n = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readExactly(int fd, std::uint8_t* dst, std::size_t n) {
+    while (n > 0) {
+        const ssize_t got = read(fd, dst, n);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        dst += got;
+        n   -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+bool writeLine(int fd, const std::string& line) {
+    const char* p = line.data();
+    std::size_t left = line.size();
+    while (left > 0) {
+        const ssize_t n = write(fd, p, left);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p    += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    return fdatasync(fd) == 0;
+}
+
+void putFrame(std::vector<std::uint8_t>& out, std::uint32_t tag, ShardOp op) {
+    proto::endFrame(out, proto::beginFrame(out, tag, static_cast<std::uint8_t>(op)));
+}
+
+std::uint32_t shardSeeds(const ShardCoordinator::Config& c, int shard) {
+    const std::uint64_t first = static_cast<std::uint64_t>(shard) * c.shardSize;
+    return static_cast<std::uint32_t>(std::min<std::uint64_t>(c.shardSize, c.seedCount - first));
+}
+
+std::uint32_t shardFirstSeed(const ShardCoordinator::Config& c, int shard) {
+    return c.firstSeed + static_cast<std::uint32_t>(shard) * c.shardSize;
+}
+
+[[noreturn]] void checkpointError() {
+    throw std::runtime_error("Shard checkpoint error");
+}
+
+}  // namespace
+
+ShardCoordinator::ShardCoordinator(const Config& config)
+: config_(config) {
+    if (config_.strategies.empty()) {
+        for (const StrategyInfo& info : strategyRegistry()) {
+            if (!info.timed) config_.strategies.push_back(info.name);
+        }
+    }
+
+    const Config& c = config_;
+    bool valid = c.rows >= 3 && c.cols >= 3 && c.rows <= proto::MAX_DIMENSION && c.cols <= proto::MAX_DIMENSION
+              && c.mines > 0 && c.mines <= c.rows * c.cols - 9 && c.seedCount > 0 && c.shardSize > 0
+              && static_cast<std::uint64_t>(c.firstSeed) + c.seedCount - 1 <= UINT32_MAX
+              && c.strategies.size() <= 255
+              && static_cast<std::uint64_t>(c.shardSize) * c.strategies.size() * RECORD_BYTES + 64 <= proto::MAX_BODY_SIZE;
+    for (const std::string& name : c.strategies) {
+        const auto& registry = strategyRegistry();
+        valid = valid && !name.empty() && name.size() <= 255 && name.find_first_of(", \n") == std::string::npos
+             && std::any_of(registry.begin(), registry.end(), [&](const StrategyInfo& i) { return i.name == name; });
+    }
+    if (!valid) throw std::runtime_error("Shard config error");
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (c.socketPath.empty() || c.socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Shard socket path error");
+    }
+    std::memcpy(addr.sun_path, c.socketPath.c_str(), c.socketPath.size() + 1);
+
+    std::ostringstream run;
+    run << "run " << c.rows << ' ' << c.cols << ' ' << c.mines << ' ' << c.firstSeed << ' '
+        << c.seedCount << ' ' << c.shardSize << ' ';
+    for (std::size_t i = 0; i < c.strategies.size(); ++i) run << (i ? "," : "") << c.strategies[i];
+    runLine_ = run.str();
+
+    done_.assign((static_cast<std::uint64_t>(c.seedCount) + c.shardSize - 1) / c.shardSize, 0);
+    openCheckpoint();
+    for (int s = shardCount() - 1; s >= 0; --s) {
+        if (!done_[s]) pending_.push_back(s);
+    }
+
+    // Replace a stale socket left by a previous run, but never a regular file
+    struct stat st;
+    if (stat(c.socketPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(c.socketPath.c_str());
+
+    int wake[2] = {-1, -1};
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0
+        || bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || listen(listenFd_, SOMAXCONN) != 0
+        || !setNonBlocking(listenFd_)
+        || pipe(wake) != 0
+        || !setNonBlocking(wake[0])
+        || !setNonBlocking(wake[1])) {
+        if (listenFd_ >= 0) close(listenFd_);
+        if (wake[0] >= 0)   close(wake[0]);
+        if (wake[1] >= 0)   close(wake[1]);
+        close(checkpointFd_);
+        throw std::runtime_error("Shard socket error");
+    }
+    wakeRead_  = wake[0];
+    wakeWrite_ = wake[1];
+}
+
+ShardCoordinator::~ShardCoordinator() {
+    for (auto& entry : connections_) close(entry.second.fd);
+    close(listenFd_);
+    close(wakeRead_);
+    close(wakeWrite_);
+    close(checkpointFd_);
+    unlink(config_.socketPath.c_str());
+}
+
+// Starts a checkpoint, or replays one: "run ..." must match this config,
+// "base <bytes>" is the results file size the run started from, and each
+// "done <shard> <bytes>" line is a shard whose block ends at bytes. A
+// partial last line is the crash that interrupted it and is dropped.
+void ShardCoordinator::openCheckpoint() {
+    std::string text;
+    {
+        std::ifstream in(config_.checkpointPath, std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    if (text.empty()) {
+        results_ = std::make_unique<ResultsWriter>(config_.resultsPath);
+        checkpointFd_ = open(config_.checkpointPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        if (checkpointFd_ < 0) checkpointError();
+        if (!writeLine(checkpointFd_, runLine_ + "\nbase " + std::to_string(results_->size()) + "\n")) {
+            close(checkpointFd_);
+            checkpointError();
+        }
+        return;
+    }
+
+    const std::size_t complete = text.rfind('\n') + 1;     // 0 if there is no newline
+    std::istringstream lines(text.substr(0, complete));
+    std::string line;
+    std::string word;
+    std::uint64_t committed = 0;
+    if (!std::getline(lines, line) || line != runLine_) checkpointError();
+    if (!std::getline(lines, line) || !(std::istringstream(line) >> word >> committed) || word != "base") {
+        checkpointError();
+    }
+    while (std::getline(lines, line)) {
+        std::istringstream fields(line);
+        long long     shard = -1;
+        std::uint64_t bytes = 0;
+        if (!(fields >> word >> shard >> bytes) || word != "done" || shard < 0 || shard >= shardCount()
+            || done_[shard] || bytes < committed) {
+            checkpointError();
+        }
+        done_[shard] = 1;
+        committed    = bytes;
+        ++resumed_;
+    }
+    completed_ = resumed_;
+
+    // Anything past the last committed block was written by the run that crashed
+    struct stat st;
+    if (stat(config_.resultsPath.c_str(), &st) != 0 || static_cast<std::uint64_t>(st.st_size) < committed
+        || truncate(config_.resultsPath.c_str(), static_cast<off_t>(committed)) != 0) {
+        checkpointError();
+    }
+    results_ = std::make_unique<ResultsWriter>(config_.resultsPath);
+
+    checkpointFd_ = open(config_.checkpointPath.c_str(), O_WRONLY | O_APPEND);
+    if (checkpointFd_ < 0) checkpointError();
+    if (ftruncate(checkpointFd_, static_cast<off_t>(complete)) != 0) {
+        close(checkpointFd_);
+        checkpointError();
+    }
+}
+
+bool ShardCoordinator::run() {
+    std::vector<pollfd>         fds;
+    std::vector<std::uint64_t>  ids;
+    std::vector<std::uint64_t>  dead;
+
+    while (!stopping_.load() && completed_.load() < shardCount()) {
+        fds.clear();
+        ids.clear();
+        fds.push_back({wakeRead_, POLLIN, 0});
+        fds.push_back({listenFd_, POLLIN, 0});
+        for (const auto& entry : connections_) {
+            fds.push_back({entry.second.fd, POLLIN, 0});
+            ids.push_back(entry.first);
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Shard poll error");
+        }
+
+        if (fds[0].revents) {
+            char drain[256];
+            while (read(wakeRead_, drain, sizeof(drain)) > 0) {}
+        }
+        if (fds[1].revents & POLLIN) acceptWorkers();
+
+        dead.clear();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (fds[i + 2].revents && !readFrom(connections_.at(ids[i]))) dead.push_back(ids[i]);
+        }
+        for (std::uint64_t id : dead) drop(id);
+
+        // Hand out work, including shards given back by dropped workers
+        dead.clear();
+        for (auto& entry : connections_) {
+            if (pending_.empty()) break;
+            if (!entry.second.idle) continue;
+            const int shard = pending_.back();
+            pending_.pop_back();
+            if (!assign(entry.second, shard)) dead.push_back(entry.first);
+        }
+        for (std::uint64_t id : dead) drop(id);
+    }
+
+    const bool finished = completed_.load() == shardCount();
+    std::vector<std::uint8_t> frame;
+    if (finished) putFrame(frame, 0, ShardOp::Finished);
+    for (auto& entry : connections_) {
+        if (finished) sendAll(entry.second.fd, frame);
+        if (entry.second.shard >= 0) pending_.push_back(entry.second.shard);
+        close(entry.second.fd);
+    }
+    connections_.clear();
+    return finished;
+}
+
+void ShardCoordinator::stop() {
+    stopping_.store(true);
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t n = write(wakeWrite_, &byte, 1);
+}
+
+void ShardCoordinator::acceptWorkers() {
+    while (true) {
+        const int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) return;
+        if (!setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        connections_.emplace(nextConnection_++, Connection{fd, {}, -1, false});
+    }
+}
+
+// Reads what is available and handles every complete frame, including
+// those that arrived just before end-of-stream. False drops the worker.
+bool ShardCoordinator::readFrom(Connection& c) {
+    bool open = true;
+    while (open) {
+        const std::size_t old = c.in.size();
+        c.in.resize(old + READ_CHUNK);
+        const ssize_t n = read(c.fd, c.in.data() + old, READ_CHUNK);
+        c.in.resize(old + (n > 0 ? n : 0));
+
+        if (n > 0) continue;
+        if (n == 0) open = false;
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        else if (errno != EINTR) open = false;
+    }
+
+    std::size_t pos = 0;
+    while (c.in.size() - pos >= 4) {
+        const std::uint32_t size = proto::loadU32(c.in.data() + pos);
+        if (size < proto::HEADER_SIZE - 4 || size > proto::MAX_BODY_SIZE) return false;
+        if (c.in.size() - pos - 4 < size) break;
+
+        if (!handleFrame(c, c.in.data() + pos + 4, size)) return false;
+        pos += 4 + size;
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + pos);
+    return open;
+}
+
+bool ShardCoordinator::handleFrame(Connection& c, const std::uint8_t* body, std::uint32_t size) {
+    proto::Reader r{body, body + size};
+    const std::uint32_t tag = r.u32();
+    const auto          op  = static_cast<ShardOp>(r.u8());
+
+    if (op == ShardOp::Want) {
+        if (c.shard >= 0) return false;
+        c.idle = true;
+        return r.ok;
+    }
+    if (op != ShardOp::Result || c.shard < 0 || tag != static_cast<std::uint32_t>(c.shard)) return false;
+
+    const std::uint32_t count    = r.u32();
+    const std::uint32_t seeds    = shardSeeds(config_, c.shard);
+    const std::uint32_t first    = shardFirstSeed(config_, c.shard);
+    const std::uint64_t expected = static_cast<std::uint64_t>(seeds) * config_.strategies.size();
+    if (!r.ok || count != expected || static_cast<std::uint64_t>(r.end - r.p) != expected * RECORD_BYTES) {
+        return false;
+    }
+    for (const std::uint8_t* p = r.p; p != r.end; p += RECORD_BYTES) {
+        const std::uint32_t seed = proto::loadU32(p);
+        if (seed - first >= seeds || p[4] >= config_.strategies.size()
+            || p[5] > static_cast<std::uint8_t>(GameRecord::Outcome::Stuck)) {
+            return false;
+        }
+    }
+
+    commitShard(c.shard, r.p, count);
+    c.shard = -1;
+    c.idle  = true;
+    return true;
+}
+
+// One block per shard, synced before the checkpoint line that vouches for it
+void ShardCoordinator::commitShard(int shard, const std::uint8_t* records, std::uint32_t count) {
+    ResultsWriter::Buffer buffer(*results_, count);
+    GameRecord record;
+    record.rows  = config_.rows;
+    record.cols  = config_.cols;
+    record.mines = config_.mines;
+    for (std::uint32_t i = 0; i < count; ++i, records += RECORD_BYTES) {
+        record.seed     = proto::loadU32(records);
+        record.strategy = config_.strategies[records[4]];
+        record.outcome  = static_cast<GameRecord::Outcome>(records[5]);
+        record.moves    = proto::loadU32(records + 6);
+        record.guesses  = proto::loadU32(records + 10);
+        record.micros   = proto::loadU32(records + 14);
+        buffer.add(record);
+    }
+    buffer.flush();
+    results_->sync();
+
+    if (!writeLine(checkpointFd_, "done " + std::to_string(shard) + " " + std::to_string(results_->size()) + "\n")) {
+        checkpointError();
+    }
+    done_[shard] = 1;
+    completed_.fetch_add(1);
+}
+
+bool ShardCoordinator::assign(Connection& c, int shard) {
+    std::vector<std::uint8_t> out;
+    const std::size_t f = proto::beginFrame(out, static_cast<std::uint32_t>(shard),
+                                            static_cast<std::uint8_t>(ShardOp::Assign));
+    proto::putU32(out, shardFirstSeed(config_, shard));
+    proto::putU32(out, shardSeeds(config_, shard));
+    proto::putU16(out, static_cast<std::uint16_t>(config_.rows));
+    proto::putU16(out, static_cast<std::uint16_t>(config_.cols));
+    proto::putU32(out, static_cast<std::uint32_t>(config_.mines));
+    proto::putU8(out, static_cast<std::uint8_t>(config_.strategies.size()));
+    for (const std::string& name : config_.strategies) {
+        proto::putU8(out, static_cast<std::uint8_t>(name.size()));
+        out.insert(out.end(), name.begin(), name.end());
+    }
+    proto::endFrame(out, f);
+
+    c.shard = shard;
+    c.idle  = false;
+    return sendAll(c.fd, out);
+}
+
+// Closes a worker; a shard it was playing goes back to the queue
+void ShardCoordinator::drop(std::uint64_t id) {
+    auto it = connections_.find(id);
+    if (it == connections_.end()) return;
+    if (it->second.shard >= 0) pending_.push_back(it->second.shard);
+    close(it->second.fd);
+    connections_.erase(it);
+}
+
+int runShardWorker(const std::string& socketPath, int maxShards) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Shard worker error");
+    }
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Shard worker error");
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<Strategy>>> instances;
+    auto instance = [&](const std::string& name) -> Strategy& {
+        for (auto& entry : instances) {
+            if (entry.first == name) return *entry.second;
+        }
+        for (const StrategyInfo& info : strategyRegistry()) {
+            if (info.name == name) return *instances.emplace_back(name, info.create()).second;
+        }
+        throw std::runtime_error("Shard worker error");
+    };
+
+    std::vector<std::uint8_t> out;
+    std::vector<std::uint8_t> body;
+    putFrame(out, 0, ShardOp::Want);
+
+    int played = 0;
+    try {
+        // Connection loss at any point means the coordinator is gone or done
+        bool sent = sendAll(fd, out);
+        while (sent && (maxShards <= 0 || played < maxShards)) {
+            std::uint8_t sizeBytes[4];
+            if (!readExactly(fd, sizeBytes, 4)) break;
+            const std::uint32_t size = proto::loadU32(sizeBytes);
+            if (size < proto::HEADER_SIZE - 4 || size > proto::MAX_BODY_SIZE) {
+                throw std::runtime_error("Shard worker error");
+            }
+            body.resize(size);
+            if (!readExactly(fd, body.data(), size)) break;
+
+            proto::Reader r{body.data(), body.data() + size};
+            const std::uint32_t shard = r.u32();
+            const auto          op    = static_cast<ShardOp>(r.u8());
+            if (op == ShardOp::Finished) break;
+
+            TournamentConfig config;
+            const std::uint32_t first = r.u32();
+            const std::uint32_t seeds = r.u32();
+            config.rows  = r.u16();
+            config.cols  = r.u16();
+            config.mines = static_cast<int>(r.u32());
+            std::vector<std::string> names(r.u8());
+            for (std::string& name : names) {
+                const std::uint8_t length = r.u8();
+                if (!r.has(length)) break;
+                name.assign(reinterpret_cast<const char*>(r.p), length);
+                r.p += length;
+            }
+            if (op != ShardOp::Assign || !r.ok || r.p != r.end) throw std::runtime_error("Shard worker error");
+
+            out.clear();
+            const std::size_t f = proto::beginFrame(out, shard, static_cast<std::uint8_t>(ShardOp::Result));
+            proto::putU32(out, static_cast<std::uint32_t>(seeds * names.size()));
+            for (std::size_t s = 0; s < names.size(); ++s) {
+                Strategy& strategy = instance(names[s]);
+                for (std::uint32_t k = 0; k < seeds; ++k) {
+                    const GameRecord g = playTournamentGame(strategy, names[s], config, first + k);
+                    proto::putU32(out, g.seed);
+                    proto::putU8(out, static_cast<std::uint8_t>(s));
+                    proto::putU8(out, static_cast<std::uint8_t>(g.outcome));
+                    proto::putU32(out, g.moves);
+                    proto::putU32(out, g.guesses);
+                    proto::putU32(out, g.micros);
+                }
+            }
+            proto::endFrame(out, f);
+            sent    = sendAll(fd, out);
+            played += sent;
+        }
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+    return played;
+}
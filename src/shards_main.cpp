@@ -0,0 +1,145 @@
+#include "ShardCoordinator.hpp"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+ShardCoordinator* runningCoordinator = nullptr;
+
+// stop() only stores an atomic and writes to a pipe, both signal-safe
+extern "C" void handleSignal(int) {
+    if (runningCoordinator) runningCoordinator->stop();
+}
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " coordinate <socket> <results> <checkpoint> [easy | medium | hard | <rows> <cols> <mines>] [options]\n"
+        << "  " << prog << " work <socket> [--max-shards <n>]\n"
+        << "\n"
+        << "Coordinator options:\n"
+        << "  --seeds <first> <count>  seed range to play (default 1 100000)\n"
+        << "  --shard-size <n>         seeds per shard (default 1000)\n"
+        << "  --strategy <name>        play this strategy; repeat for more\n"
+        << "                           (default: all but timed ones, i.e. not anytime)\n"
+        << "  --local <n>              also start n worker processes on this host\n"
+        << "\n"
+        << "coordinate splits the seeds into shards, hands them to workers connected to\n"
+        << "<socket>, and appends every game to the results store <results>\n"
+        << "(MinesweeperResults). Finished shards are recorded in <checkpoint>; run the\n"
+        << "same command again after a crash or Ctrl-C to pick up where it stopped.\n"
+        << "work plays shards for a coordinator until it has none left.\n";
+}
+
+int coordinate(int argc, char** argv) {
+    if (argc < 5) return -1;
+
+    ShardCoordinator::Config config;
+    config.socketPath     = argv[2];
+    config.resultsPath    = argv[3];
+    config.checkpointPath = argv[4];
+    int local = 0;
+
+    for (int i = 5; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "easy")        { config.rows = 9;  config.cols = 9;  config.mines = 10; }
+        else if (arg == "medium") { config.rows = 16; config.cols = 16; config.mines = 40; }
+        else if (arg == "hard")   { config.rows = 16; config.cols = 30; config.mines = 99; }
+        else if (arg == "--seeds" && i + 2 < argc) {
+            config.firstSeed = static_cast<std::uint32_t>(std::stoul(argv[i + 1]));
+            config.seedCount = static_cast<std::uint32_t>(std::stoul(argv[i + 2]));
+            i += 2;
+        }
+        else if (arg == "--shard-size" && hasValue) config.shardSize = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--strategy"   && hasValue) config.strategies.push_back(argv[++i]);
+        else if (arg == "--local"      && hasValue) local = std::stoi(argv[++i]);
+        else if (i + 2 < argc && arg.rfind("--", 0) != 0) {
+            config.rows  = std::stoi(argv[i]);
+            config.cols  = std::stoi(argv[i + 1]);
+            config.mines = std::stoi(argv[i + 2]);
+            i += 2;
+        } else {
+            return -1;
+        }
+    }
+    if (local < 0) return -1;
+
+    ShardCoordinator coordinator(config);
+    if (coordinator.resumedShards() > 0) {
+        std::cerr << "Resuming: " << coordinator.resumedShards() << " of " << coordinator.shardCount()
+                  << " shards already done\n";
+    }
+
+    // The children only run the worker loop and _exit, so forking without
+    // exec is fine while the coordinator is still single-threaded.
+    std::vector<pid_t> children;
+    for (int w = 0; w < local; ++w) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            int rc = 0;
+            try {
+                runShardWorker(config.socketPath);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+                rc = 1;
+            }
+            _exit(rc);
+        }
+        if (pid > 0) children.push_back(pid);
+    }
+
+    runningCoordinator = &coordinator;
+    std::signal(SIGINT,  handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    const bool finished = coordinator.run();
+    runningCoordinator = nullptr;
+
+    // Workers of an interrupted run see the socket close and exit
+    for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+    std::cerr << coordinator.completedShards() << " of " << coordinator.shardCount() << " shards done"
+              << (finished ? "" : "; run again to resume") << '\n';
+    return finished ? 0 : 2;
+}
+
+int work(int argc, char** argv) {
+    int maxShards = 0;
+    if (argc == 5 && std::string(argv[3]) == "--max-shards") maxShards = std::stoi(argv[4]);
+    else if (argc != 3) return -1;
+
+    const int played = runShardWorker(argv[2], maxShards);
+    std::cerr << "Played " << played << " shards\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int rc = -1;
+    try {
+        const std::string command = argc > 1 ? argv[1] : "";
+        if (command == "coordinate") rc = coordinate(argc, argv);
+        else if (command == "work")  rc = work(argc, argv);
+    } catch (const std::invalid_argument&) {
+        rc = -1;
+    } catch (const std::out_of_range&) {
+        rc = -1;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (rc < 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return rc;
+}
@@ -0,0 +1,84 @@
+#include "SolverWorker.hpp"
+
+#include <algorithm>
+
+// Guesses get the game's whole step delay, enough to look one guess
+// further ahead on a few cores
+SolverWorker::SolverWorker()
+: requests_(16)
+, results_(16)
+, anytime_(GuessSearch::Config{
+      1, 6, static_cast<int>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u))})
+, thread_(&SolverWorker::run, this) {}
+
+SolverWorker::~SolverWorker() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+bool SolverWorker::submit(BoardFork board, std::uint64_t generation) {
+    return push({std::move(board), generation, 0, std::nullopt});
+}
+
+bool SolverWorker::submit(BoardFork board, std::uint64_t generation, int mines,
+                          Clock::time_point deadline) {
+    return push({std::move(board), generation, mines, deadline});
+}
+
+bool SolverWorker::push(Request request) {
+    if (!requests_.push(std::move(request))) return false;
+
+    // Taking the mutex orders the push before the worker's predicate check,
+    // so the wakeup cannot be lost.
+    { std::lock_guard<std::mutex> lock(wakeMutex_); }
+    wake_.notify_one();
+    return true;
+}
+
+bool SolverWorker::poll(Result& out) {
+    return results_.pop(out);
+}
+
+void SolverWorker::run() {
+    Request request;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait(lock, [&] { return stop_ || !requests_.empty(); });
+            if (stop_) return;
+        }
+
+        while (requests_.pop(request)) {
+            Result result{findSolverMove(request.board), request.generation};
+            if (result.move.action != SolverMove::Action::None) {
+                result.tier = AnytimeMove::Tier::TwoRule;
+            } else if (request.deadline) {
+                // Deeper tiers read a masked view of the fork
+                const int rows = request.board.rows();
+                const int cols = request.board.cols();
+                cells_.resize(static_cast<std::size_t>(rows) * cols);
+                for (int y = 0; y < rows; ++y) {
+                    for (int x = 0; x < cols; ++x) cells_[y * cols + x] = request.board.cellAt(x, y);
+                }
+
+                const AnytimeMove best = anytime_.solve(BoardView(rows, cols, cells_.data()),
+                                                        request.mines, *request.deadline);
+                result.move       = best.move;
+                result.proven     = best.proven;
+                result.mineChance = best.mineChance;
+                result.tier       = best.tier;
+            }
+
+            // The owner drains results every frame; if it falls behind, wait
+            // rather than drop an answer it is counting on.
+            while (!results_.push(std::move(result))) {
+                if (stop_) return;
+                std::this_thread::yield();
+            }
+        }
+    }
+}
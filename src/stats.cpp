@@ -0,0 +1,141 @@
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace stats {
+
+namespace {
+
+constexpr std::array<const char*, NUM_COUNTERS> kNames = {
+    "reveal_calls",
+    "tiles_opened",
+    "max_flood_depth",
+    "neighbor_visits",
+    "solver_calls",
+    "solver_cells_scanned",
+    "rule1_fires",
+    "rule2_fires",
+    "first_click_relocations",
+    "mines_relocated",
+    "adjacency_calls",
+    "adjacency_ns",
+};
+
+#if MINESWEEPER_STATS
+
+void combine(Snapshot& into, int i, std::uint64_t value) {
+    if (isMax(static_cast<Counter>(i))) {
+        into.values[i] = std::max(into.values[i], value);
+    } else {
+        into.values[i] += value;
+    }
+}
+
+// Blocks of live threads plus the totals of threads that have exited.
+// Leaked on purpose so thread_local blocks destroyed during static
+// destruction can still unregister.
+struct Registry {
+    std::mutex                  mutex;
+    std::vector<detail::Block*> blocks;
+    Snapshot                    retired;
+};
+
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+#endif
+
+}  // namespace
+
+const char* name(Counter c) {
+    return kNames[static_cast<int>(c)];
+}
+
+bool isMax(Counter c) {
+    return c == Counter::MaxFloodDepth;
+}
+
+#if MINESWEEPER_STATS
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+// Registration locks once per thread; recording never does.
+Block::Block() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.blocks.push_back(this);
+}
+
+Block::~Block() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        combine(r.retired, i, v[i].load(std::memory_order_relaxed));
+    }
+    r.blocks.erase(std::remove(r.blocks.begin(), r.blocks.end(), this), r.blocks.end());
+}
+
+Block& local() {
+    thread_local Block block;
+    return block;
+}
+
+}  // namespace detail
+
+Snapshot snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    Snapshot s = r.retired;
+    for (const detail::Block* b : r.blocks) {
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            combine(s, i, b->v[i].load(std::memory_order_relaxed));
+        }
+    }
+    return s;
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.retired = Snapshot{};
+    for (detail::Block* b : r.blocks) {
+        for (auto& slot : b->v) slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+Snapshot snapshot() {
+    return {};
+}
+
+void reset() {}
+
+#endif
+
+void writeJson(std::ostream& os, const Snapshot& s) {
+    os << "{\n";
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        os << "  \"" << kNames[i] << "\": " << s.values[i]
+           << (i + 1 < NUM_COUNTERS ? ",\n" : "\n");
+    }
+    os << "}\n";
+}
+
+void writeCsv(std::ostream& os, const Snapshot& s) {
+    os << "counter,value\n";
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        os << kNames[i] << ',' << s.values[i] << '\n';
+    }
+}
+
+}  // namespace stats
@@ -0,0 +1,116 @@
+#include "Strategy.hpp"
+#include "AnytimeSolver.hpp"
+#include "PatternTable.hpp"
+#include "Rules.hpp"
+#include "Solver.hpp"
+
+void TwoRuleStrategy::nextMoves(const BoardView& view, std::vector<StrategyMove>& out) {
+    const SolverMove move = findSolverMove(view);
+    if (move.action == SolverMove::Action::None) return;
+
+    const StrategyMove::Action action = move.action == SolverMove::Action::RevealNeighbors
+        ? StrategyMove::Action::Reveal
+        : StrategyMove::Action::Flag;
+    rules::forEachNeighbor(view, move.x, move.y, [&](int nx, int ny) {
+        if (!(view.cellAt(nx, ny) & (cell::REVEALED | cell::FLAGGED))) {
+            out.push_back({action, nx, ny});
+        }
+    });
+}
+
+void PatternStrategy::newGame(int rows, int cols, int /*mines*/) {
+    queued_.assign(static_cast<std::size_t>(rows) * cols, 0);
+}
+
+// Queues the moves of a table entry whose window is anchored at (x, y)
+void PatternStrategy::emit(const BoardView& view, int x, int y, std::uint32_t entry,
+                           const int* dx, const int* dy, int cells, bool transpose,
+                           std::vector<StrategyMove>& out) {
+    for (int i = 0; i < cells; ++i) {
+        const std::uint32_t bit = 1u << i;
+        if (!(entry & (bit | bit << 16))) continue;
+
+        const int nx = x + (transpose ? dy[i] : dx[i]);
+        const int ny = y + (transpose ? dx[i] : dy[i]);
+        std::uint8_t& queued = queued_[ny * view.cols() + nx];
+        if (queued) continue;
+
+        queued = 1;
+        out.push_back({(entry & bit) ? StrategyMove::Action::Reveal : StrategyMove::Action::Flag, nx, ny});
+    }
+}
+
+void PatternStrategy::nextMoves(const BoardView& view, std::vector<StrategyMove>& out) {
+    const int rows = view.rows();
+    const int cols = view.cols();
+    if (queued_.size() != static_cast<std::size_t>(rows) * cols) newGame(rows, cols, 0);
+    const std::size_t first = out.size();
+
+    // Unknown bits of a window around the revealed tile (x, y), and the
+    // flags next to A (dx <= 1) and next to B (dx >= 0)
+    auto window = [&](int x, int y, const int* dx, const int* dy, int cells, bool transpose,
+                      unsigned& unknowns, int& flagsA, int& flagsB) {
+        unknowns = 0;
+        flagsA   = 0;
+        flagsB   = 0;
+        for (int i = 0; i < cells; ++i) {
+            const int nx = x + (transpose ? dy[i] : dx[i]);
+            const int ny = y + (transpose ? dx[i] : dy[i]);
+            if (!view.inBounds(nx, ny)) continue;
+
+            const std::uint8_t n = view.cellAt(nx, ny);
+            if (n & cell::FLAGGED) {
+                if (dx[i] <= 1) ++flagsA;
+                if (dx[i] >= 0) ++flagsB;
+            } else if (!(n & cell::REVEALED)) {
+                unknowns |= 1u << i;
+            }
+        }
+    };
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const std::uint8_t t = view.cellAt(x, y);
+            if (!(t & cell::REVEALED)) continue;
+
+            unsigned unknowns;
+            int flags, unused;
+            window(x, y, patterns::SINGLE_DX, patterns::SINGLE_DY, patterns::SINGLE_CELLS, false,
+                   unknowns, flags, unused);
+            if (!unknowns) continue;
+
+            const int remaining = cell::adjacent(t) - flags;
+            emit(view, x, y, patterns::lookupSingle(unknowns, remaining),
+                 patterns::SINGLE_DX, patterns::SINGLE_DY, patterns::SINGLE_CELLS, false, out);
+
+            // Pairs with the revealed tiles to the right and below
+            for (int transpose = 0; transpose < 2; ++transpose) {
+                const std::uint8_t other = transpose ? view.cellAt(x, y + 1) : view.cellAt(x + 1, y);
+                if (!(other & cell::REVEALED)) continue;
+
+                int flagsA, flagsB;
+                window(x, y, patterns::PAIR_DX, patterns::PAIR_DY, patterns::PAIR_CELLS, transpose,
+                       unknowns, flagsA, flagsB);
+                const std::uint32_t entry = patterns::lookupPair(
+                    unknowns, cell::adjacent(t) - flagsA, cell::adjacent(other) - flagsB);
+                emit(view, x, y, entry, patterns::PAIR_DX, patterns::PAIR_DY, patterns::PAIR_CELLS,
+                     transpose, out);
+            }
+        }
+    }
+
+    for (std::size_t i = first; i < out.size(); ++i) queued_[out[i].y * cols + out[i].x] = 0;
+}
+
+std::vector<StrategyInfo>& strategyRegistry() {
+    static std::vector<StrategyInfo> registry = {
+        {"two-rule",      [] { return std::make_unique<TwoRuleStrategy>(); }},
+        {"pattern-table", [] { return std::make_unique<PatternStrategy>(); }},
+        {"anytime",       [] { return std::make_unique<AnytimeStrategy>(); }, true},
+    };
+    return registry;
+}
+
+void registerStrategy(StrategyInfo info) {
+    strategyRegistry().push_back(std::move(info));
+}
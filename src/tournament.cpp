@@ -0,0 +1,196 @@
+#include "Tournament.hpp"
+#include "BatchEnv.hpp"
+#include "ResultsStore.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+enum class Outcome : std::uint8_t { Win, Loss, Stuck };
+
+struct GameResult {
+    Outcome             outcome = Outcome::Stuck;
+    std::uint64_t       moves   = 0;
+    std::uint32_t       guesses = 0;
+    std::vector<float>  callUs;
+};
+
+// Plays one seeded game to the end on a single-env BatchEnv
+GameResult playGame(Strategy& strategy, const TournamentConfig& config, std::uint32_t seed) {
+    BatchEnv::Config envConfig;
+    envConfig.rows  = config.rows;
+    envConfig.cols  = config.cols;
+    envConfig.mines = config.mines;
+    envConfig.seed  = seed;
+    BatchEnv env(envConfig);
+
+    std::vector<std::uint8_t> obs(env.observationSize());
+    float                     reward = 0.f;
+    std::uint8_t              done   = 0;
+    env.reset(obs.data());
+    strategy.newGame(config.rows, config.cols, config.mines);
+
+    GameResult result;
+    auto apply = [&](BatchEnv::ActionKind kind, int x, int y) {
+        const std::int32_t action = env.encodeAction(kind, x, y);
+        env.step(&action, obs.data(), &reward, &done);
+        ++result.moves;
+    };
+
+    apply(BatchEnv::REVEAL, config.cols / 2, config.rows / 2);
+
+    // A strategy that keeps toggling flags never finishes; cap the calls.
+    const int maxCalls = 4 * env.cellsPerEnv();
+    std::vector<StrategyMove> moves;
+    for (int call = 0; !done && call < maxCalls; ++call) {
+        const BoardView view(config.rows, config.cols, env.cells(0));
+        moves.clear();
+
+        const auto start = std::chrono::steady_clock::now();
+        strategy.nextMoves(view, moves);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        result.callUs.push_back(std::chrono::duration<float, std::micro>(elapsed).count());
+
+        if (moves.empty()) break;
+        for (const StrategyMove& m : moves) {
+            if (!view.inBounds(m.x, m.y)) continue;
+            const BatchEnv::ActionKind kind =
+                m.action == StrategyMove::Action::Reveal ? BatchEnv::REVEAL
+              : m.action == StrategyMove::Action::Flag   ? BatchEnv::FLAG
+              :                                            BatchEnv::CHORD;
+            apply(kind, m.x, m.y);
+            result.guesses += m.guess;
+            if (done) break;
+        }
+    }
+
+    // BatchEnv has already reset a finished game; the last reward says how it ended.
+    if (done) result.outcome = reward < 0.f ? Outcome::Loss : Outcome::Win;
+    return result;
+}
+
+GameRecord toRecord(const GameResult& game, const TournamentConfig& config, std::uint32_t seed,
+                    const std::string& strategy) {
+    float totalUs = 0.f;
+    for (float us : game.callUs) totalUs += us;
+
+    GameRecord r;
+    r.seed     = seed;
+    r.rows     = config.rows;
+    r.cols     = config.cols;
+    r.mines    = config.mines;
+    r.strategy = strategy;
+    r.outcome  = game.outcome == Outcome::Win  ? GameRecord::Outcome::Win
+               : game.outcome == Outcome::Loss ? GameRecord::Outcome::Loss
+               :                                 GameRecord::Outcome::Stuck;
+    r.moves    = static_cast<std::uint32_t>(game.moves);
+    r.guesses  = game.guesses;
+    r.micros   = static_cast<std::uint32_t>(std::lround(totalUs));
+    return r;
+}
+
+double percentile(std::vector<float>& samples, double p) {
+    if (samples.empty()) return 0.0;
+    const int n = static_cast<int>(samples.size());
+    const int k = std::max(0, std::min(n - 1, static_cast<int>(std::ceil(p * n)) - 1));
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+}  // namespace
+
+std::vector<StrategyResult> runTournament(const TournamentConfig& config,
+                                          const std::vector<StrategyInfo>& strategies) {
+    const int numSeeds = static_cast<int>(config.seeds.size());
+    const int numGames = static_cast<int>(strategies.size()) * numSeeds;
+    std::vector<GameResult> games(numGames);
+
+    // Workers pull games off a shared counter; each keeps its own instance
+    // of every strategy and its own results buffer. The first results
+    // write error stops recording and is rethrown once the games are done.
+    std::atomic<int> nextGame{0};
+    std::mutex         errorMutex;
+    std::exception_ptr writeError;
+    auto worker = [&] {
+        std::vector<std::unique_ptr<Strategy>> instances(strategies.size());
+        std::unique_ptr<ResultsWriter::Buffer> records;
+        if (config.results) records = std::make_unique<ResultsWriter::Buffer>(*config.results);
+        auto recordSafely = [&](auto&& write) {
+            if (!records) return;
+            try {
+                write();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!writeError) writeError = std::current_exception();
+                records.reset();
+            }
+        };
+
+        for (int g; (g = nextGame.fetch_add(1, std::memory_order_relaxed)) < numGames; ) {
+            const int s = g / numSeeds;
+            if (!instances[s]) instances[s] = strategies[s].create();
+            games[g] = playGame(*instances[s], config, config.seeds[g % numSeeds]);
+            recordSafely([&] {
+                records->add(toRecord(games[g], config, config.seeds[g % numSeeds], strategies[s].name));
+            });
+        }
+        recordSafely([&] { records->flush(); });
+    };
+
+    const int threads = std::max(1, std::min(config.threads, numGames));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    if (writeError) std::rethrow_exception(writeError);
+
+    // Aggregate per strategy
+    std::vector<StrategyResult> results;
+    for (int s = 0; s < static_cast<int>(strategies.size()); ++s) {
+        StrategyResult r;
+        r.name  = strategies[s].name;
+        r.games = numSeeds;
+
+        std::vector<float> callUs;
+        double totalUs = 0.0;
+        for (int i = 0; i < numSeeds; ++i) {
+            const GameResult& g = games[s * numSeeds + i];
+            r.wins   += g.outcome == Outcome::Win;
+            r.losses += g.outcome == Outcome::Loss;
+            r.stuck  += g.outcome == Outcome::Stuck;
+            r.moves  += g.moves;
+            for (float us : g.callUs) totalUs += us;
+            callUs.insert(callUs.end(), g.callUs.begin(), g.callUs.end());
+        }
+        r.calls     = callUs.size();
+        r.usPerMove = r.moves ? totalUs / r.moves : 0.0;
+        r.maxCallUs = callUs.empty() ? 0.0 : *std::max_element(callUs.begin(), callUs.end());
+        r.p50CallUs = percentile(callUs, 0.50);
+        r.p99CallUs = percentile(callUs, 0.99);
+        results.push_back(r);
+    }
+    return results;
+}
+
+GameRecord playTournamentGame(Strategy& strategy, const std::string& name,
+                              const TournamentConfig& config, std::uint32_t seed) {
+    return toRecord(playGame(strategy, config, seed), config, seed, name);
+}
+
+void writeTournamentCsv(std::ostream& os, const std::vector<StrategyResult>& results) {
+    os << "strategy,games,wins,losses,stuck,win_rate,calls,moves,us_per_move,p50_call_us,p99_call_us,max_call_us\n";
+    for (const StrategyResult& r : results) {
+        os << r.name << ',' << r.games << ',' << r.wins << ',' << r.losses << ','
+           << r.stuck << ',' << r.winRate() << ',' << r.calls << ',' << r.moves << ','
+           << r.usPerMove << ',' << r.p50CallUs << ',' << r.p99CallUs << ','
+           << r.maxCallUs << '\n';
+    }
+}
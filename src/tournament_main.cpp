@@ -0,0 +1,78 @@
+#include "ResultsStore.hpp"
+#include "Tournament.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage(const char* prog) {
+    std::cerr
+        << "Usage:\n"
+        << "  " << prog << " [easy | medium | hard | <rows> <cols> <mines>] [options]\n"
+        << "\n"
+        << "Options:\n"
+        << "  --games <n>      seeds per strategy (default 1000)\n"
+        << "  --seed <s>       first seed; games use s, s+1, ... (default 1)\n"
+        << "  --threads <t>    worker threads (default: hardware concurrency)\n"
+        << "  --results <file> also append every game to a results store (MinesweeperResults)\n"
+        << "\n"
+        << "Plays every registered strategy on the same seeds and prints a CSV summary.\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    TournamentConfig config;                    // hard by default
+    int             games   = 1000;
+    std::uint32_t   seed    = 1;
+    std::string     resultsPath;
+    config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "easy")        { config.rows = 9;  config.cols = 9;  config.mines = 10; }
+            else if (arg == "medium") { config.rows = 16; config.cols = 16; config.mines = 40; }
+            else if (arg == "hard")   { config.rows = 16; config.cols = 30; config.mines = 99; }
+            else if (arg == "--games"   && hasValue) games          = std::stoi(argv[++i]);
+            else if (arg == "--seed"    && hasValue) seed           = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--threads" && hasValue) config.threads = std::stoi(argv[++i]);
+            else if (arg == "--results" && hasValue) resultsPath    = argv[++i];
+            else if (i + 2 < argc) {
+                config.rows  = std::stoi(argv[i]);
+                config.cols  = std::stoi(argv[i + 1]);
+                config.mines = std::stoi(argv[i + 2]);
+                i += 2;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (...) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (config.rows < 3 || config.cols < 3 || config.mines <= 0
+        || config.mines > config.rows * config.cols - 9 || games <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (int g = 0; g < games; ++g) config.seeds.push_back(seed + g);
+    try {
+        std::unique_ptr<ResultsWriter> results;
+        if (!resultsPath.empty()) results = std::make_unique<ResultsWriter>(resultsPath);
+        config.results = results.get();
+        writeTournamentCsv(std::cout, runTournament(config, strategyRegistry()));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
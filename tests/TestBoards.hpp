@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Cell.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+// Board fixtures shared by the test files.
+
+// Rows of tiles, row-major: '*' hidden mine, '.' hidden safe, digits
+// revealed with that many adjacent mines
+inline std::vector<std::uint8_t> gridOf(std::initializer_list<const char*> rows) {
+    std::vector<std::uint8_t> cells;
+    for (const char* row : rows) {
+        for (const char* t = row; *t; ++t) {
+            if (*t == '*')      cells.push_back(cell::MINE);
+            else if (*t == '.') cells.push_back(0);
+            else                cells.push_back(static_cast<std::uint8_t>(cell::REVEALED | (*t - '0') << cell::ADJ_SHIFT));
+        }
+    }
+    return cells;
+}
+
+// A single row, as gridOf
+inline std::vector<std::uint8_t> rowOf(const char* tiles) {
+    return gridOf({tiles});
+}
+
+// Visible state of every tile: 0 hidden, 1 flagged, 2 revealed.
+inline std::vector<int> visibleState(const Board& b, int rows, int cols) {
+    std::vector<int> state;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            state.push_back(b.isRevealed(x, y) ? 2 : b.isFlaggedAt(x, y) ? 1 : 0);
+        }
+    }
+    return state;
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "AnytimeSolver.hpp"
+#include "Board.hpp"
+#include "SolverWorker.hpp"
+#include "TestBoards.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+using Clock = AnytimeSolver::Clock;
+
+Clock::time_point later() { return Clock::now() + std::chrono::seconds(5); }
+
+}  // namespace
+
+TEST_CASE("AnytimeSolver answers from the cheapest tier that proves a move", "[anytime]") {
+    AnytimeSolver solver;
+
+    // Two rules: the 1 has a single hidden neighbor
+    std::vector<std::uint8_t> cells = rowOf("1*");
+    AnytimeMove best = solver.solve(BoardView(1, 2, cells.data()), 1, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::TwoRule);
+    REQUIRE(best.proven);
+    REQUIRE(best.move.action == SolverMove::Action::FlagNeighbors);
+
+    // Pattern table: the 1-2 against a wall
+    Board b(2, 4, kTileSize, 0, 1);
+    b.placeMinesAt({b.index(1, 0), b.index(3, 0)});
+    for (int x = 0; x < 4; ++x) b.reveal(x, 1);
+    best = solver.solve(b.view(), 2, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::Pattern);
+    REQUIRE(best.proven);
+    REQUIRE(best.move.action == SolverMove::Action::RevealTile);
+    REQUIRE_FALSE(b.hasMineAt(best.move.x, best.move.y));
+
+    // Probabilities: both mines sit in the 50/50s, so the middle is safe
+    cells = rowOf("*1...1*");
+    best = solver.solve(BoardView(1, 7, cells.data()), 2, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::Probability);
+    REQUIRE(best.proven);
+    REQUIRE(best.move.action == SolverMove::Action::RevealTile);
+    REQUIRE(best.move.x == 3);
+    REQUIRE(best.mineChance == 0.f);
+
+    // Nothing provable: the safest guess
+    cells = rowOf("*1.");
+    best = solver.solve(BoardView(1, 3, cells.data()), 1, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::Probability);
+    REQUIRE_FALSE(best.proven);
+    REQUIRE(best.mineChance == 0.5f);
+
+    // Nothing left to do
+    cells = rowOf("0");
+    best = solver.solve(BoardView(1, 1, cells.data()), 0, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::None);
+    REQUIRE(best.move.action == SolverMove::Action::None);
+}
+
+TEST_CASE("AnytimeSolver falls back to a local estimate past its deadline", "[anytime]") {
+    AnytimeSolver solver;
+    std::vector<std::uint8_t> cells = rowOf("*1...1*");
+
+    // The middle tile touches no number: 2 mines over 5 hidden tiles
+    const AnytimeMove best = solver.solve(BoardView(1, 7, cells.data()), 2, Clock::now());
+    REQUIRE(best.tier == AnytimeMove::Tier::LocalEstimate);
+    REQUIRE_FALSE(best.proven);
+    REQUIRE(best.move.action == SolverMove::Action::RevealTile);
+    REQUIRE(best.move.x == 3);
+    REQUIRE(best.mineChance == 0.4f);
+}
+
+TEST_CASE("AnytimeStrategy always finishes its games", "[anytime]") {
+    for (std::uint32_t seed = 1; seed <= 20; ++seed) {
+        Board b(9, 9, kTileSize, 10, seed);
+        AnytimeStrategy strategy;
+        strategy.newGame(9, 9, 10);
+
+        std::vector<StrategyMove> moves;
+        bool lost = false;
+        for (int call = 0; call < 400 && !lost && !b.isCleared(); ++call) {
+            moves.clear();
+            strategy.nextMoves(b.view(), moves);
+            REQUIRE_FALSE(moves.empty());
+            for (const StrategyMove& m : moves) {
+                if (m.action == StrategyMove::Action::Flag) {
+                    b.flag(m.x, m.y);
+                    REQUIRE(b.hasMineAt(m.x, m.y));
+                } else {
+                    lost |= b.reveal(m.x, m.y);
+                }
+            }
+        }
+        REQUIRE((lost || b.isCleared()));
+    }
+}
+
+TEST_CASE("SolverWorker runs the anytime tiers when given a deadline", "[anytime][worker]") {
+    Board stuck(3, 3, kTileSize, 0, 1);
+    stuck.placeMinesAt({0, 8});
+    stuck.reveal(1, 1);
+
+    SolverWorker worker;
+    REQUIRE(worker.submit(stuck.fork(), 3, 2, later()));
+
+    SolverWorker::Result result;
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    bool answered = false;
+    while (!answered && Clock::now() < deadline) {
+        answered = worker.poll(result);
+        if (!answered) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(answered);
+    REQUIRE(result.generation == 3);
+    REQUIRE(result.tier == AnytimeMove::Tier::Probability);
+    REQUIRE_FALSE(result.proven);
+    REQUIRE(result.move.action == SolverMove::Action::RevealTile);
+    REQUIRE(result.mineChance == 0.25f);
+
+    // Applying a guess reveals just that tile
+    REQUIRE(stuck.applySolverMove(result.move));
+    REQUIRE(stuck.isRevealed(result.move.x, result.move.y));
+}
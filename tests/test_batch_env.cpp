@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "BatchEnv.hpp"
+#include "Board.hpp"
+#include "Cell.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+BatchEnv::Config smallConfig(int numEnvs, int threads) {
+    BatchEnv::Config c;
+    c.rows    = 9;
+    c.cols    = 9;
+    c.mines   = 10;
+    c.numEnvs = numEnvs;
+    c.seed    = 1234;
+    c.threads = threads;
+    return c;
+}
+
+}  // namespace
+
+TEST_CASE("BatchEnv episodes match Board games with the same seed", "[batch]") {
+    BatchEnv env(smallConfig(4, 1));
+    std::vector<std::uint8_t> obs(env.observationSize());
+    std::vector<float>        rewards(env.numEnvs());
+    std::vector<std::uint8_t> dones(env.numEnvs());
+    env.reset(obs.data());
+
+    // Reveal the center of every env, then compare with Board
+    std::vector<std::int32_t> actions(env.numEnvs(), env.encodeAction(BatchEnv::REVEAL, 4, 4));
+    std::vector<std::uint32_t> seeds;
+    for (int e = 0; e < env.numEnvs(); ++e) seeds.push_back(env.episodeSeed(e));
+    env.step(actions.data(), obs.data(), rewards.data(), dones.data());
+
+    for (int e = 0; e < env.numEnvs(); ++e) {
+        if (dones[e]) continue;                 // cleared in one click
+        Board b(9, 9, kTileSize, 10, seeds[e]);
+        b.reveal(4, 4);
+
+        const std::uint8_t* cells = env.cells(e);
+        const std::uint8_t* plane = obs.data() + e * BatchEnv::OBS_PLANES * env.cellsPerEnv();
+        for (int y = 0; y < 9; ++y) {
+            for (int x = 0; x < 9; ++x) {
+                const int i = y * 9 + x;
+                REQUIRE(static_cast<bool>(cells[i] & cell::MINE) == b.hasMineAt(x, y));
+                REQUIRE(plane[i] == b.isRevealed(x, y));
+                if (b.isRevealed(x, y)) {
+                    REQUIRE(plane[2 * 81 + i] == b.getAdjacentMines(x, y));
+                }
+            }
+        }
+        REQUIRE(rewards[e] > 0.f);
+    }
+}
+
+TEST_CASE("BatchEnv resets finished envs with the next seed", "[batch]") {
+    BatchEnv env(smallConfig(2, 1));
+    std::vector<std::uint8_t> obs(env.observationSize());
+    std::vector<float>        rewards(2);
+    std::vector<std::uint8_t> dones(2);
+    env.reset(obs.data());
+    REQUIRE(env.episodeSeed(0) == 1234);
+    REQUIRE(env.episodeSeed(1) == 1235);
+
+    // First click is always safe, so play env 0 until it hits a mine
+    std::vector<std::int32_t> actions = {env.encodeAction(BatchEnv::REVEAL, 0, 0), -1};
+    env.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    REQUIRE(rewards[0] > 0.f);
+    REQUIRE(rewards[1] == 0.f);
+
+    if (!dones[0]) {
+        int mine = -1;
+        for (int i = 0; i < env.cellsPerEnv() && mine < 0; ++i) {
+            if (env.cells(0)[i] & cell::MINE) mine = i;
+        }
+        REQUIRE(mine >= 0);
+        actions[0] = env.encodeAction(BatchEnv::REVEAL, mine % 9, mine / 9);
+        env.step(actions.data(), obs.data(), rewards.data(), dones.data());
+        REQUIRE(rewards[0] == -1.f);
+    }
+    REQUIRE(dones[0] == 1);
+    REQUIRE(dones[1] == 0);
+    REQUIRE(env.episodeSeed(0) == 1234 + 2);
+    REQUIRE(env.episodeSeed(1) == 1235);
+
+    // The replacement board is fresh
+    for (int i = 0; i < env.cellsPerEnv(); ++i) REQUIRE(obs[i] == 0);
+}
+
+TEST_CASE("BatchEnv flag toggles the flag plane", "[batch]") {
+    BatchEnv env(smallConfig(1, 1));
+    std::vector<std::uint8_t> obs(env.observationSize());
+    float                     reward;
+    std::uint8_t              done;
+    env.reset(obs.data());
+
+    std::int32_t action = env.encodeAction(BatchEnv::FLAG, 3, 2);
+    env.step(&action, obs.data(), &reward, &done);
+    REQUIRE(obs[81 + 2 * 9 + 3] == 1);
+    REQUIRE(reward == 0.f);
+    env.step(&action, obs.data(), &reward, &done);
+    REQUIRE(obs[81 + 2 * 9 + 3] == 0);
+}
+
+TEST_CASE("BatchEnv rejects boards too dense for a safe first click", "[batch]") {
+    BatchEnv::Config c = smallConfig(1, 1);
+    c.rows  = 3;
+    c.cols  = 3;
+    c.mines = 5;
+    REQUIRE_THROWS_AS(BatchEnv(c), std::invalid_argument);
+
+    // The densest board allowed: the first click's 3x3 holds every safe tile
+    c.rows  = 4;
+    c.cols  = 4;
+    c.mines = 7;
+    BatchEnv env(c);
+    std::vector<std::uint8_t> obs(env.observationSize());
+    float                     reward;
+    std::uint8_t              done;
+    env.reset(obs.data());
+
+    std::int32_t action = env.encodeAction(BatchEnv::REVEAL, 1, 1);
+    env.step(&action, obs.data(), &reward, &done);
+    REQUIRE(reward == 1.f);
+    REQUIRE(done == 1);
+}
+
+TEST_CASE("BatchEnv threaded stepping matches single-threaded", "[batch]") {
+    BatchEnv serial  (smallConfig(37, 1));
+    BatchEnv threaded(smallConfig(37, 4));
+    const int N = serial.numEnvs();
+
+    std::vector<std::uint8_t> obsA(serial.observationSize()), obsB(obsA.size());
+    std::vector<float>        rewA(N), rewB(N);
+    std::vector<std::uint8_t> doneA(N), doneB(N);
+    serial.reset(obsA.data());
+    threaded.reset(obsB.data());
+    REQUIRE(obsA == obsB);
+
+    // Deterministic pseudo-random action stream
+    std::uint32_t state = 99;
+    std::vector<std::int32_t> actions(N);
+    for (int s = 0; s < 200; ++s) {
+        for (auto& a : actions) {
+            state = state * 1664525u + 1013904223u;
+            a = static_cast<std::int32_t>((state >> 8) % serial.actionCount());
+        }
+        serial.step(actions.data(), obsA.data(), rewA.data(), doneA.data());
+        threaded.step(actions.data(), obsB.data(), rewB.data(), doneB.data());
+        REQUIRE(obsA == obsB);
+        REQUIRE(rewA == rewB);
+        REQUIRE(doneA == doneB);
+    }
+}
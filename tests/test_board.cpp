@@ -1,8 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "Board.hpp"
+#include "TestBoards.hpp"
 
+#include <chrono>
 #include <cstdint>
+#include <sstream>
 #include <vector>
 
 namespace {
@@ -287,6 +290,276 @@ TEST_CASE("isCleared becomes true after all non-mines are revealed", "[board][wi
     REQUIRE(b.isCleared());
 }
 
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+TEST_CASE("Snapshot round-trips a mid-game position", "[board][snapshot]") {
+    Board a(16, 30, kTileSize, 99, kSeedA);
+    a.reveal(15, 8);
+    a.flag(0, 0);
+    while (a.AISolver()) {}
+
+    std::stringstream buf;
+    a.save(buf);
+
+    Board b(9, 9, kTileSize, 10, kSeedB);
+    b.load(buf);
+
+    REQUIRE(mineLayout(b, 16, 30) == mineLayout(a, 16, 30));
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 30; ++x) {
+            REQUIRE(b.isRevealed(x, y)       == a.isRevealed(x, y));
+            REQUIRE(b.isFlaggedAt(x, y)      == a.isFlaggedAt(x, y));
+            REQUIRE(b.getAdjacentMines(x, y) == a.getAdjacentMines(x, y));
+        }
+    }
+}
+
+TEST_CASE("Snapshot preserves first-click safety and RNG state", "[board][snapshot]") {
+    Board a(9, 9, kTileSize, 0, kSeedA);
+    std::vector<int> ring;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) ring.push_back((4 + dy) * 9 + (4 + dx));
+    }
+    a.placeMinesAt(ring, /*consumeFirstClick=*/false);
+
+    std::stringstream buf;
+    a.save(buf);
+    Board b(9, 9, kTileSize, 0, kSeedB);
+    b.load(buf);
+
+    // Both boards relocate the same mines to the same tiles.
+    a.reveal(4, 4);
+    b.reveal(4, 4);
+    REQUIRE_FALSE(b.hasMineAt(4, 4));
+    REQUIRE(mineLayout(b, 9, 9) == mineLayout(a, 9, 9));
+}
+
+TEST_CASE("Snapshot of an unrevealed board is compact", "[board][snapshot]") {
+    Board b(100, 100, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0, 5000, 9999});
+
+    std::stringstream buf;
+    b.save(buf);
+
+    // 10000 mine bits plus one visibility run, and the fixed RNG state.
+    const std::size_t rngBytes = 4 * 625 + 2;
+    REQUIRE(buf.str().size() < 10000 / 8 + rngBytes + 32);
+}
+
+TEST_CASE("Malformed snapshots are rejected without side effects", "[board][snapshot][adversarial]") {
+    Board a(5, 5, kTileSize, 0, kSeedA);
+    a.placeMinesAt({0});
+    a.reveal(4, 4);
+    std::stringstream buf;
+    a.save(buf);
+    const std::string bytes = buf.str();
+
+    Board b(3, 3, kTileSize, 0, kSeedB);
+    b.placeMinesAt({4});
+
+    SECTION("Truncated payload") {
+        std::stringstream cut(bytes.substr(0, bytes.size() - 1));
+        REQUIRE_THROWS(b.load(cut));
+    }
+    SECTION("Bad magic") {
+        std::stringstream bad("XXXX" + bytes.substr(4));
+        REQUIRE_THROWS(b.load(bad));
+    }
+    SECTION("Dimensions whose product wraps to the real tile count") {
+        // (2^63 + 5)^2 == 25 mod 2^64; the rest is the 5x5 payload as saved
+        auto varint = [](std::uint64_t v) {
+            std::string s;
+            for (; v >= 0x80; v >>= 7) s += static_cast<char>((v & 0x7F) | 0x80);
+            return s + static_cast<char>(v);
+        };
+        std::size_t p = 5;
+        while (static_cast<std::uint8_t>(bytes[p]) & 0x80) ++p;
+        const std::string huge    = varint((1ull << 63) + 5);
+        const std::string payload = huge + huge + bytes.substr(p + 3);  // past the size and 5, 5
+        std::stringstream bad(bytes.substr(0, 5) + varint(payload.size()) + payload);
+        REQUIRE_THROWS(b.load(bad));
+    }
+
+    REQUIRE(b.inBounds(2, 2));
+    REQUIRE_FALSE(b.inBounds(3, 3));
+    REQUIRE(b.hasMineAt(1, 1));
+}
+
+// =============================================================================
+// Undo / redo
+// =============================================================================
+
+TEST_CASE("Undo reverts a flood-fill reveal and redo re-applies it", "[board][undo]") {
+    Board b(9, 9, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+    const auto before = visibleState(b, 9, 9);
+
+    b.reveal(8, 8);
+    const auto after = visibleState(b, 9, 9);
+    REQUIRE(b.isCleared());
+
+    REQUIRE(b.undo());
+    REQUIRE(visibleState(b, 9, 9) == before);
+    REQUIRE_FALSE(b.canUndo());
+
+    REQUIRE(b.redo());
+    REQUIRE(visibleState(b, 9, 9) == after);
+    REQUIRE_FALSE(b.canRedo());
+}
+
+TEST_CASE("Undoing the first click restores the original layout", "[board][undo][first-click]") {
+    Board b(9, 9, kTileSize, 0, kSeedA);
+    b.placeMinesAt({4 * 9 + 4, 0}, /*consumeFirstClick=*/false);
+    const auto layout = mineLayout(b, 9, 9);
+
+    b.reveal(4, 4);
+    REQUIRE_FALSE(b.hasMineAt(4, 4));
+
+    REQUIRE(b.undo());
+    REQUIRE(mineLayout(b, 9, 9) == layout);
+    REQUIRE(b.getAdjacentMines(3, 3) == 1);
+    REQUIRE_FALSE(b.isRevealed(4, 4));
+
+    // First-click safety is pending again.
+    REQUIRE_FALSE(b.reveal(4, 4));
+}
+
+TEST_CASE("Undo steps back through flags and solver moves in order", "[board][undo][ai]") {
+    Board b(5, 5, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+
+    b.reveal(1, 1);
+    b.flag(0, 0);
+    REQUIRE(b.AISolver());                // rule 1 reveals the rest
+    REQUIRE(b.isRevealed(2, 2));
+
+    REQUIRE(b.undo());                    // solver step
+    REQUIRE_FALSE(b.isRevealed(2, 2));
+    REQUIRE(b.isFlaggedAt(0, 0));
+
+    REQUIRE(b.undo());                    // flag
+    REQUIRE_FALSE(b.isFlaggedAt(0, 0));
+
+    REQUIRE(b.undo());                    // reveal
+    REQUIRE_FALSE(b.isRevealed(1, 1));
+    REQUIRE_FALSE(b.undo());
+}
+
+TEST_CASE("A new move discards the redo history", "[board][undo]") {
+    Board b(5, 5, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+
+    b.flag(4, 4);
+    REQUIRE(b.undo());
+    REQUIRE(b.canRedo());
+
+    b.flag(2, 2);
+    REQUIRE_FALSE(b.canRedo());
+    REQUIRE_FALSE(b.isFlaggedAt(4, 4));
+}
+
+TEST_CASE("No-op moves and disabled journaling record nothing", "[board][undo]") {
+    Board b(5, 5, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+    b.reveal(4, 4);
+    REQUIRE(b.undo());
+    REQUIRE(b.redo());
+
+    b.flag(4, 4);                         // revealed: no-op
+    REQUIRE(b.undo());                    // undoes the reveal, not the flag
+    REQUIRE_FALSE(b.isRevealed(4, 4));
+
+    b.setJournaling(false);
+    b.reveal(4, 4);
+    REQUIRE_FALSE(b.canUndo());
+    REQUIRE_FALSE(b.undo());
+}
+
+// =============================================================================
+// Change lists
+// =============================================================================
+
+namespace {
+
+std::vector<std::uint8_t> rawCells(const Board& b) {
+    std::vector<std::uint8_t> cells;
+    for (int y = 0; y < b.rows(); ++y) {
+        for (int x = 0; x < b.cols(); ++x) cells.push_back(b.cellAt(x, y));
+    }
+    return cells;
+}
+
+// Replaying the list onto the old bytes must give the new ones, each entry
+// picking up where the previous write to its tile left off
+void requireChangesReplay(std::vector<std::uint8_t> cells, const std::vector<CellChange>& changes,
+                          const Board& after) {
+    for (const CellChange& c : changes) {
+        REQUIRE(cells[c.index] == c.before);
+        REQUIRE(c.before != c.after);
+        cells[c.index] = c.after;
+    }
+    REQUIRE(cells == rawCells(after));
+
+    int hiddenSafe = 0, flags = 0;
+    for (std::uint8_t t : cells) {
+        hiddenSafe += !(t & (cell::REVEALED | cell::MINE));
+        flags      += (t & cell::FLAGGED) != 0;
+    }
+    REQUIRE(after.isCleared() == (hiddenSafe == 0));
+    REQUIRE(after.flagCount() == flags);
+}
+
+}  // namespace
+
+TEST_CASE("Change lists hold exactly the bytes each move rewrote", "[board][changes]") {
+    Board b(16, 16, kTileSize, 40, kSeedB);
+    std::vector<CellChange> changes;
+
+    auto step = [&](auto&& move) {
+        const std::vector<std::uint8_t> before = rawCells(b);
+        changes.clear();
+        move();
+        requireChangesReplay(before, changes, b);
+    };
+
+    step([&] { b.reveal(8, 8, &changes); });          // first click: relocation + flood
+    REQUIRE_FALSE(changes.empty());
+    bool progressed = true;
+    while (progressed) step([&] { progressed = b.AISolver(&changes); });
+    step([&] { b.flag(0, 0, &changes); });
+    step([&] { b.chord(8, 8, &changes); });
+    step([&] { b.undo(&changes); });
+    step([&] { b.undo(&changes); });
+    step([&] { b.redo(&changes); });
+
+    // No-op moves report nothing
+    step([&] { b.reveal(8, 8, &changes); });
+    REQUIRE(changes.empty());
+    step([&] { b.reveal(-1, 0, &changes); });
+    REQUIRE(changes.empty());
+}
+
+TEST_CASE("Change lists append across calls until the caller clears them", "[board][changes]") {
+    Board b(5, 5, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+    const std::vector<std::uint8_t> start = rawCells(b);
+
+    std::vector<CellChange> changes;
+    b.flag(4, 4, &changes);
+    b.flag(4, 4, &changes);
+    b.reveal(1, 1, &changes);
+    REQUIRE(changes.size() == 3);
+    requireChangesReplay(start, changes, b);
+
+    b.flag(0, 0);
+    REQUIRE(b.flagCount() == 1);
+    REQUIRE(b.runAISolver(std::chrono::steady_clock::now() + std::chrono::seconds(10), &changes) > 0);
+    REQUIRE(b.isCleared());
+    REQUIRE(changes.size() == 3 + 23);                 // the 23 tiles rule 1 revealed
+}
+
 // =============================================================================
 // Adversarial / brittleness probes
 //
@@ -347,6 +620,67 @@ TEST_CASE("Repeated AISolver calls reach a fixed point", "[board][ai][terminatio
     REQUIRE(iterations >= 1);             // sanity: at least one move was made
 }
 
+TEST_CASE("runAISolver matches repeated AISolver calls", "[board][ai]") {
+    Board a(16, 30, kTileSize, 99, kSeedA);
+    Board b(16, 30, kTileSize, 99, kSeedA);
+    a.reveal(15, 8);
+    b.reveal(15, 8);
+
+    int steps = 0;
+    while (a.AISolver()) {
+        ++steps;
+        if (a.isCleared()) break;
+    }
+    REQUIRE(steps > 1);
+
+    // An expired deadline still makes progress, one step at a time
+    REQUIRE(b.runAISolver(std::chrono::steady_clock::now()) == 1);
+    REQUIRE(1 + b.runAISolver(std::chrono::steady_clock::now() + std::chrono::seconds(10)) == steps);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 30; ++x) REQUIRE(b.cellAt(x, y) == a.cellAt(x, y));
+    }
+    REQUIRE(b.runAISolver(std::chrono::steady_clock::now() + std::chrono::seconds(10)) == 0);
+
+    // Every step undoes on its own
+    int undone = 0;
+    while (b.canUndo() && b.undo()) ++undone;
+    REQUIRE(undone == steps + 1);         // plus the opening reveal
+}
+
+TEST_CASE("AISolver resumes its scan but makes the moves of a full scan", "[board][ai]") {
+    Board b(30, 40, kTileSize, 180, kSeedB);
+    b.reveal(20, 15);
+
+    // Player moves, undo and redo between steps must all be picked up
+    int steps = 0;
+    for (int round = 0; round < 2000; ++round) {
+        if (round % 7 == 3 && b.canUndo()) b.undo();
+        if (round % 11 == 5 && b.canRedo()) b.redo();
+        if (round % 13 == 9) b.flag(round % 40, (round / 40) % 30);
+
+        const SolverMove expected = findSolverMove(b);
+        const bool moved = b.AISolver();
+        REQUIRE(moved == (expected.action != SolverMove::Action::None));
+        if (!moved) break;
+        REQUIRE(b.getHighlightX() == expected.x);
+        REQUIRE(b.getHighlightY() == expected.y);
+        ++steps;
+    }
+    REQUIRE(steps > 20);
+
+    // A reset restarts the scan from the top
+    b.reset(9, 9, 10, kSeedA);
+    b.reveal(4, 4);
+    while (true) {
+        const SolverMove expected = findSolverMove(b);
+        const bool moved = b.AISolver();
+        REQUIRE(moved == (expected.action != SolverMove::Action::None));
+        if (!moved) break;
+        REQUIRE(b.getHighlightX() == expected.x);
+        REQUIRE(b.getHighlightY() == expected.y);
+    }
+}
+
 TEST_CASE("placeMinesAt clamps out-of-range indices", "[board][safety]") {
     Board b(3, 3, kTileSize, 0, kSeedA);
     b.placeMinesAt({-1, 0, 9, 100});      // only 0 is valid for a 3x3
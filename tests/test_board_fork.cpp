@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "BoardFork.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float         kTileSize = 50.f;
+constexpr std::uint32_t kSeedA    = 0xC0FFEEu;
+
+}  // namespace
+
+TEST_CASE("Fork mirrors the board it was taken from", "[fork]") {
+    Board b(16, 30, kTileSize, 99, kSeedA);
+    b.reveal(15, 8);
+    b.flag(0, 0);
+
+    const BoardFork f = b.fork();
+    REQUIRE(f.rows() == 16);
+    REQUIRE(f.cols() == 30);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 30; ++x) {
+            REQUIRE(f.isRevealed(x, y)       == b.isRevealed(x, y));
+            REQUIRE(f.isFlaggedAt(x, y)      == b.isFlaggedAt(x, y));
+            REQUIRE(f.hasMineAt(x, y)        == b.hasMineAt(x, y));
+            REQUIRE(f.getAdjacentMines(x, y) == b.getAdjacentMines(x, y));
+        }
+    }
+}
+
+TEST_CASE("Fork moves match Board moves", "[fork]") {
+    Board b(9, 9, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0, 40});
+
+    BoardFork f = b.fork();
+    REQUIRE(f.reveal(8, 8) == b.reveal(8, 8));
+    f.flag(0, 0);
+    b.flag(0, 0);
+    REQUIRE(f.chord(1, 1) == b.chord(1, 1));
+    REQUIRE(f.isCleared() == b.isCleared());
+
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) {
+            REQUIRE(f.isRevealed(x, y) == b.isRevealed(x, y));
+        }
+    }
+
+    REQUIRE(f.reveal(4, 4));              // mine at index 40
+}
+
+TEST_CASE("Forks are independent and share untouched pages", "[fork]") {
+    Board b(100, 100, kTileSize, 0, kSeedA);
+    b.placeMinesAt({5050});
+
+    const BoardFork root = b.fork();
+    REQUIRE(root.pageCount() == (100 * 100 + BoardFork::PAGE_CELLS - 1) / BoardFork::PAGE_CELLS);
+
+    BoardFork child = root.fork();
+    REQUIRE(child.sharedPageCount(root) == root.pageCount());
+
+    child.flag(0, 0);
+    REQUIRE(child.isFlaggedAt(0, 0));
+    REQUIRE_FALSE(root.isFlaggedAt(0, 0));
+    REQUIRE(child.sharedPageCount(root) == root.pageCount() - 1);
+
+    // Writing again to an owned page copies nothing further.
+    child.flag(1, 0);
+    REQUIRE(child.sharedPageCount(root) == root.pageCount() - 1);
+}
+
+TEST_CASE("Forks can be mutated concurrently from different threads", "[fork][threads]") {
+    Board b(64, 64, kTileSize, 0, kSeedA);
+    std::vector<int> column;
+    for (int y = 0; y < 64; ++y) column.push_back(y * 64 + 32);
+    b.placeMinesAt(column);              // a wall splits the board in two
+
+    const BoardFork root = b.fork();
+    constexpr int kThreads = 8;
+    std::vector<BoardFork> results(kThreads, root);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int round = 0; round < 50; ++round) {
+                BoardFork f = root.fork();
+                f.reveal(t % 2 == 0 ? 0 : 63, t);
+                f.flag(32, t);
+                results[t] = f;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    REQUIRE_FALSE(root.isRevealed(0, 0));
+    for (int t = 0; t < kThreads; ++t) {
+        const bool leftSide = t % 2 == 0;
+        REQUIRE(results[t].isRevealed(leftSide ? 0 : 63, 63));
+        REQUIRE_FALSE(results[t].isRevealed(leftSide ? 63 : 0, 63));
+        REQUIRE(results[t].isFlaggedAt(32, t));
+    }
+}
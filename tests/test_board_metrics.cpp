@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "BoardMetrics.hpp"
+#include "SeedSearch.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+std::vector<std::uint8_t> cellsOf(const Board& b) {
+    std::vector<std::uint8_t> cells;
+    for (int y = 0; y < b.rows(); ++y) {
+        for (int x = 0; x < b.cols(); ++x) cells.push_back(b.cellAt(x, y));
+    }
+    return cells;
+}
+
+}  // namespace
+
+TEST_CASE("LayoutMeter deals the layout Board deals", "[metrics]") {
+    LayoutMeter meter;
+    for (std::uint32_t seed = 1; seed <= 20; ++seed) {
+        Board b(16, 30, kTileSize, 99, seed);
+        b.reveal(7, 3);
+
+        const std::vector<std::uint8_t>& cells = meter.deal(16, 30, 99, seed, 7, 3);
+        for (int i = 0; i < 16 * 30; ++i) {
+            REQUIRE((cells[i] & cell::MINE) == (b.cellAt(i % 30, i / 30) & cell::MINE));
+            REQUIRE(cell::adjacent(cells[i]) == cell::adjacent(b.cellAt(i % 30, i / 30)));
+        }
+    }
+}
+
+TEST_CASE("LayoutMeter counts openings, isolated numbers and 3BV", "[metrics]") {
+    // One mine in the middle of a 3x5: a 0 column on each side, and the
+    // numbers above and below the mine touch no 0 tile
+    Board b(3, 5, kTileSize, 0, 1);
+    b.placeMinesAt({b.index(2, 1)});
+
+    LayoutMeter meter;
+    const BoardMetrics m = meter.measure(cellsOf(b), 3, 5, 0, 1);
+    REQUIRE(m.openings == 2);
+    REQUIRE(m.largestOpening == 6);
+    REQUIRE(m.isolated == 2);
+    REQUIRE(m.bbbv == 4);
+    REQUIRE(m.guesses == 1);        // a blind 1-of-3 beside the left opening
+
+    // No mines: one click clears everything
+    Board empty(4, 4, kTileSize, 0, 1);
+    const BoardMetrics e = meter.measure(cellsOf(empty), 4, 4, 1, 1);
+    REQUIRE(e.openings == 1);
+    REQUIRE(e.largestOpening == 16);
+    REQUIRE(e.bbbv == 1);
+    REQUIRE(e.guesses == 0);
+}
+
+TEST_CASE("LayoutMeter finds no guesses exactly when the two rules clear the board", "[metrics]") {
+    LayoutMeter meter;
+    int noGuess = 0;
+    for (std::uint32_t seed = 1; seed <= 200; ++seed) {
+        Board b(9, 9, kTileSize, 10, seed);
+        b.reveal(4, 4);
+        while (b.AISolver()) {}
+
+        const BoardMetrics m = meter.measure(meter.deal(9, 9, 10, seed, 4, 4), 9, 9, 4, 4);
+        REQUIRE((m.guesses == 0) == b.isCleared());
+        REQUIRE(m.bbbv >= m.openings);
+        noGuess += m.guesses == 0;
+    }
+    REQUIRE(noGuess > 0);
+    REQUIRE(noGuess < 200);
+}
+
+TEST_CASE("searchSeeds returns the first matches in seed order on any thread count", "[metrics]") {
+    SeedSearchConfig config;
+    config.rows        = 9;
+    config.cols        = 9;
+    config.mines       = 10;
+    config.startX      = 4;
+    config.startY      = 4;
+    config.firstSeed   = 1000;
+    config.count       = 10000;
+    config.bbbv        = {15, 25};
+    config.guesses     = {0, 0};
+
+    config.threads = 1;
+    const std::vector<SeedMatch> serial = searchSeeds(config);
+    REQUIRE(serial.size() > 5);
+
+    config.threads = 4;
+    std::uint64_t scanned = 0;
+    const std::vector<SeedMatch> parallel = searchSeeds(config, &scanned);
+    REQUIRE(scanned == config.count);
+    REQUIRE(parallel.size() == serial.size());
+
+    LayoutMeter meter;
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        REQUIRE(parallel[i].seed == serial[i].seed);
+        if (i > 0) REQUIRE(serial[i].seed > serial[i - 1].seed);
+
+        const BoardMetrics m = meter.measure(meter.deal(9, 9, 10, serial[i].seed, 4, 4), 9, 9, 4, 4);
+        REQUIRE(m.bbbv == serial[i].metrics.bbbv);
+        REQUIRE(m.guesses == serial[i].metrics.guesses);
+        REQUIRE(config.bbbv.contains(m.bbbv));
+        REQUIRE(config.guesses.contains(m.guesses));
+    }
+
+    // A limit keeps the prefix and stops scanning early
+    config.limit = 3;
+    const std::vector<SeedMatch> first = searchSeeds(config, &scanned);
+    REQUIRE(first.size() == 3);
+    for (int i = 0; i < 3; ++i) REQUIRE(first[i].seed == serial[i].seed);
+    REQUIRE(scanned < config.count);
+
+    std::ostringstream csv;
+    writeSeedCsv(csv, first);
+    REQUIRE(csv.str().rfind("seed,3bv,openings,largest_opening,isolated,guesses\n", 0) == 0);
+}
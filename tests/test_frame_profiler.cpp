@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "FrameProfiler.hpp"
+
+#include <sstream>
+#include <string>
+
+using Series = FrameProfiler::Series;
+
+TEST_CASE("FrameProfiler reports nearest-rank percentiles", "[profiler]") {
+    FrameProfiler p;
+    for (int i = 1; i <= 100; ++i) p.addSample(Series::Update, static_cast<float>(i));
+
+    const FrameProfiler::Summary s = p.summary(Series::Update);
+    REQUIRE(s.samples == 100);
+    REQUIRE(s.p50Ms == 50.f);
+    REQUIRE(s.p99Ms == 99.f);
+    REQUIRE(s.maxMs == 100.f);
+
+    const FrameProfiler::Summary empty = p.summary(Series::Display);
+    REQUIRE(empty.samples == 0);
+    REQUIRE(empty.maxMs == 0.f);
+}
+
+TEST_CASE("FrameProfiler keeps only the most recent window", "[profiler]") {
+    FrameProfiler p;
+    for (int i = 0; i < FrameProfiler::WINDOW; ++i) p.addSample(Series::Frame, 100.f);
+    for (int i = 0; i < FrameProfiler::WINDOW; ++i) p.addSample(Series::Frame, 1.f);
+
+    const FrameProfiler::Summary s = p.summary(Series::Frame);
+    REQUIRE(s.samples == FrameProfiler::WINDOW);
+    REQUIRE(s.maxMs == 1.f);
+}
+
+TEST_CASE("FrameProfiler records phases, frames and click latency", "[profiler]") {
+    FrameProfiler p;
+    for (int f = 0; f < 3; ++f) {
+        p.beginFrame();
+        if (f == 1) {
+            p.inputReceived();
+            p.inputReceived();
+        }
+        p.endPhase(Series::Events);
+        p.endPhase(Series::Update);
+        p.endPhase(Series::BoardDraw);
+        p.endPhase(Series::UiDraw);
+        p.endPhase(Series::Display);
+        p.endFrame();
+    }
+
+    REQUIRE(p.summary(Series::Events).samples       == 3);
+    REQUIRE(p.summary(Series::Display).samples      == 3);
+    REQUIRE(p.summary(Series::Frame).samples        == 3);
+    REQUIRE(p.summary(Series::InputLatency).samples == 2);
+    REQUIRE(p.summary(Series::Frame).maxMs >= p.summary(Series::Update).maxMs);
+
+    std::ostringstream report;
+    p.writeReport(report);
+    REQUIRE(report.str().rfind("series,samples,p50_ms,p99_ms,max_ms\n", 0) == 0);
+    REQUIRE(report.str().find("\ninput_latency,2,") != std::string::npos);
+    REQUIRE(p.overlayText().find("board_draw") != std::string::npos);
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "BoardMetrics.hpp"
+#include "GameFeed.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Kind = GameFeed::Update::Kind;
+
+GameFeed::Config denseFeed(int boards, int threads) {
+    GameFeed::Config config;
+    config.rows      = 9;
+    config.cols      = 9;
+    config.mines     = 15;            // dense enough that games are lost too
+    config.boards    = boards;
+    config.threads   = threads;
+    config.seed      = 500;
+    config.moveDelay = std::chrono::milliseconds(0);
+    config.holdTime  = std::chrono::milliseconds(0);
+    return config;
+}
+
+}  // namespace
+
+TEST_CASE("GameFeed updates rebuild every board and its outcomes", "[feed]") {
+    const GameFeed::Config config = denseFeed(6, 2);
+    const int N = config.rows * config.cols;
+
+    std::vector<std::vector<std::uint8_t>> mirror(config.boards, std::vector<std::uint8_t>(N, 0));
+    std::vector<std::uint32_t>             seeds(config.boards, 0);
+    std::vector<std::uint32_t>             games(config.boards, 0);
+    int won = 0, finished = 0;
+
+    LayoutMeter meter;
+    auto checkFinished = [&](int b, Kind kind) {
+        int hiddenSafe = 0, revealedMines = 0;
+        for (std::uint8_t c : mirror[b]) {
+            hiddenSafe    += !(c & (cell::REVEALED | cell::MINE));
+            revealedMines += (c & cell::REVEALED) && (c & cell::MINE);
+        }
+        if (kind == Kind::Won)  REQUIRE(hiddenSafe == 0);
+        if (kind == Kind::Lost) REQUIRE(revealedMines == 1);
+        if (kind == Kind::Stuck) REQUIRE((hiddenSafe > 0 && revealedMines == 0));
+
+        // The mirrored layout is the one Board deals for that seed and click
+        const std::vector<std::uint8_t>& dealt = meter.deal(config.rows, config.cols, config.mines,
+                                                            seeds[b], config.cols / 2, config.rows / 2);
+        for (int i = 0; i < N; ++i) {
+            REQUIRE((mirror[b][i] & cell::MINE) == (dealt[i] & cell::MINE));
+            REQUIRE(cell::adjacent(mirror[b][i]) == cell::adjacent(dealt[i]));
+        }
+    };
+
+    {
+        GameFeed feed(config);
+        std::vector<GameFeed::Update> updates;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        while (finished < 40 && std::chrono::steady_clock::now() < deadline) {
+            updates.clear();
+            if (!feed.drain(updates, 1000)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            for (const GameFeed::Update& u : updates) {
+                REQUIRE(u.board < config.boards);
+                switch (u.kind) {
+                    case Kind::Tile:
+                        REQUIRE(u.index < static_cast<std::uint32_t>(N));
+                        mirror[u.board][u.index] = u.cell;
+                        break;
+                    case Kind::NewGame:
+                        REQUIRE(u.index == config.seed + u.board + games[u.board] * config.boards);
+                        ++games[u.board];
+                        seeds[u.board] = u.index;
+                        mirror[u.board].assign(N, 0);
+                        break;
+                    default:
+                        checkFinished(u.board, u.kind);
+                        won += u.kind == Kind::Won;
+                        ++finished;
+                        break;
+                }
+            }
+        }
+    }   // joins the workers with the queues still holding updates
+
+    REQUIRE(finished >= 40);
+    REQUIRE(won > 0);
+    REQUIRE(won < finished);
+    for (std::uint32_t g : games) REQUIRE(g > 1);
+}
+
+TEST_CASE("GameFeed rejects unknown strategies and bad sizes", "[feed]") {
+    GameFeed::Config config = denseFeed(2, 1);
+    config.strategy = "no-such-strategy";
+    REQUIRE_THROWS_AS(GameFeed(config), std::runtime_error);
+
+    config = denseFeed(0, 1);
+    REQUIRE_THROWS_AS(GameFeed(config), std::runtime_error);
+
+    config = denseFeed(2, 1);
+    config.mines = 80;
+    REQUIRE_THROWS_AS(GameFeed(config), std::runtime_error);
+}
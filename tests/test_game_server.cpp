@@ -0,0 +1,342 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "GameServer.hpp"
+#include "ServerProtocol.hpp"
+#include "SessionPool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+struct Frame {
+    std::uint32_t               tag;
+    proto::Status               status;
+    std::vector<std::uint8_t>   payload;
+};
+
+std::string tempSocketPath() {
+    static int counter = 0;
+    return "/tmp/minesweeper-test-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + ".sock";
+}
+
+int connectTo(const std::string& path) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    REQUIRE(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    return fd;
+}
+
+void sendAll(int fd, const std::vector<std::uint8_t>& bytes) {
+    std::size_t sent = 0;
+    while (sent < bytes.size()) {
+        const ssize_t n = write(fd, bytes.data() + sent, bytes.size() - sent);
+        REQUIRE(n > 0);
+        sent += n;
+    }
+}
+
+void readExactly(int fd, std::uint8_t* dst, std::size_t n) {
+    while (n > 0) {
+        const ssize_t got = read(fd, dst, n);
+        REQUIRE(got > 0);
+        dst += got;
+        n   -= got;
+    }
+}
+
+Frame readFrame(int fd) {
+    std::uint8_t header[proto::HEADER_SIZE];
+    readExactly(fd, header, sizeof(header));
+
+    Frame f;
+    const std::uint32_t size = proto::loadU32(header);
+    f.tag    = proto::loadU32(header + 4);
+    f.status = static_cast<proto::Status>(header[8]);
+    f.payload.resize(size - (proto::HEADER_SIZE - 4));
+    if (!f.payload.empty()) readExactly(fd, f.payload.data(), f.payload.size());
+    return f;
+}
+
+void putMove(std::vector<std::uint8_t>& out, std::uint32_t tag, proto::Op op,
+             std::uint32_t session, int x, int y) {
+    const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(op));
+    proto::putU32(out, session);
+    proto::putU16(out, static_cast<std::uint16_t>(x));
+    proto::putU16(out, static_cast<std::uint16_t>(y));
+    proto::endFrame(out, f);
+}
+
+void putSessionOp(std::vector<std::uint8_t>& out, std::uint32_t tag, proto::Op op,
+                  std::uint32_t session) {
+    const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(op));
+    proto::putU32(out, session);
+    proto::endFrame(out, f);
+}
+
+}  // namespace
+
+TEST_CASE("SessionPool recycles slots and rejects stale ids", "[server]") {
+    SessionPool pool;
+    const std::uint32_t a = pool.create();
+    const std::uint32_t b = pool.create();
+    REQUIRE(a != b);
+    REQUIRE(pool.liveCount() == 2);
+    REQUIRE(pool.capacity() == SessionPool::SLAB_SIZE);
+
+    Session* sa = pool.find(a);
+    REQUIRE(sa != nullptr);
+    REQUIRE(pool.destroy(a));
+    REQUIRE_FALSE(pool.destroy(a));
+    REQUIRE(pool.find(a) == nullptr);
+
+    // Same slot, new generation, same storage
+    const std::uint32_t c = pool.create();
+    REQUIRE(c != a);
+    REQUIRE((c & (SessionPool::MAX_SESSIONS - 1)) == (a & (SessionPool::MAX_SESSIONS - 1)));
+    REQUIRE(pool.find(c) == sa);
+    REQUIRE(pool.find(a) == nullptr);
+
+    // Growing adds a slab without moving existing sessions
+    for (int i = 0; i < SessionPool::SLAB_SIZE; ++i) pool.create();
+    REQUIRE(pool.capacity() == 2 * SessionPool::SLAB_SIZE);
+    REQUIRE(pool.find(c) == sa);
+    REQUIRE(pool.find(0xFFFFFu) == nullptr);
+    REQUIRE(pool.find(SessionPool::INVALID_ID) == nullptr);
+}
+
+TEST_CASE("SessionPool ids stay valid through generation wraparound", "[server]") {
+    // Slot 0 comes back first every time; past 4096 generations its
+    // counter has wrapped at least once
+    SessionPool pool;
+    std::uint32_t first = pool.create();
+    for (int i = 0; i < 3 * 4096; ++i) {
+        const std::uint32_t id = pool.create();
+        REQUIRE(id != SessionPool::INVALID_ID);
+        REQUIRE((id & (SessionPool::MAX_SESSIONS - 1)) == 1);
+        REQUIRE(pool.find(id) != nullptr);
+        REQUIRE(pool.destroy(id));
+    }
+    REQUIRE(pool.destroy(first));
+    for (int i = 0; i < 3 * 4096; ++i) {
+        first = pool.create();
+        REQUIRE(first != SessionPool::INVALID_ID);
+        REQUIRE(pool.find(first) != nullptr);
+        REQUIRE(pool.destroy(first));
+    }
+    REQUIRE(pool.liveCount() == 0);
+}
+
+TEST_CASE("Session plays the same game as Board for a seed", "[server]") {
+    std::vector<int> scratch;
+    Session s;
+    s.start(16, 30, 99, 77, scratch);
+    s.reveal(15, 8, scratch);
+
+    Board b(16, 30, kTileSize, 99, 77);
+    b.reveal(15, 8);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 30; ++x) {
+            REQUIRE(s.cells[y * 30 + x] == b.cellAt(x, y));
+        }
+    }
+    REQUIRE(s.status == proto::GameStatus::Playing);
+}
+
+TEST_CASE("Session keeps its safe-tile count when relocation runs out of room", "[server]") {
+    // Denser than the server allows: every mine lies in the first click's
+    // 3x3, has nowhere to go, and leaves the board
+    Session s;
+    std::vector<int> scratch;
+    s.start(3, 3, 5, 1, scratch);
+    const rules::RevealResult r = s.reveal(1, 1, scratch);
+    REQUIRE(r.opened == 9);
+    REQUIRE(s.safeHidden == 0);
+    REQUIRE(s.mines == 0);
+    REQUIRE(s.status == proto::GameStatus::Won);
+}
+
+TEST_CASE("GameServer answers pipelined requests over its socket", "[server]") {
+    GameServer::Config config;
+    config.socketPath  = tempSocketPath();
+    config.hintThreads = 2;
+    GameServer server(config);
+    std::thread loop([&] { server.run(); });
+
+    const int fd = connectTo(config.socketPath);
+
+    // New game with a fixed seed
+    std::vector<std::uint8_t> out;
+    std::size_t f = proto::beginFrame(out, 1, static_cast<std::uint8_t>(proto::Op::NewGame));
+    proto::putU16(out, 9);
+    proto::putU16(out, 9);
+    proto::putU32(out, 10);
+    proto::putU8(out, proto::NEW_GAME_USE_SEED);
+    proto::putU32(out, 42);
+    proto::endFrame(out, f);
+    sendAll(fd, out);
+
+    const Frame created = readFrame(fd);
+    REQUIRE(created.tag == 1);
+    REQUIRE(created.status == proto::Status::Ok);
+    REQUIRE(created.payload.size() == 8);
+    const std::uint32_t session = proto::loadU32(created.payload.data());
+    REQUIRE(proto::loadU32(created.payload.data() + 4) == 42);
+
+    // One write, many requests
+    out.clear();
+    putMove(out, 2, proto::Op::Reveal, session, 4, 4);
+    putMove(out, 3, proto::Op::Flag, session, 0, 0);
+    putSessionOp(out, 4, proto::Op::State, session);
+    putSessionOp(out, 5, proto::Op::Hint, session);
+    putSessionOp(out, 6, proto::Op::State, session + 1);
+    putSessionOp(out, 7, static_cast<proto::Op>(99), session);
+    sendAll(fd, out);
+
+    std::map<std::uint32_t, Frame> replies;
+    std::vector<std::uint32_t> order;
+    for (int i = 0; i < 6; ++i) {
+        Frame r = readFrame(fd);
+        if (r.tag != 5) order.push_back(r.tag);
+        replies[r.tag] = std::move(r);
+    }
+    REQUIRE(order == std::vector<std::uint32_t>{2, 3, 4, 6, 7});
+
+    Board b(9, 9, kTileSize, 10, 42);
+    b.reveal(4, 4);
+    b.flag(0, 0);
+
+    REQUIRE(replies[2].status == proto::Status::Ok);
+    REQUIRE(replies[2].payload[0] == static_cast<std::uint8_t>(proto::GameStatus::Playing));
+    REQUIRE(proto::loadU32(replies[2].payload.data() + 1) > 0);
+
+    const Frame& state = replies[4];
+    REQUIRE(state.status == proto::Status::Ok);
+    REQUIRE(state.payload.size() == 5 + 81);
+    const BoardView view = b.view();
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) REQUIRE(state.payload[5 + y * 9 + x] == view.cellAt(x, y));
+    }
+
+    REQUIRE(replies[5].status == proto::Status::Ok);
+    REQUIRE(replies[5].payload.size() == 5);
+    REQUIRE(replies[6].status == proto::Status::UnknownSession);
+    REQUIRE(replies[7].status == proto::Status::UnknownOp);
+    REQUIRE(server.liveSessions() == 1);
+
+    out.clear();
+    putSessionOp(out, 8, proto::Op::Close, session);
+    sendAll(fd, out);
+    REQUIRE(readFrame(fd).status == proto::Status::Ok);
+    REQUIRE(server.liveSessions() == 0);
+
+    close(fd);
+    server.stop();
+    loop.join();
+}
+
+TEST_CASE("GameServer rejects boards too dense for a safe first click", "[server]") {
+    GameServer::Config config;
+    config.socketPath = tempSocketPath();
+    GameServer server(config);
+    std::thread loop([&] { server.run(); });
+
+    const int fd = connectTo(config.socketPath);
+    auto newGame = [&](std::uint32_t tag, int rows, int cols, std::uint32_t mines) {
+        std::vector<std::uint8_t> out;
+        const std::size_t f = proto::beginFrame(out, tag, static_cast<std::uint8_t>(proto::Op::NewGame));
+        proto::putU16(out, static_cast<std::uint16_t>(rows));
+        proto::putU16(out, static_cast<std::uint16_t>(cols));
+        proto::putU32(out, mines);
+        proto::putU8(out, proto::NEW_GAME_USE_SEED);
+        proto::putU32(out, 7);
+        proto::endFrame(out, f);
+        sendAll(fd, out);
+        return readFrame(fd);
+    };
+
+    REQUIRE(newGame(1, 3, 3, 5).status == proto::Status::BadArguments);
+    REQUIRE(newGame(2, 4, 4, 8).status == proto::Status::BadArguments);
+
+    // The densest board allowed: the first click's 3x3 holds every safe tile
+    const Frame created = newGame(3, 4, 4, 7);
+    REQUIRE(created.status == proto::Status::Ok);
+    std::vector<std::uint8_t> out;
+    putMove(out, 4, proto::Op::Reveal, proto::loadU32(created.payload.data()), 1, 1);
+    sendAll(fd, out);
+    const Frame revealed = readFrame(fd);
+    REQUIRE(revealed.status == proto::Status::Ok);
+    REQUIRE(revealed.payload[0] == static_cast<std::uint8_t>(proto::GameStatus::Won));
+    REQUIRE(proto::loadU32(revealed.payload.data() + 1) == 9);
+    REQUIRE(proto::loadU32(revealed.payload.data() + 5) == 0);
+
+    close(fd);
+    server.stop();
+    loop.join();
+}
+
+TEST_CASE("GameServer caps the hints a client can leave unanswered", "[server]") {
+    GameServer::Config config;
+    config.socketPath  = tempSocketPath();
+    config.hintThreads = 1;
+    GameServer server(config);
+    std::thread loop([&] { server.run(); });
+
+    const int fd = connectTo(config.socketPath);
+    std::vector<std::uint8_t> out;
+    std::size_t f = proto::beginFrame(out, 1, static_cast<std::uint8_t>(proto::Op::NewGame));
+    proto::putU16(out, proto::MAX_DIMENSION);
+    proto::putU16(out, proto::MAX_DIMENSION);
+    proto::putU32(out, 10);
+    proto::putU8(out, proto::NEW_GAME_USE_SEED);
+    proto::putU32(out, 7);
+    proto::endFrame(out, f);
+    sendAll(fd, out);
+    const Frame created = readFrame(fd);
+    REQUIRE(created.status == proto::Status::Ok);
+    const std::uint32_t session = proto::loadU32(created.payload.data());
+
+    // Far more hints than the cap in one write; each one copies a 1 MiB board
+    constexpr int kHints = 1000;
+    out.clear();
+    for (int i = 0; i < kHints; ++i) putSessionOp(out, 100 + i, proto::Op::Hint, session);
+    sendAll(fd, out);
+
+    std::map<std::uint32_t, proto::Status> answers;
+    for (int i = 0; i < kHints; ++i) {
+        const Frame r = readFrame(fd);
+        answers[r.tag] = r.status;
+    }
+    REQUIRE(answers.size() == kHints);
+    int ok = 0, full = 0;
+    for (const auto& entry : answers) {
+        ok   += entry.second == proto::Status::Ok;
+        full += entry.second == proto::Status::ServerFull;
+    }
+    REQUIRE(ok + full == kHints);
+    REQUIRE(ok >= proto::MAX_PENDING_HINTS);
+    REQUIRE(full > 0);
+
+    // Answered hints free their slots
+    out.clear();
+    putSessionOp(out, 1, proto::Op::Hint, session);
+    sendAll(fd, out);
+    REQUIRE(readFrame(fd).status == proto::Status::Ok);
+
+    close(fd);
+    server.stop();
+    loop.join();
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "AnytimeSolver.hpp"
+#include "Board.hpp"
+#include "GuessSearch.hpp"
+#include "MineProbability.hpp"
+#include "TestBoards.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+using Clock = GuessSearch::Clock;
+
+Clock::time_point later() { return Clock::now() + std::chrono::seconds(5); }
+
+// 4 mines. The safest tile, (0, 1) at p = 0.2, is likely to survive, but
+// whatever it shows leaves a 60/40 behind; tiles 5 and 11 (p = 0.4) show a
+// number that settles the rest far more often.
+const std::vector<std::uint8_t> kTrap = gridOf({
+    "1.2.",
+    "..3.",
+    ".2..",
+});
+
+}  // namespace
+
+TEST_CASE("GuessSearch prefers the guess that leaves less to chance", "[lookahead]") {
+    const BoardView view(3, 4, kTrap.data());
+    MineProbability probability;
+    std::vector<float> p;
+    probability.compute(view, 4, p);
+    REQUIRE(std::fabs(p[4] - 0.2f) < 1e-6);
+
+    GuessSearch search;
+    const GuessSearch::Choice choice = search.choose(view, 4, p, later());
+    REQUIRE((choice.tile == 5 || choice.tile == 11));
+    REQUIRE(std::fabs(choice.mineChance - 0.4f) < 1e-6);
+    REQUIRE(std::fabs(choice.value - 0.6f) < 1e-5);
+    REQUIRE(choice.searched == 6);
+
+    // The anytime solver defers to it once nothing can be proven
+    AnytimeSolver solver;
+    const AnytimeMove best = solver.solve(view, 4, later());
+    REQUIRE(best.tier == AnytimeMove::Tier::Lookahead);
+    REQUIRE_FALSE(best.proven);
+    REQUIRE(best.move.action == SolverMove::Action::RevealTile);
+    REQUIRE(best.move.y * 4 + best.move.x == choice.tile);
+}
+
+TEST_CASE("GuessSearch reuses positions from its transposition table", "[lookahead]") {
+    const BoardView view(3, 4, kTrap.data());
+    MineProbability probability;
+    std::vector<float> p;
+    probability.compute(view, 4, p);
+
+    GuessSearch search(GuessSearch::Config{1, 8, 1});
+    const GuessSearch::Choice first = search.choose(view, 4, p, later());
+    const std::size_t   size = search.tableSize();
+    const std::uint64_t hits = search.tableHits();
+    REQUIRE(size > 0);
+    // Two reveals in either order reach the same position
+    REQUIRE(hits > 0);
+
+    const GuessSearch::Choice again = search.choose(view, 4, p, later());
+    REQUIRE(again.tile == first.tile);
+    REQUIRE(again.value == first.value);
+    REQUIRE(search.tableSize() == size);
+    REQUIRE(search.tableHits() > hits);
+}
+
+TEST_CASE("GuessSearch gives the same answer on any number of threads", "[lookahead]") {
+    MineProbability probability;
+    std::vector<float> p;
+    GuessSearch serial(GuessSearch::Config{1, 6, 1});
+    GuessSearch parallel(GuessSearch::Config{1, 6, 4});
+    int compared = 0;
+    for (std::uint32_t seed = 1; seed <= 30; ++seed) {
+        Board b(8, 8, kTileSize, 12, seed);
+        b.reveal(4, 4);
+        while (b.AISolver()) {}
+        if (b.isCleared()) continue;
+
+        probability.compute(b.view(), 12, p);
+        const GuessSearch::Choice a = serial.choose(b.view(), 12, p, later());
+        const GuessSearch::Choice c = parallel.choose(b.view(), 12, p, later());
+        REQUIRE(a.searched == c.searched);
+        REQUIRE(a.tile == c.tile);
+        REQUIRE(std::fabs(a.value - c.value) < 1e-6);
+        ++compared;
+    }
+    REQUIRE(compared > 0);
+}
+
+TEST_CASE("GuessSearch answers with the safest tile when out of time", "[lookahead]") {
+    const BoardView view(3, 4, kTrap.data());
+    MineProbability probability;
+    std::vector<float> p;
+    probability.compute(view, 4, p);
+
+    GuessSearch search(GuessSearch::Config{1, 6, 2});
+    const GuessSearch::Choice choice = search.choose(view, 4, p, Clock::now());
+    REQUIRE(choice.searched == 0);
+    REQUIRE(choice.tile == 4);
+    REQUIRE(search.tableSize() == 0);
+}
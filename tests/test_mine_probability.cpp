@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "HeatmapWorker.hpp"
+#include "MineProbability.hpp"
+#include "Rules.hpp"
+#include "TestBoards.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+// Exact probabilities by trying every placement of the unflagged mines;
+// the number of placements that fit goes to layoutCount when given
+std::vector<double> bruteForce(const Board& b, double* layoutCount = nullptr) {
+    const int rows = b.rows();
+    const int cols = b.cols();
+    std::vector<int> hidden;
+    for (int i = 0; i < rows * cols; ++i) {
+        if (!b.isRevealed(i % cols, i / cols) && !b.isFlaggedAt(i % cols, i / cols)) hidden.push_back(i);
+    }
+
+    std::vector<std::uint8_t> mine(rows * cols, 0);
+    std::vector<double> hits(rows * cols, 0.0);
+    double layouts = 0.0;
+
+    auto consistent = [&] {
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                if (!b.isRevealed(x, y)) continue;
+                int n = 0;
+                rules::forEachNeighbor(b, x, y, [&](int nx, int ny) {
+                    n += b.isFlaggedAt(nx, ny) || mine[ny * cols + nx];
+                });
+                if (n != b.getAdjacentMines(x, y)) return false;
+            }
+        }
+        return true;
+    };
+
+    const int toPlace = b.mineCount() - b.flagCount();
+    auto place = [&](auto& self, std::size_t from, int left) -> void {
+        if (left == 0) {
+            if (!consistent()) return;
+            layouts += 1.0;
+            for (int t : hidden) hits[t] += mine[t];
+            return;
+        }
+        for (std::size_t h = from; h + left <= hidden.size(); ++h) {
+            mine[hidden[h]] = 1;
+            self(self, h + 1, left - 1);
+            mine[hidden[h]] = 0;
+        }
+    };
+    place(place, 0, toPlace);
+    if (layoutCount) *layoutCount = layouts;
+
+    for (double& h : hits) h /= layouts;
+    return hits;
+}
+
+}  // namespace
+
+TEST_CASE("MineProbability splits constraints into components", "[probability]") {
+    // Two independent 50/50s; the middle tile must be safe since both
+    // mines are accounted for
+    std::vector<std::uint8_t> cells = rowOf("*1...1*");
+    MineProbability probability;
+    std::vector<float> p;
+
+    probability.compute(BoardView(1, 7, cells.data()), 2, p);
+    REQUIRE(probability.lastStats().components == 2);
+    REQUIRE(probability.lastStats().enumerated == 2);
+    REQUIRE(p[1] == MineProbability::NOT_HIDDEN);
+    REQUIRE(p[0] == 0.5f);
+    REQUIRE(p[2] == 0.5f);
+    REQUIRE(p[3] == 0.f);
+    REQUIRE(p[6] == 0.5f);
+
+    // Unchanged constraints come from the cache
+    probability.compute(BoardView(1, 7, cells.data()), 2, p);
+    REQUIRE(probability.lastStats().enumerated == 0);
+
+    // Revealing tile 2 touches only the left component
+    cells = rowOf("*10..1*");
+    probability.compute(BoardView(1, 7, cells.data()), 2, p);
+    REQUIRE(probability.lastStats().components == 3);
+    REQUIRE(probability.lastStats().enumerated == 2);
+    REQUIRE(p[0] == 1.f);
+    REQUIRE(p[3] == 0.f);
+    REQUIRE(p[4] == 0.5f);
+
+    // A flag count that cannot be right leaves nothing to say
+    cells[0] |= cell::FLAGGED;
+    cells[6] |= cell::FLAGGED;
+    probability.compute(BoardView(1, 7, cells.data()), 1, p);
+    REQUIRE(p[3] == MineProbability::UNKNOWN);
+}
+
+TEST_CASE("MineProbability matches brute-force enumeration", "[probability]") {
+    MineProbability probability;
+    std::vector<float> p;
+    for (std::uint32_t seed = 1; seed <= 40; ++seed) {
+        const int mines = 3 + static_cast<int>(seed % 5);
+        Board b(5, 5, kTileSize, mines, seed);
+        b.reveal(2, 2);
+        if (seed % 3 == 0) {
+            // A correct flag, so flags are exercised too
+            for (int i = 0; i < 25; ++i) {
+                if (b.hasMineAt(i % 5, i / 5)) {
+                    b.flag(i % 5, i / 5);
+                    break;
+                }
+            }
+        }
+        if (b.isCleared()) continue;
+
+        probability.compute(b.view(), mines, p);
+        double layouts = 0.0;
+        const std::vector<double> exact = bruteForce(b, &layouts);
+        REQUIRE(std::fabs(probability.lastStats().logLayouts - std::log(layouts)) < 1e-6);
+        for (int i = 0; i < 25; ++i) {
+            if (b.isRevealed(i % 5, i / 5) || b.isFlaggedAt(i % 5, i / 5)) {
+                REQUIRE(p[i] == MineProbability::NOT_HIDDEN);
+            } else {
+                REQUIRE(std::fabs(p[i] - exact[i]) < 1e-5);
+            }
+        }
+    }
+}
+
+TEST_CASE("HeatmapWorker answers with the map for the submitted board", "[probability]") {
+    Board b(16, 30, kTileSize, 99, 21);
+    b.reveal(15, 8);
+
+    MineProbability probability;
+    std::vector<float> expected;
+    probability.compute(b.view(), 99, expected);
+
+    HeatmapWorker worker;
+    REQUIRE(worker.submit(b.fork(), 99, 7));
+
+    HeatmapWorker::Result result;
+    bool answered = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!answered && std::chrono::steady_clock::now() < deadline) {
+        answered = worker.poll(result);
+        if (!answered) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(answered);
+    REQUIRE(result.generation == 7);
+    REQUIRE(result.probabilities == expected);
+    REQUIRE(result.stats.components == probability.lastStats().components);
+}
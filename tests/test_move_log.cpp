@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "MoveLog.hpp"
+#include "TestBoards.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float         kTileSize = 50.f;
+constexpr std::uint32_t kSeedA    = 0xC0FFEEu;
+
+}  // namespace
+
+TEST_CASE("Move log round-trips headers and moves", "[movelog]") {
+    std::stringstream buf;
+    {
+        MoveLogWriter w(buf);
+        w.beginGame({kSeedA, 9, 9, 10});
+        w.reveal(4, 4);
+        w.flag(0, 0);
+        w.aiStep();
+        w.beginGame({7u, 16, 30, 99});
+        w.chord(29, 15);
+    }
+
+    MoveLogReader r(buf);
+    GameHeader h;
+    Move m;
+
+    REQUIRE(r.nextGame(h));
+    REQUIRE(h.seed == kSeedA);
+    REQUIRE(h.rows == 9);
+    REQUIRE(h.cols == 9);
+    REQUIRE(h.mines == 10);
+
+    REQUIRE(r.nextMove(m));
+    REQUIRE(m.action == MoveAction::Reveal);
+    REQUIRE(m.cell == 4 * 9 + 4);
+    REQUIRE(r.nextMove(m));
+    REQUIRE(m.action == MoveAction::Flag);
+    REQUIRE(m.cell == 0);
+    REQUIRE(r.nextMove(m));
+    REQUIRE(m.action == MoveAction::AIStep);
+    REQUIRE_FALSE(r.nextMove(m));
+
+    REQUIRE(r.nextGame(h));
+    REQUIRE(h.seed == 7u);
+    REQUIRE(r.nextMove(m));
+    REQUIRE(m.action == MoveAction::Chord);
+    REQUIRE(m.cell == 15 * 30 + 29);
+    REQUIRE_FALSE(r.nextMove(m));
+    REQUIRE_FALSE(r.nextGame(h));
+}
+
+TEST_CASE("Move log records are compact", "[movelog]") {
+    std::stringstream buf;
+    {
+        MoveLogWriter w(buf);
+        w.beginGame({kSeedA, 16, 16, 40});
+    }
+    const auto headerSize = buf.str().size();
+
+    {
+        std::stringstream more;
+        MoveLogWriter w(more);
+        w.beginGame({kSeedA, 16, 16, 40});
+        w.reveal(0, 0);         // delta 0
+        w.reveal(1, 0);         // delta +1
+        w.aiStep();
+        w.flag(0, 0);           // delta -1
+        w.flush();
+        REQUIRE(more.str().size() == headerSize + 4);
+    }
+}
+
+TEST_CASE("nextGame skips unread moves", "[movelog]") {
+    std::stringstream buf;
+    {
+        MoveLogWriter w(buf, 16);       // tiny buffer exercises mid-game flushes
+        w.beginGame({1u, 9, 9, 10});
+        for (int i = 0; i < 50; ++i) w.reveal(i % 9, i / 9 % 9);
+        w.beginGame({2u, 9, 9, 10});
+    }
+
+    MoveLogReader r(buf, 16);
+    GameHeader h;
+    REQUIRE(r.nextGame(h));
+    REQUIRE(h.seed == 1u);
+    REQUIRE(r.nextGame(h));
+    REQUIRE(h.seed == 2u);
+    REQUIRE_FALSE(r.nextGame(h));
+}
+
+TEST_CASE("Replay reproduces the recorded game", "[movelog][replay]") {
+    Board live(16, 16, kTileSize, 40, kSeedA);
+    std::stringstream buf;
+    {
+        MoveLogWriter w(buf);
+        w.beginGame({kSeedA, 16, 16, 40});
+
+        live.reveal(8, 8);
+        w.reveal(8, 8);
+        live.flag(0, 15);
+        w.flag(0, 15);
+        while (live.AISolver()) w.aiStep();
+    }
+
+    Board replayed(9, 9, kTileSize, 10, 123u);
+    MoveLogReader r(buf);
+    GameHeader h;
+    REQUIRE(r.nextGame(h));
+
+    const ReplayResult result = replayGame(r, h, replayed);
+    REQUIRE(result.moves >= 2);
+    REQUIRE(result.lost == false);
+    REQUIRE(result.cleared == live.isCleared());
+    REQUIRE(visibleState(replayed, 16, 16) == visibleState(live, 16, 16));
+}
+
+TEST_CASE("Malformed move logs are rejected", "[movelog][adversarial]") {
+    SECTION("Bad magic") {
+        std::stringstream buf("XXXX\x01");
+        REQUIRE_THROWS(MoveLogReader(buf));
+    }
+    SECTION("Truncated varint") {
+        std::stringstream buf;
+        {
+            MoveLogWriter w(buf);
+            w.beginGame({kSeedA, 9, 9, 10});
+        }
+        std::string bytes = buf.str();
+        bytes.push_back(static_cast<char>(0x80));   // continuation bit, no next byte
+        std::stringstream cut(bytes);
+
+        MoveLogReader r(cut);
+        GameHeader h;
+        Move m;
+        REQUIRE(r.nextGame(h));
+        REQUIRE_THROWS(r.nextMove(m));
+    }
+    SECTION("Headers no board could have") {
+        // begin-game record, then seed, rows, cols, mines
+        auto varint = [](std::uint64_t v) {
+            std::string s;
+            for (; v >= 0x80; v >>= 7) s += static_cast<char>((v & 0x7F) | 0x80);
+            return s + static_cast<char>(v);
+        };
+        auto header = [&](std::uint64_t rows, std::uint64_t cols, std::uint64_t mines) {
+            return std::string("MSLG\x01") + varint(static_cast<std::uint64_t>(MoveAction::BeginGame))
+                 + varint(kSeedA) + varint(rows) + varint(cols) + varint(mines);
+        };
+
+        const std::uint64_t wraps = (1ull << 63) + 9;     // squared, 81 mod 2^64
+        for (const std::string& bytes : {header(0, 9, 0), header(9, 0, 0), header(wraps, wraps, 10),
+                                         header(1u << 20, 1u << 20, 10), header(1ull << 32, 1, 0),
+                                         header(3, 3, 1), header(9, 9, 73)}) {
+            std::stringstream bad(bytes);
+            MoveLogReader r(bad);
+            GameHeader h;
+            REQUIRE_THROWS_AS(r.nextGame(h), std::runtime_error);
+        }
+
+        std::stringstream densest(header(9, 9, 72));
+        MoveLogReader r(densest);
+        GameHeader h;
+        REQUIRE(r.nextGame(h));
+        REQUIRE(h.mines == 72);
+    }
+}
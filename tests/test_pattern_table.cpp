@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "PatternTable.hpp"
+#include "Strategy.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+// Plays a strategy until it is stuck or the game ends; returns false on a mine
+bool playOut(Board& b, Strategy& strategy) {
+    std::vector<StrategyMove> moves;
+    for (int call = 0; call < 4 * b.rows() * b.cols(); ++call) {
+        moves.clear();
+        strategy.nextMoves(b.view(), moves);
+        if (moves.empty()) return true;
+
+        for (const StrategyMove& m : moves) {
+            switch (m.action) {
+                case StrategyMove::Action::Reveal: if (b.reveal(m.x, m.y)) return false; break;
+                case StrategyMove::Action::Chord:  if (b.chord(m.x, m.y))  return false; break;
+                case StrategyMove::Action::Flag:   b.flag(m.x, m.y);                      break;
+            }
+        }
+        if (b.isCleared()) return true;
+    }
+    return true;
+}
+
+int revealedCount(const Board& b) {
+    int n = 0;
+    for (int y = 0; y < b.rows(); ++y) {
+        for (int x = 0; x < b.cols(); ++x) n += b.isRevealed(x, y);
+    }
+    return n;
+}
+
+}  // namespace
+
+TEST_CASE("Pattern tables agree with brute-force enumeration", "[pattern]") {
+    // Every forced tile must be forced in all consistent mine placements,
+    // and every tile forced in all of them must be in the table
+    for (int ra = 0; ra <= patterns::MAX_PAIR_REMAINING; ++ra) {
+        for (int rb = 0; rb <= patterns::MAX_PAIR_REMAINING; ++rb) {
+            for (unsigned m = 0; m < (1u << patterns::PAIR_CELLS); ++m) {
+                unsigned alwaysMine = m;
+                unsigned alwaysSafe = m;
+                bool     consistent = false;
+                // Submasks of m are the candidate mine placements
+                for (unsigned p = m;; p = (p - 1) & m) {
+                    if (patterns::popcount(p & patterns::PAIR_A_MASK) == ra
+                        && patterns::popcount(p & patterns::PAIR_B_MASK) == rb) {
+                        consistent = true;
+                        alwaysMine &= p;
+                        alwaysSafe &= ~p;
+                    }
+                    if (p == 0) break;
+                }
+
+                const std::uint32_t entry = patterns::lookupPair(m, ra, rb);
+                if (!consistent) {
+                    REQUIRE(entry == 0);
+                } else {
+                    REQUIRE(patterns::safeMask(entry) == alwaysSafe);
+                    REQUIRE(patterns::mineMask(entry) == alwaysMine);
+                }
+            }
+        }
+    }
+
+    // A single tile is the plain two-rule solver
+    REQUIRE(patterns::lookupSingle(0b00000111, 0) == 0b00000111);
+    REQUIRE(patterns::lookupSingle(0b00000111, 3) == 0b00000111u << 16);
+    REQUIRE(patterns::lookupSingle(0b00000111, 2) == 0);
+    REQUIRE(patterns::lookupSingle(0b00000111, 4) == 0);
+    REQUIRE(patterns::lookupSingle(0b00000111, -1) == 0);
+}
+
+TEST_CASE("PatternStrategy finds the 1-2 pattern the two rules miss", "[pattern]") {
+    // Bottom row revealed against the wall, top row hidden:
+    //      . * . *
+    //      1 1 2 1
+    Board b(2, 4, kTileSize, 0, 1);
+    b.placeMinesAt({b.index(1, 0), b.index(3, 0)});
+    for (int x = 0; x < 4; ++x) b.reveal(x, 1);
+    REQUIRE(b.getAdjacentMines(1, 1) == 1);
+    REQUIRE(b.getAdjacentMines(2, 1) == 2);
+
+    std::vector<StrategyMove> moves;
+    TwoRuleStrategy twoRule;
+    twoRule.nextMoves(b.view(), moves);
+    REQUIRE(moves.empty());
+
+    // Every pair forces something: the whole top row is decided at once
+    PatternStrategy pattern;
+    pattern.newGame(2, 4, 2);
+    pattern.nextMoves(b.view(), moves);
+    REQUIRE(moves.size() == 4);
+    for (const StrategyMove& m : moves) {
+        REQUIRE(m.y == 0);
+        REQUIRE(b.hasMineAt(m.x, m.y) == (m.action == StrategyMove::Action::Flag));
+    }
+}
+
+TEST_CASE("PatternStrategy never loses and gets further than the two rules", "[pattern]") {
+    int twoRuleRevealed = 0;
+    int patternRevealed = 0;
+    for (std::uint32_t seed = 1; seed <= 40; ++seed) {
+        Board a(16, 30, kTileSize, 99, seed);
+        Board b(16, 30, kTileSize, 99, seed);
+        a.reveal(15, 8);
+        b.reveal(15, 8);
+
+        TwoRuleStrategy twoRule;
+        PatternStrategy pattern;
+        twoRule.newGame(16, 30, 99);
+        pattern.newGame(16, 30, 99);
+        REQUIRE(playOut(a, twoRule));
+        REQUIRE(playOut(b, pattern));
+
+        // Every flag placed by the table is on a mine
+        for (int y = 0; y < 16; ++y) {
+            for (int x = 0; x < 30; ++x) {
+                if (b.isFlaggedAt(x, y)) REQUIRE(b.hasMineAt(x, y));
+            }
+        }
+        REQUIRE(revealedCount(b) >= revealedCount(a));
+        twoRuleRevealed += revealedCount(a);
+        patternRevealed += revealedCount(b);
+    }
+    REQUIRE(patternRevealed > twoRuleRevealed);
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "PerfCorpus.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+PerfCase makeCase(PerfCase::Kind kind, int rows, int cols, int mines, std::uint32_t seed = 1) {
+    PerfCase c;
+    c.name     = "case";
+    c.kind     = kind;
+    c.rows     = rows;
+    c.cols     = cols;
+    c.mines    = mines;
+    c.seed     = seed;
+    c.budgetMs = 1.0;
+    return c;
+}
+
+int revealedCount(const Board& b) {
+    int n = 0;
+    for (int y = 0; y < b.rows(); ++y) {
+        for (int x = 0; x < b.cols(); ++x) n += b.isRevealed(x, y);
+    }
+    return n;
+}
+
+}  // namespace
+
+TEST_CASE("Perf manifests round-trip and reject bad lines", "[perf]") {
+    std::istringstream in(
+        "# comment\n"
+        "\n"
+        "flood   opening  50 60   3  0  1.5   # trailing comment\n"
+        "packed  relocate 20 20 391  7  0.25\n");
+    const std::vector<PerfCase> cases = readPerfManifest(in);
+    REQUIRE(cases.size() == 2);
+    REQUIRE(cases[0].name == "flood");
+    REQUIRE(cases[0].kind == PerfCase::Kind::Opening);
+    REQUIRE(cases[0].cols == 60);
+    REQUIRE(cases[1].kind == PerfCase::Kind::Relocate);
+    REQUIRE(cases[1].seed == 7);
+    REQUIRE(cases[1].budgetMs == 0.25);
+
+    std::ostringstream out;
+    writePerfManifest(out, cases);
+    std::istringstream again(out.str());
+    const std::vector<PerfCase> reread = readPerfManifest(again);
+    REQUIRE(reread.size() == 2);
+    REQUIRE(reread[1].mines == 391);
+    REQUIRE(reread[1].budgetMs == 0.25);
+
+    for (const char* bad : {"x opening 10 10 1 0\n",                // missing budget
+                            "x spiral 10 10 1 0 1\n",               // unknown kind
+                            "x dense 10 10 92 0 1\n",               // over rows*cols - 9
+                            "x relocate 10 10 40 0 1\n",            // free tiles inside the 3x3
+                            "x dense 10 10 5 0 0\n",                // no budget
+                            "x dense 10 10 5 0 1 extra\n"}) {
+        std::istringstream line(bad);
+        REQUIRE_THROWS_AS(readPerfManifest(line), std::runtime_error);
+    }
+}
+
+TEST_CASE("Perf cases build the worst cases they describe", "[perf]") {
+    SECTION("opening floods everything but the mines") {
+        const PerfCase c = makeCase(PerfCase::Kind::Opening, 30, 40, 5);
+        Board b = buildPerfBoard(c);
+        runPerfCase(c, b);
+        REQUIRE(revealedCount(b) == 30 * 40 - 5);
+        REQUIRE(b.isCleared());
+    }
+
+    SECTION("dense deals at the density limit and opens the first click's 3x3") {
+        const PerfCase c = makeCase(PerfCase::Kind::Dense, 20, 20, 391);
+        Board b = buildPerfBoard(c);
+        runPerfCase(c, b);
+        REQUIRE(b.mineCount() == 391);
+        REQUIRE(b.isCleared());
+    }
+
+    SECTION("relocate moves all nine mines of the first click's 3x3") {
+        const PerfCase c = makeCase(PerfCase::Kind::Relocate, 20, 20, 391);
+        Board b = buildPerfBoard(c);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) REQUIRE(b.hasMineAt(10 + dx, 10 + dy));
+        }
+        runPerfCase(c, b);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) REQUIRE_FALSE(b.hasMineAt(10 + dx, 10 + dy));
+        }
+        REQUIRE(b.mineCount() == 391);
+    }
+
+    SECTION("chain is cleared by the two rules alone") {
+        const PerfCase c = makeCase(PerfCase::Kind::Chain, 16, 16, 30);
+        Board b = buildPerfBoard(c);
+        runPerfCase(c, b);
+        REQUIRE(b.isCleared());
+
+        REQUIRE(timePerfCase(c, 2) > 0.0);
+    }
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "PuzzleCorpus.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr float kTileSize = 50.f;
+
+std::string tempCorpusPath() {
+    static int counter = 0;
+    return "/tmp/minesweeper-corpus-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + ".mspc";
+}
+
+}  // namespace
+
+TEST_CASE("Corpus layouts round-trip through the memory map", "[corpus]") {
+    const std::string path = tempCorpusPath();
+    {
+        std::ofstream out(path, std::ios::binary);
+        generateCorpus(out, 16, 30, 99, 500, 20);
+    }
+
+    const PuzzleCorpus corpus(path);
+    REQUIRE(corpus.rows() == 16);
+    REQUIRE(corpus.cols() == 30);
+    REQUIRE(corpus.size() == 20);
+    REQUIRE(corpus.recordSize() == 60);
+
+    // Each record is the layout Board deals for that seed
+    CorpusSolver solver(16, 30);
+    TwoRuleStrategy strategy;
+    for (std::size_t k = 0; k < corpus.size(); ++k) {
+        Board b(16, 30, kTileSize, 99, 500 + static_cast<std::uint32_t>(k));
+        solver.solve(corpus.mineBits(k), -1, -1, strategy);   // load only, no opening
+
+        for (int y = 0; y < 16; ++y) {
+            for (int x = 0; x < 30; ++x) {
+                REQUIRE(solver.cells()[y * 30 + x] == b.cellAt(x, y));
+            }
+        }
+    }
+    unlink(path.c_str());
+}
+
+TEST_CASE("CorpusSolver plays a layout as stored", "[corpus]") {
+    const std::string path = tempCorpusPath();
+    {
+        // Mines in the corner; a center start floods everything else
+        std::ofstream out(path, std::ios::binary);
+        PuzzleCorpusWriter writer(out, 5, 5);
+        std::uint8_t cells[25] = {};
+        cells[0] = cell::MINE;
+        writer.add(cells);
+        cells[12] = cell::MINE;
+        writer.add(cells);
+        writer.finish();
+    }
+
+    const PuzzleCorpus corpus(path);
+    REQUIRE(corpus.size() == 2);
+
+    CorpusSolver solver(5, 5);
+    TwoRuleStrategy strategy;
+
+    const PuzzleResult solved = solver.solve(corpus.mineBits(0), 2, 2, strategy);
+    REQUIRE(solved.outcome == PuzzleResult::Outcome::Solved);
+    REQUIRE(solved.revealed == 24);
+    REQUIRE(solved.safeTiles == 24);
+
+    // No first-click relocation: starting on a mine loses
+    const PuzzleResult lost = solver.solve(corpus.mineBits(1), 2, 2, strategy);
+    REQUIRE(lost.outcome == PuzzleResult::Outcome::Lost);
+
+    std::ostringstream csv;
+    solveCorpus(corpus, 2, 2, strategy, csv);
+    REQUIRE(csv.str().rfind("index,outcome,revealed,safe,moves,us\n0,solved,24,24,", 0) == 0);
+    REQUIRE(csv.str().find("\n1,lost,0,23,1,") != std::string::npos);
+    unlink(path.c_str());
+}
+
+TEST_CASE("PuzzleCorpus rejects malformed files", "[corpus]") {
+    const std::string path = tempCorpusPath();
+    {
+        std::ofstream out(path, std::ios::binary);
+        generateCorpus(out, 9, 9, 10, 1, 3);
+    }
+
+    // Truncate the last record
+    REQUIRE(truncate(path.c_str(), 16 + 11 * 3 - 1) == 0);
+    REQUIRE_THROWS_AS(PuzzleCorpus(path), std::runtime_error);
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a corpus file";
+    }
+    REQUIRE_THROWS_AS(PuzzleCorpus(path), std::runtime_error);
+    REQUIRE_THROWS_AS(PuzzleCorpus(path + ".missing"), std::runtime_error);
+
+    // An empty corpus of 65535x65535 boards: consistent, but too many tiles
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write("MSPC\x01\x00\xff\xff\xff\xff\x00\x00\x00\x00\x00\x00", 16);
+    }
+    REQUIRE_THROWS_AS(PuzzleCorpus(path), std::runtime_error);
+    unlink(path.c_str());
+}
+
+TEST_CASE("PuzzleCorpusWriter rejects sizes the header cannot hold", "[corpus]") {
+    std::stringstream out;
+    REQUIRE_THROWS_AS(PuzzleCorpusWriter(out, 70000, 1), std::runtime_error);
+    REQUIRE_THROWS_AS(PuzzleCorpusWriter(out, 9000, 9000), std::runtime_error);
+    REQUIRE_THROWS_AS(PuzzleCorpusWriter(out, 0, 9), std::runtime_error);
+    REQUIRE(out.str().empty());
+}
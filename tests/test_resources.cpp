@@ -0,0 +1,29 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "Resources.hpp"
+
+#include <string>
+
+#include <unistd.h>
+
+TEST_CASE("The font is embedded and shared", "[resources]") {
+    // A TrueType file: sfnt version 1.0
+    REQUIRE(resources::FONT_SIZE > 12);
+    REQUIRE(resources::FONT_DATA[0] == 0x00);
+    REQUIRE(resources::FONT_DATA[1] == 0x01);
+    REQUIRE(resources::FONT_DATA[2] == 0x00);
+    REQUIRE(resources::FONT_DATA[3] == 0x00);
+
+    REQUIRE(&resources::font() == &resources::font());
+}
+
+TEST_CASE("Boards do not depend on the working directory", "[resources]") {
+    char previous[4096];
+    REQUIRE(getcwd(previous, sizeof(previous)) != nullptr);
+    REQUIRE(chdir("/") == 0);
+
+    REQUIRE_NOTHROW(Board(9, 9, 50.f, 10, 1));
+
+    REQUIRE(chdir(previous) == 0);
+}
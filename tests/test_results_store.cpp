@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ResultsStore.hpp"
+#include "Strategy.hpp"
+#include "Tournament.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+std::string tempResultsPath() {
+    static int counter = 0;
+    return "/tmp/minesweeper-results-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + ".msrs";
+}
+
+GameRecord makeRecord(std::uint32_t seed, int rows, int mines, const std::string& strategy,
+                      GameRecord::Outcome outcome, std::uint32_t moves) {
+    GameRecord r;
+    r.seed     = seed;
+    r.rows     = rows;
+    r.cols     = rows;
+    r.mines    = mines;
+    r.strategy = strategy;
+    r.outcome  = outcome;
+    r.moves    = moves;
+    r.guesses  = moves % 3;
+    r.micros   = moves * 10;
+    return r;
+}
+
+auto key(std::uint32_t seed, std::uint32_t rows, std::uint32_t cols, std::uint32_t mines, const std::string& strategy,
+         std::uint8_t outcome, std::uint32_t moves, std::uint32_t guesses, std::uint32_t micros) {
+    return std::make_tuple(seed, rows, cols, mines, strategy, outcome, moves, guesses, micros);
+}
+
+using Key = decltype(key(0, 0, 0, 0, "", 0, 0, 0, 0));
+
+Key key(const GameRecord& r) {
+    return key(r.seed, r.rows, r.cols, r.mines, r.strategy, static_cast<std::uint8_t>(r.outcome),
+               r.moves, r.guesses, r.micros);
+}
+
+std::vector<Key> readAll(const ResultsReader& reader) {
+    std::vector<Key> keys;
+    reader.forEachBlock(ALL_COLUMNS, [&](const ResultsBlock& b) {
+        for (std::size_t i = 0; i < b.count; ++i) {
+            keys.push_back(key(b.seeds[i], b.rows[i], b.cols[i], b.mines[i], b.strategyNames[b.strategies[i]],
+                               b.outcomes[i], b.moves[i], b.guesses[i], b.micros[i]));
+        }
+    });
+    return keys;
+}
+
+}  // namespace
+
+TEST_CASE("Results written by several threads read back intact", "[results]") {
+    const std::string path = tempResultsPath();
+    std::vector<Key> expected;
+    {
+        ResultsWriter writer(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&writer, t] {
+                ResultsWriter::Buffer buffer(writer, 100);
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    buffer.add(makeRecord(t * 100000 + i * 7, 9 + t, 10 + (i / 300), t % 2 ? "a" : "b",
+                                          static_cast<GameRecord::Outcome>(i % 3), i));
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        for (int t = 0; t < 4; ++t) {
+            for (std::uint32_t i = 0; i < 1000; ++i) {
+                expected.push_back(key(makeRecord(t * 100000 + i * 7, 9 + t, 10 + (i / 300), t % 2 ? "a" : "b",
+                                                  static_cast<GameRecord::Outcome>(i % 3), i)));
+            }
+        }
+    }
+
+    const ResultsReader reader(path);
+    REQUIRE(reader.recordCount() == 4000);
+    std::vector<Key> actual = readAll(reader);
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(actual == expected);
+    unlink(path.c_str());
+}
+
+TEST_CASE("Results files are appended to and stay compact", "[results]") {
+    const std::string path = tempResultsPath();
+    for (int run = 0; run < 2; ++run) {
+        ResultsWriter writer(path);
+        ResultsWriter::Buffer buffer(writer);
+        for (std::uint32_t i = 0; i < 5000; ++i) {
+            buffer.add(makeRecord(run * 5000 + i, 16, 40, "anytime", GameRecord::Outcome::Win, 100));
+        }
+    }
+
+    const ResultsReader reader(path);
+    REQUIRE(reader.recordCount() == 10000);
+
+    // Sequential seeds, one difficulty and small counts: a few bytes per game
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    REQUIRE(static_cast<std::uint64_t>(in.tellg()) < 10000 * 6);
+
+    // Only the requested columns are decoded
+    std::uint64_t seen = 0;
+    reader.forEachBlock(SEED_COLUMN, [&](const ResultsBlock& b) {
+        REQUIRE(b.seeds.size() == b.count);
+        REQUIRE(b.moves.empty());
+        for (std::uint32_t s : b.seeds) REQUIRE(s == seen++);
+    });
+    REQUIRE(seen == 10000);
+    unlink(path.c_str());
+}
+
+TEST_CASE("Results summaries group by difficulty and strategy", "[results]") {
+    const std::string path = tempResultsPath();
+    {
+        ResultsWriter writer(path);
+        ResultsWriter::Buffer buffer(writer, 7);
+        for (std::uint32_t i = 1; i <= 100; ++i) {
+            buffer.add(makeRecord(i, 9, 10, i % 2 ? "odd" : "even",
+                                  i <= 75 ? GameRecord::Outcome::Win : GameRecord::Outcome::Loss, i));
+        }
+        buffer.add(makeRecord(1, 16, 40, "odd", GameRecord::Outcome::Stuck, 5));
+    }
+
+    const ResultsReader reader(path);
+    const std::vector<ResultsSummary> all = summarizeResults(reader, false);
+    REQUIRE(all.size() == 2);
+    REQUIRE(all[0].rows == 9);
+    REQUIRE(all[0].games == 100);
+    REQUIRE(all[0].wins == 75);
+    REQUIRE(all[0].losses == 25);
+    REQUIRE(all[0].winRate() == 0.75);
+    REQUIRE(all[0].movesP50 == 50);                            // exact below 64
+    REQUIRE(std::abs(all[0].movesP99 - 99) <= 99 / 64.0);
+    REQUIRE(std::abs(all[0].microsP99 - 990) <= 990 / 64.0);
+    REQUIRE(all[1].mines == 40);
+    REQUIRE(all[1].stuck == 1);
+
+    const std::vector<ResultsSummary> split = summarizeResults(reader, true);
+    REQUIRE(split.size() == 3);
+    REQUIRE(split[0].strategy == "even");
+    REQUIRE(split[0].games == 50);
+    REQUIRE(split[1].strategy == "odd");
+    REQUIRE(split[1].wins + split[1].losses == 50);
+
+    std::ostringstream csv;
+    writeResultsSummaryCsv(csv, split);
+    REQUIRE(csv.str().rfind("rows,cols,mines,strategy,games", 0) == 0);
+    unlink(path.c_str());
+}
+
+TEST_CASE("Results summary percentiles stay within the histogram's error", "[results]") {
+    // Spread over the whole u32 range, with nearly every value distinct
+    const std::string path = tempResultsPath();
+    std::vector<std::uint32_t> micros;
+    {
+        ResultsWriter writer(path);
+        ResultsWriter::Buffer buffer(writer);
+        std::uint32_t v = 1;
+        for (std::uint32_t i = 0; i < 5000; ++i) {
+            v = v * 1664525u + 1013904223u;
+            GameRecord r = makeRecord(i, 9, 10, "x", GameRecord::Outcome::Win, i);
+            r.micros = v >> (i % 32);
+            micros.push_back(r.micros);
+            buffer.add(r);
+        }
+    }
+    std::sort(micros.begin(), micros.end());
+
+    const ResultsReader reader(path);
+    const std::vector<ResultsSummary> summary = summarizeResults(reader, false);
+    REQUIRE(summary.size() == 1);
+    const double p50 = micros[2500 - 1];
+    const double p99 = micros[4950 - 1];
+    REQUIRE(std::abs(summary[0].microsP50 - p50) <= p50 / 64);
+    REQUIRE(std::abs(summary[0].microsP99 - p99) <= p99 / 64);
+    REQUIRE(std::abs(summary[0].movesP50 - 2499) <= 2499 / 64.0);
+    unlink(path.c_str());
+}
+
+TEST_CASE("Damaged results files are rejected", "[results]") {
+    const std::string path = tempResultsPath();
+    {
+        ResultsWriter writer(path);
+        ResultsWriter::Buffer buffer(writer);
+        for (std::uint32_t i = 0; i < 50; ++i) buffer.add(makeRecord(i, 9, 10, "x", GameRecord::Outcome::Win, i));
+    }
+
+    // A record count far beyond what the block's bytes can hold
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(8 + 8);
+        out.write("\xff\xff\xff\xff", 4);
+    }
+    {
+        const ResultsReader reader(path);
+        REQUIRE_THROWS_AS(reader.recordCount(), std::runtime_error);
+        for (unsigned columns : {ALL_COLUMNS, SEED_COLUMN, MOVES_COLUMN, ROWS_COLUMN}) {
+            REQUIRE_THROWS_AS(reader.forEachBlock(columns, [](const ResultsBlock&) {}), std::runtime_error);
+        }
+    }
+
+    // Cut the last block short
+    REQUIRE(truncate(path.c_str(), 40) == 0);
+    {
+        const ResultsReader reader(path);
+        REQUIRE_THROWS_AS(reader.recordCount(), std::runtime_error);
+        REQUIRE_THROWS_AS(reader.forEachBlock(ALL_COLUMNS, [](const ResultsBlock&) {}), std::runtime_error);
+    }
+
+    // Not a results file at all
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "seed,rows,cols\n";
+    }
+    REQUIRE_THROWS_AS(ResultsReader(path), std::runtime_error);
+    REQUIRE_THROWS_AS(ResultsWriter(path), std::runtime_error);
+    unlink(path.c_str());
+}
+
+TEST_CASE("Tournaments record every game in a results store", "[results][tournament]") {
+    const std::string path = tempResultsPath();
+    TournamentConfig config;
+    config.rows    = 9;
+    config.cols    = 9;
+    config.mines   = 10;
+    config.threads = 3;
+    for (std::uint32_t s = 1; s <= 20; ++s) config.seeds.push_back(s);
+
+    std::vector<StrategyResult> results;
+    {
+        ResultsWriter writer(path);
+        config.results = &writer;
+        results = runTournament(config, strategyRegistry());
+    }
+
+    const ResultsReader reader(path);
+    REQUIRE(reader.recordCount() == 20 * strategyRegistry().size());
+    const std::vector<ResultsSummary> summary = summarizeResults(reader, true);
+    REQUIRE(summary.size() == results.size());
+    for (const StrategyResult& r : results) {
+        const auto it = std::find_if(summary.begin(), summary.end(),
+                                     [&](const ResultsSummary& s) { return s.strategy == r.name; });
+        REQUIRE(it != summary.end());
+        REQUIRE(it->wins == static_cast<std::uint64_t>(r.wins));
+        REQUIRE(it->losses == static_cast<std::uint64_t>(r.losses));
+        REQUIRE(it->stuck == static_cast<std::uint64_t>(r.stuck));
+    }
+    unlink(path.c_str());
+}
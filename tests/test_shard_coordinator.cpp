@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ResultsStore.hpp"
+#include "ShardCoordinator.hpp"
+#include "Strategy.hpp"
+#include "Tournament.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+ShardCoordinator::Config tempRun() {
+    static int counter = 0;
+    const std::string base = "/tmp/minesweeper-shards-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+
+    ShardCoordinator::Config config;
+    config.socketPath     = base + ".sock";
+    config.resultsPath    = base + ".msrs";
+    config.checkpointPath = base + ".ckpt";
+    config.rows           = 9;
+    config.cols           = 9;
+    config.mines          = 10;
+    config.firstSeed      = 1;
+    config.seedCount      = 50;
+    config.shardSize      = 7;                  // 8 shards, the last with one seed
+    config.strategies     = {"two-rule", "pattern-table"};
+    return config;
+}
+
+void removeRun(const ShardCoordinator::Config& config) {
+    unlink(config.resultsPath.c_str());
+    unlink(config.checkpointPath.c_str());
+}
+
+// Runs the coordinator until it is done, with one thread per worker;
+// returns the shards each worker played
+std::vector<int> runWithWorkers(const ShardCoordinator::Config& config, int workers, int* resumed = nullptr) {
+    std::vector<int>         played(workers, 0);
+    std::vector<std::thread> threads;
+    bool finished = false;
+    {
+        ShardCoordinator coordinator(config);
+        if (resumed) *resumed = coordinator.resumedShards();
+        for (int w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w] {
+                // A worker may only get there after a short run has ended
+                try { played[w] = runShardWorker(config.socketPath); } catch (const std::runtime_error&) {}
+            });
+        }
+        finished = coordinator.run() && coordinator.completedShards() == coordinator.shardCount();
+    }
+    for (auto& t : threads) t.join();
+    REQUIRE(finished);
+    return played;
+}
+
+// Games per (strategy, seed), and wins per strategy
+std::map<std::pair<std::string, std::uint32_t>, int> gamesBySeed(const std::string& path,
+                                                                 std::map<std::string, int>& wins) {
+    std::map<std::pair<std::string, std::uint32_t>, int> games;
+    const ResultsReader reader(path);
+    reader.forEachBlock(ALL_COLUMNS, [&](const ResultsBlock& b) {
+        for (std::size_t i = 0; i < b.count; ++i) {
+            const std::string& name = b.strategyNames[b.strategies[i]];
+            ++games[{name, b.seeds[i]}];
+            wins[name] += b.outcomes[i] == static_cast<std::uint8_t>(GameRecord::Outcome::Win);
+        }
+    });
+    return games;
+}
+
+void requireEverySeedOnce(const ShardCoordinator::Config& config) {
+    std::map<std::string, int> wins;
+    const auto games = gamesBySeed(config.resultsPath, wins);
+    REQUIRE(games.size() == config.seedCount * config.strategies.size());
+    for (const auto& entry : games) REQUIRE(entry.second == 1);
+
+    // Same games as a single-process tournament on the same seeds
+    TournamentConfig tournament;
+    tournament.rows  = config.rows;
+    tournament.cols  = config.cols;
+    tournament.mines = config.mines;
+    for (std::uint32_t s = 0; s < config.seedCount; ++s) tournament.seeds.push_back(config.firstSeed + s);
+    std::vector<StrategyInfo> strategies;
+    for (const StrategyInfo& info : strategyRegistry()) {
+        for (const std::string& name : config.strategies) {
+            if (info.name == name) strategies.push_back(info);
+        }
+    }
+    for (const StrategyResult& r : runTournament(tournament, strategies)) REQUIRE(wins[r.name] == r.wins);
+}
+
+}  // namespace
+
+TEST_CASE("Sharded runs play every seed exactly once", "[shards]") {
+    const ShardCoordinator::Config config = tempRun();
+    const std::vector<int> played = runWithWorkers(config, 3);
+    REQUIRE(played[0] + played[1] + played[2] == 8);
+    requireEverySeedOnce(config);
+
+    // A finished run resumes to nothing left to do
+    int resumed = 0;
+    const std::vector<int> again = runWithWorkers(config, 1, &resumed);
+    REQUIRE(resumed == 8);
+    REQUIRE(again[0] == 0);
+    requireEverySeedOnce(config);
+    removeRun(config);
+}
+
+TEST_CASE("Interrupted sharded runs resume without redoing shards", "[shards]") {
+    const ShardCoordinator::Config config = tempRun();
+    {
+        ShardCoordinator coordinator(config);
+        bool finished = true;
+        std::thread serve([&] { finished = coordinator.run(); });
+
+        // A worker that leaves after three shards, then a crash
+        const int played = runShardWorker(config.socketPath, 3);
+        while (coordinator.completedShards() < 3) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        coordinator.stop();
+        serve.join();
+        REQUIRE(played == 3);
+        REQUIRE_FALSE(finished);
+        REQUIRE(coordinator.completedShards() == 3);
+    }
+
+    // What a crash mid-commit leaves behind: a partial block and a partial line
+    {
+        std::ofstream results(config.resultsPath, std::ios::binary | std::ios::app);
+        results << "MSRB\x40";
+        std::ofstream checkpoint(config.checkpointPath, std::ios::binary | std::ios::app);
+        checkpoint << "done 5 99";
+    }
+
+    int resumed = 0;
+    const std::vector<int> played = runWithWorkers(config, 2, &resumed);
+    REQUIRE(resumed == 3);
+    REQUIRE(played[0] + played[1] == 5);
+    requireEverySeedOnce(config);
+
+    // The checkpoint belongs to this configuration only
+    ShardCoordinator::Config other = config;
+    other.shardSize = 5;
+    REQUIRE_THROWS_AS(ShardCoordinator(other), std::runtime_error);
+    removeRun(config);
+}
+
+TEST_CASE("Sharded runs leave timed strategies out by default", "[shards]") {
+    ShardCoordinator::Config config = tempRun();
+    config.seedCount  = 3;
+    config.shardSize  = 3;
+    config.strategies = {};
+    runWithWorkers(config, 1);
+
+    std::map<std::string, int> wins;
+    const auto games = gamesBySeed(config.resultsPath, wins);
+    std::size_t untimed = 0;
+    for (const StrategyInfo& info : strategyRegistry()) {
+        if (info.timed) {
+            REQUIRE(wins.count(info.name) == 0);
+        } else {
+            REQUIRE(wins.count(info.name) == 1);
+            ++untimed;
+        }
+    }
+    REQUIRE(games.size() == config.seedCount * untimed);
+    removeRun(config);
+}
+
+TEST_CASE("Shard coordinators reject unusable runs", "[shards]") {
+    ShardCoordinator::Config config = tempRun();
+    config.strategies = {"no-such-strategy"};
+    REQUIRE_THROWS_AS(ShardCoordinator(config), std::runtime_error);
+
+    config = tempRun();
+    config.firstSeed = 0xFFFFFFF0u;
+    REQUIRE_THROWS_AS(ShardCoordinator(config), std::runtime_error);
+
+    config = tempRun();
+    config.shardSize = 0;
+    REQUIRE_THROWS_AS(ShardCoordinator(config), std::runtime_error);
+}
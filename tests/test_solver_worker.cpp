@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "BoardFork.hpp"
+#include "SolverWorker.hpp"
+#include "SpscQueue.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+constexpr float         kTileSize = 50.f;
+constexpr std::uint32_t kSeedA    = 0xC0FFEEu;
+
+// Polls until the worker answers or a generous timeout expires.
+bool waitForResult(SolverWorker& worker, SolverWorker::Result& out) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (worker.poll(out)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+}  // namespace
+
+// =============================================================================
+// SpscQueue
+// =============================================================================
+
+TEST_CASE("SpscQueue is FIFO and bounded", "[spsc]") {
+    SpscQueue<int> q(3);                  // rounds up to 4
+    for (int i = 0; i < 4; ++i) {
+        int v = i;
+        REQUIRE(q.push(std::move(v)));
+    }
+    int extra = 99;
+    REQUIRE_FALSE(q.push(std::move(extra)));
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(q.pop(out));
+        REQUIRE(out == i);
+    }
+    REQUIRE_FALSE(q.pop(out));
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("SpscQueue transfers every item across threads in order", "[spsc][threads]") {
+    SpscQueue<int> q(8);
+    constexpr int kItems = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            int v = i;
+            while (!q.push(std::move(v))) std::this_thread::yield();
+        }
+    });
+
+    int  expected = 0;
+    bool inOrder  = true;
+    int  v;
+    while (expected < kItems) {
+        if (q.pop(v)) {
+            inOrder &= (v == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    REQUIRE(inOrder);
+}
+
+// =============================================================================
+// Solver step
+// =============================================================================
+
+TEST_CASE("findSolverMove agrees with AISolver on Board and forks", "[solver]") {
+    Board b(16, 30, kTileSize, 99, kSeedA);
+    b.reveal(15, 8);
+
+    for (int step = 0; step < 200; ++step) {
+        const SolverMove onBoard = findSolverMove(b);
+        const SolverMove onFork  = findSolverMove(b.fork());
+        REQUIRE(onBoard.action == onFork.action);
+        REQUIRE(onBoard.x == onFork.x);
+        REQUIRE(onBoard.y == onFork.y);
+
+        const bool moved = b.AISolver();
+        REQUIRE(moved == (onBoard.action != SolverMove::Action::None));
+        if (!moved) break;
+        REQUIRE(b.getHighlightX() == onBoard.x);
+        REQUIRE(b.getHighlightY() == onBoard.y);
+    }
+}
+
+// =============================================================================
+// SolverWorker
+// =============================================================================
+
+TEST_CASE("SolverWorker answers with the submitted generation", "[solver][worker]") {
+    Board b(5, 5, kTileSize, 0, kSeedA);
+    b.placeMinesAt({0});
+    b.reveal(1, 1);
+    b.flag(0, 0);
+
+    SolverWorker worker;
+    REQUIRE(worker.submit(b.fork(), 7));
+
+    SolverWorker::Result result;
+    REQUIRE(waitForResult(worker, result));
+    REQUIRE(result.generation == 7);
+    REQUIRE(result.move.action == SolverMove::Action::RevealNeighbors);
+
+    REQUIRE(b.applySolverMove(result.move));
+    REQUIRE(b.isRevealed(2, 2));
+}
+
+TEST_CASE("SolverWorker processes requests in order", "[solver][worker]") {
+    Board stuck(3, 3, kTileSize, 0, kSeedA);
+    stuck.placeMinesAt({0, 8});
+    stuck.reveal(1, 1);
+
+    SolverWorker worker;
+    for (std::uint64_t g = 1; g <= 5; ++g) {
+        REQUIRE(worker.submit(stuck.fork(), g));
+    }
+    for (std::uint64_t g = 1; g <= 5; ++g) {
+        SolverWorker::Result result;
+        REQUIRE(waitForResult(worker, result));
+        REQUIRE(result.generation == g);
+        REQUIRE(result.move.action == SolverMove::Action::None);
+    }
+}
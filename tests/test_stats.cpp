@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "Stats.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float         kTileSize = 50.f;
+constexpr std::uint32_t kSeedA    = 0xC0FFEEu;
+
+using stats::Counter;
+
+// Enables recording for one test and restores the off state afterwards.
+struct StatsScope {
+    StatsScope()  { stats::reset(); stats::setEnabled(true); }
+    ~StatsScope() { stats::setEnabled(false); stats::reset(); }
+};
+
+}  // namespace
+
+TEST_CASE("Stats export every counter as JSON and CSV", "[stats]") {
+    stats::Snapshot s;
+    s.values[static_cast<int>(Counter::TilesOpened)] = 42;
+
+    std::ostringstream json;
+    stats::writeJson(json, s);
+    REQUIRE(json.str().front() == '{');
+    REQUIRE(json.str().find("\"tiles_opened\": 42") != std::string::npos);
+
+    std::ostringstream csv;
+    stats::writeCsv(csv, s);
+    REQUIRE(csv.str().rfind("counter,value\n", 0) == 0);
+    REQUIRE(csv.str().find("tiles_opened,42\n") != std::string::npos);
+
+    int lines = 0;
+    for (char c : csv.str()) lines += c == '\n';
+    REQUIRE(lines == stats::NUM_COUNTERS + 1);
+}
+
+#if MINESWEEPER_STATS
+
+TEST_CASE("Stats record nothing while disabled", "[stats]") {
+    stats::reset();
+    Board b(16, 16, kTileSize, 40, kSeedA);
+    b.reveal(8, 8);
+    b.AISolver();
+
+    const stats::Snapshot s = stats::snapshot();
+    for (int i = 0; i < stats::NUM_COUNTERS; ++i) REQUIRE(s.values[i] == 0);
+}
+
+TEST_CASE("Stats count reveal, relocation, adjacency and solver work", "[stats]") {
+    StatsScope scope;
+
+    // A flooding first click that relocates the mine under it
+    Board b(9, 9, kTileSize, 0, kSeedA);
+    b.placeMinesAt({b.index(4, 4), b.index(0, 0)}, false);
+    stats::reset();
+
+    b.reveal(4, 4);
+    stats::Snapshot s = stats::snapshot();
+    REQUIRE(s[Counter::FirstClickRelocations] == 1);
+    REQUIRE(s[Counter::MinesRelocated]        == 1);
+    REQUIRE(s[Counter::RevealCalls]           == 1);
+    REQUIRE(s[Counter::MaxFloodDepth]         >= 1);
+    REQUIRE(s[Counter::NeighborVisits]        >  0);
+
+    int opened = 0;
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) opened += b.isRevealed(x, y);
+    }
+    REQUIRE(s[Counter::TilesOpened] == static_cast<std::uint64_t>(opened));
+
+    b.reset(9, 9, 10, kSeedA);
+    s = stats::snapshot();
+    REQUIRE(s[Counter::AdjacencyCalls] == 1);
+
+    b.reveal(4, 4);
+    stats::reset();
+    while (b.AISolver()) {}
+    s = stats::snapshot();
+    REQUIRE(s[Counter::SolverCalls] == s[Counter::Rule1Fires] + s[Counter::Rule2Fires] + 1);
+    REQUIRE(s[Counter::SolverCellsScanned] >= 81);
+}
+
+TEST_CASE("AISolver checks each tile a bounded number of times per solve", "[stats]") {
+    StatsScope scope;
+
+    Board b(60, 60, kTileSize, 400, kSeedA);
+    b.reveal(30, 30);
+    stats::reset();
+    int steps = 0;
+    while (b.AISolver()) ++steps;
+    const stats::Snapshot s = stats::snapshot();
+
+    // A rescan from the top per step would cost up to steps * tiles
+    REQUIRE(steps > 100);
+    REQUIRE(s[Counter::SolverCalls] == static_cast<std::uint64_t>(steps) + 1);
+    REQUIRE(s[Counter::SolverCellsScanned] >= 60 * 60);
+    REQUIRE(s[Counter::SolverCellsScanned] < 20u * 60 * 60);
+}
+
+TEST_CASE("Stats aggregate across threads, including exited ones", "[stats]") {
+    StatsScope scope;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) stats::add(Counter::SolverCalls);
+            stats::max(Counter::MaxFloodDepth, 7);
+        });
+    }
+    for (auto& t : threads) t.join();
+    stats::add(Counter::SolverCalls, 5);
+    stats::max(Counter::MaxFloodDepth, 3);
+
+    const stats::Snapshot s = stats::snapshot();
+    REQUIRE(s[Counter::SolverCalls]   == 4005);
+    REQUIRE(s[Counter::MaxFloodDepth] == 7);
+}
+
+#endif
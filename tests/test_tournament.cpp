@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Board.hpp"
+#include "Strategy.hpp"
+#include "Tournament.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float         kTileSize = 50.f;
+constexpr std::uint32_t kSeedA    = 0xC0FFEEu;
+
+class StuckStrategy : public Strategy {
+public:
+    const char* name() const override { return "stuck"; }
+    void nextMoves(const BoardView&, std::vector<StrategyMove>&) override {}
+};
+
+TournamentConfig smallTournament(int threads) {
+    TournamentConfig c;
+    c.rows    = 9;
+    c.cols    = 9;
+    c.mines   = 10;
+    c.threads = threads;
+    for (std::uint32_t s = 0; s < 40; ++s) c.seeds.push_back(100 + s);
+    return c;
+}
+
+}  // namespace
+
+TEST_CASE("BoardView hides mines and hidden adjacency", "[strategy]") {
+    Board b(3, 3, kTileSize, 0, kSeedA);
+    b.placeMinesAt({b.index(0, 0)});
+    b.reveal(2, 2);
+    b.flag(0, 0);
+
+    const BoardView v = b.view();
+    REQUIRE(v.rows() == 3);
+    REQUIRE(v.cols() == 3);
+    REQUIRE(v.cellAt(0, 0) == cell::FLAGGED);               // mine bit masked
+    REQUIRE(v.isRevealed(1, 1));
+    REQUIRE(v.adjacentMines(1, 1) == 1);
+    REQUIRE(v.cellAt(5, 5) == 0);
+
+    Board hidden(3, 3, kTileSize, 0, kSeedA);
+    hidden.placeMinesAt({hidden.index(0, 0)});
+    REQUIRE(hidden.view().cellAt(1, 1) == 0);              // count of a hidden tile masked
+}
+
+TEST_CASE("TwoRuleStrategy plays the moves AISolver makes", "[strategy]") {
+    Board b(16, 30, kTileSize, 99, kSeedA);
+    b.reveal(15, 8);
+
+    TwoRuleStrategy strategy;
+    std::vector<StrategyMove> moves;
+    for (int step = 0; step < 500; ++step) {
+        moves.clear();
+        strategy.nextMoves(b.view(), moves);
+        const bool moved = b.AISolver();
+        REQUIRE(moved == !moves.empty());
+        if (!moved) break;
+
+        for (const StrategyMove& m : moves) {
+            if (m.action == StrategyMove::Action::Flag) {
+                REQUIRE(b.isFlaggedAt(m.x, m.y));
+            } else {
+                REQUIRE(b.isRevealed(m.x, m.y));
+            }
+        }
+    }
+}
+
+TEST_CASE("Tournament outcomes are independent of the thread count", "[tournament]") {
+    const std::vector<StrategyInfo> strategies = {
+        strategyRegistry().front(),
+        {"stuck", [] { return std::make_unique<StuckStrategy>(); }},
+    };
+
+    const std::vector<StrategyResult> serial   = runTournament(smallTournament(1), strategies);
+    const std::vector<StrategyResult> parallel = runTournament(smallTournament(4), strategies);
+    REQUIRE(serial.size() == 2);
+
+    for (int s = 0; s < 2; ++s) {
+        REQUIRE(serial[s].name   == parallel[s].name);
+        REQUIRE(serial[s].games  == 40);
+        REQUIRE(serial[s].wins + serial[s].losses + serial[s].stuck == 40);
+        REQUIRE(serial[s].wins   == parallel[s].wins);
+        REQUIRE(serial[s].losses == parallel[s].losses);
+        REQUIRE(serial[s].stuck  == parallel[s].stuck);
+        REQUIRE(serial[s].moves  == parallel[s].moves);
+        REQUIRE(serial[s].calls  == parallel[s].calls);
+    }
+
+    // The two-rule solver never guesses, so it can only win or get stuck
+    REQUIRE(serial[0].name == "two-rule");
+    REQUIRE(serial[0].losses == 0);
+    REQUIRE(serial[0].wins > 0);
+
+    // Stuck from the first call, unless the opening click cleared the board
+    REQUIRE(serial[1].losses == 0);
+    REQUIRE(serial[1].moves == 40);
+    REQUIRE(serial[1].stuck + serial[1].wins == 40);
+
+    std::ostringstream csv;
+    writeTournamentCsv(csv, serial);
+    REQUIRE(csv.str().rfind("strategy,games,wins,", 0) == 0);
+    REQUIRE(csv.str().find("\ntwo-rule,40,") != std::string::npos);
+}